@@ -0,0 +1,128 @@
+// This source code is licensed under the MIT license found in the LICENSE file in the root directory of this source tree.
+
+#include "AnimNodes/AnimNode_DistanceMatching.h"
+#include "Animation/AnimInstanceProxy.h"
+#include "Curves/CurveFloat.h"
+
+DECLARE_CYCLE_STAT(TEXT("DistanceMatching Build Table"), STAT_DistanceMatching_BuildTable, STATGROUP_Anim);
+
+#if WITH_EDITOR
+namespace DistanceMatching
+{
+	uint32 GetCurveHash(const FRichCurve& Curve)
+	{
+		uint32 Hash = HashCombine(GetTypeHash(Curve.PreInfinityExtrap.GetValue()), GetTypeHash(Curve.PostInfinityExtrap.GetValue()));
+		for (const FRichCurveKey& Key : Curve.GetConstRefOfKeys())
+		{
+			Hash = HashCombine(Hash, HashCombine(GetTypeHash(Key.Time), GetTypeHash(Key.Value)));
+			Hash = HashCombine(Hash, HashCombine(GetTypeHash(Key.ArriveTangent), GetTypeHash(Key.LeaveTangent)));
+			Hash = HashCombine(Hash, GetTypeHash(Key.InterpMode.GetValue()));
+		}
+
+		return Hash;
+	}
+}
+#endif // WITH_EDITOR
+
+FDistanceMatchingTable::FDistanceMatchingTable()
+	: MinDistance(0.f)
+	, DistanceToIndex(0.f)
+{
+}
+
+void FDistanceMatchingTable::Build(const FRichCurve& DistanceCurve, int32 NumEntries)
+{
+	Times.Reset();
+
+	if (DistanceCurve.GetNumKeys() == 0)
+	{
+		return;
+	}
+
+	float MaxDistance;
+	DistanceCurve.GetTimeRange(MinDistance, MaxDistance);
+
+	NumEntries = FMath::Max(NumEntries, 2);
+	DistanceToIndex = (NumEntries - 1) / FMath::Max(MaxDistance - MinDistance, KINDA_SMALL_NUMBER);
+
+	Times.SetNumUninitialized(NumEntries);
+	for (int32 Index = 0; Index < NumEntries; ++Index)
+	{
+		Times[Index] = DistanceCurve.Eval(MinDistance + Index / DistanceToIndex);
+	}
+
+	// Keep time going one way, distance is expected to either decrease to a stop or increase from a start
+	const bool bIncreasing = Times.Last() >= Times[0];
+	for (int32 Index = 1; Index < NumEntries; ++Index)
+	{
+		Times[Index] = bIncreasing ? FMath::Max(Times[Index], Times[Index - 1]) : FMath::Min(Times[Index], Times[Index - 1]);
+	}
+}
+
+float FDistanceMatchingTable::GetTime(float Distance) const
+{
+	if (!IsValid())
+	{
+		return 0.f;
+	}
+
+	const float Index = FMath::Clamp((Distance - MinDistance) * DistanceToIndex, 0.f, (float)(Times.Num() - 1));
+	const int32 LowerIndex = FMath::Min(FMath::FloorToInt(Index), Times.Num() - 2);
+
+	return FMath::Lerp(Times[LowerIndex], Times[LowerIndex + 1], Index - LowerIndex);
+}
+
+FAnimNode_DistanceMatching::FAnimNode_DistanceMatching()
+	: DistanceCurve(nullptr)
+	, Distance(0.f)
+	, LookupTableSize(128)
+	, LookupTableCurve(nullptr)
+	, LookupTableCurveSize(0)
+#if WITH_EDITOR
+	, LookupTableCurveHash(0)
+#endif // WITH_EDITOR
+{
+	// Advance through the sequence so that notifies along the way still fire
+	bTeleportToExplicitTime = false;
+}
+
+void FAnimNode_DistanceMatching::UpdateExplicitTime(const FAnimationUpdateContext& Context)
+{
+	bool bRebuildTable = DistanceCurve != LookupTableCurve || LookupTableSize != LookupTableCurveSize;
+
+#if WITH_EDITOR
+	const uint32 CurveHash = DistanceCurve ? DistanceMatching::GetCurveHash(DistanceCurve->FloatCurve) : 0;
+	bRebuildTable |= CurveHash != LookupTableCurveHash;
+	LookupTableCurveHash = CurveHash;
+#endif // WITH_EDITOR
+
+	if (bRebuildTable)
+	{
+		SCOPE_CYCLE_COUNTER(STAT_DistanceMatching_BuildTable);
+
+		if (DistanceCurve)
+		{
+			LookupTable.Build(DistanceCurve->FloatCurve, LookupTableSize);
+		}
+		else
+		{
+			LookupTable.Reset();
+		}
+
+		LookupTableCurve = DistanceCurve;
+		LookupTableCurveSize = LookupTableSize;
+	}
+
+	if (LookupTable.IsValid())
+	{
+		ExplicitTime = LookupTable.GetTime(Distance);
+	}
+}
+
+void FAnimNode_DistanceMatching::GatherDebugData(FNodeDebugData& DebugData)
+{
+	FString DebugLine = DebugData.GetNodeName(this);
+
+	DebugLine += FString::Printf(TEXT("('%s' Distance: %.1f Time: %.3f)"), *GetNameSafe(Sequence), Distance, ExplicitTime);
+	DebugData.AddDebugItem(DebugLine, true);
+}
@@ -0,0 +1,65 @@
+// This source code is licensed under the MIT license found in the LICENSE file in the root directory of this source tree.
+
+#include "AnimNodes/AnimNode_DrivenSequenceEvaluator.h"
+#include "Animation/AnimInstanceProxy.h"
+#include "Animation/AnimSequenceBase.h"
+
+FAnimNode_DrivenSequenceEvaluator::FAnimNode_DrivenSequenceEvaluator()
+	: bResetTime(false)
+{
+}
+
+void FAnimNode_DrivenSequenceEvaluator::Initialize_AnyThread(const FAnimationInitializeContext& Context)
+{
+	Super::Initialize_AnyThread(Context);
+
+	bResetTime = true;
+}
+
+void FAnimNode_DrivenSequenceEvaluator::UpdateAssetPlayer(const FAnimationUpdateContext& Context)
+{
+	// Same as the sequence evaluator's update, with the time derived between executing the inputs and using them
+	GetEvaluateGraphExposedInputs().Execute(Context);
+
+	UpdateExplicitTime(Context);
+
+	const bool bReset = bResetTime;
+	bResetTime = false;
+
+	if (Sequence == nullptr)
+	{
+		return;
+	}
+
+	const float Length = Sequence->GetPlayLength();
+	ExplicitTime = FMath::Clamp(ExplicitTime, 0.f, Length);
+
+	if ((bTeleportToExplicitTime && GroupIndex == INDEX_NONE) || !Context.AnimInstanceProxy->IsSkeletonCompatible(Sequence->GetSkeleton()))
+	{
+		InternalTimeAccumulator = ExplicitTime;
+		return;
+	}
+
+	if (bReset)
+	{
+		InternalTimeAccumulator = FMath::Clamp(ReinitializationBehavior == ESequenceEvalReinit::ExplicitTime ? ExplicitTime : StartPosition, 0.f, Length);
+	}
+
+	// Take the short way around looping sequences
+	float TimeJump = ExplicitTime - InternalTimeAccumulator;
+	if (bShouldLoop && FMath::Abs(TimeJump) > Length * 0.5f)
+	{
+		TimeJump += TimeJump > 0.f ? -Length : Length;
+	}
+
+	// Jumping from one end to the other of a loop doesn't move, land on the explicit time instead
+	if (TimeJump == 0.f)
+	{
+		InternalTimeAccumulator = ExplicitTime;
+	}
+
+	const float DeltaTime = Context.GetDeltaTime();
+	const float RateScale = Sequence->RateScale;
+	const float PlayRate = FMath::IsNearlyZero(DeltaTime) || FMath::IsNearlyZero(RateScale) ? 0.f : TimeJump / (DeltaTime * RateScale);
+	CreateTickRecordForNode(Context, Sequence, bShouldLoop, PlayRate);
+}
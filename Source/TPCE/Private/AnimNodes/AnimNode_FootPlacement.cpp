@@ -8,6 +8,7 @@
 #include "Engine/CollisionProfile.h"
 #include "SceneManagement.h"
 #include "AnimationRuntime.h"
+#include "Animation/Skeleton.h"
 
 #if ENABLE_ANIM_DEBUG
 	#include "Async/Async.h"
@@ -33,6 +34,7 @@ FAnimNode_FootPlacement::FAnimNode_FootPlacement()
 	, PelvisAdjustmentAlpha(1.f)
 	, PelvisAdjustmentSpeed(20.f)
 	, CollisionProfileName(UCollisionProfile::Pawn_ProfileName)
+	, LockThreshold(0.99f)
 {
 }
 
@@ -95,8 +97,16 @@ void FAnimNode_FootPlacement::EvaluateSkeletalControl_AnyThread(FComponentSpaceP
 		// Make a world space transform
 		FTransform IKBoneWSTransform = IKBoneCSTransform * ComponentTransform;
 		// Calculate world space offsets
-		FFootPlacementOffset& OutFootOffset = Each.Offset;
-		CalculateFootPlacement(SkelComp, BaseLocation, IKBoneWSTransform.GetLocation(), OutFootOffset);
+		// A planted foot keeps standing on the ground it was traced against when it got locked
+		const bool bLocked = Each.LockCurveUID != SmartName::MaxUID && Output.Curve.Get(Each.LockCurveUID) >= LockThreshold;
+		if (!bLocked || !Each.bLocked)
+		{
+			TraceGround(SkelComp, BaseLocation, IKBoneWSTransform.GetLocation(), Each);
+		}
+		Each.bLocked = bLocked;
+
+		CalculateFootPlacement(BaseLocation, Each);
+		const FFootPlacementOffset& OutFootOffset = Each.Offset;
 
 		// Save min foot offset for pelvis adjustment
 		if (OutFootOffset.Z < MinFootOffsetZ)
@@ -159,8 +169,14 @@ bool FAnimNode_FootPlacement::IsValidToEvaluate(const USkeleton * Skeleton, cons
 void FAnimNode_FootPlacement::InitializeBoneReferences(const FBoneContainer & RequiredBones)
 {
 	PelvisBone.Initialize(RequiredBones);
+
+	const USkeleton* Skeleton = RequiredBones.GetSkeletonAsset();
 	for (auto& Each : FootBones)
+	{
 		Each.IKFootBone.Initialize(RequiredBones);
+		Each.LockCurveUID = (Skeleton && Each.LockCurveName != NAME_None) ? Skeleton->GetUIDByName(USkeleton::AnimCurveMappingName, Each.LockCurveName) : SmartName::MaxUID;
+		Each.bLocked = false;
+	}
 }
 
 void FAnimNode_FootPlacement::PreUpdate(const UAnimInstance * InAnimInstance)
@@ -170,10 +186,8 @@ void FAnimNode_FootPlacement::PreUpdate(const UAnimInstance * InAnimInstance)
 	TimeDilation = World->GetWorldSettings()->GetEffectiveTimeDilation();
 }
 
-void FAnimNode_FootPlacement::CalculateFootPlacement(const USkeletalMeshComponent* SkelComp, const FVector& BaseLocation, const FVector& FootLocation, FFootPlacementOffset& OutFootOffset)
+void FAnimNode_FootPlacement::TraceGround(const USkeletalMeshComponent* SkelComp, const FVector& BaseLocation, const FVector& FootLocation, FFootPlacementBone& Foot) const
 {
-	static const float AngleTolerance = 1e-3f;
-
 	const FVector Start(FootLocation.X, FootLocation.Y, BaseLocation.Z + TraceLengthAboveFoot);
 	const FVector End(FootLocation.X, FootLocation.Y, BaseLocation.Z - TraceLengthBelowFoot);
 
@@ -184,28 +198,48 @@ void FAnimNode_FootPlacement::CalculateFootPlacement(const USkeletalMeshComponen
 	const FCollisionQueryParams Params(TraceName, true, IgnoredActor);
 
 	FHitResult Hit(Start, End);
-	FVector HitNormal = FVector::UpVector;
-	float HitZ = 0.f;
-	bool bHit = false;
+	Foot.GroundNormal = FVector::UpVector;
+	Foot.GroundZ = 0.f;
+	Foot.bGroundHit = false;
 
 	// Use the foot height from a fat trace and the normal from the regular line trace. This helps reduce clipping on stairs
 	// Foot angle could be improved by shooting an additional vertical trace at the position of the toes, and averaging the two normals
 	if (World->LineTraceSingleByProfile(Hit, Start, End, CollisionProfileName, Params))
 	{
-		bHit = true;
-		HitZ = Hit.Location.Z;
-		HitNormal = Hit.Normal;
+		Foot.bGroundHit = true;
+		Foot.GroundZ = Hit.Location.Z;
+		Foot.GroundNormal = Hit.Normal;
 	}
 
 	if (TraceRadius > 0.f && World->SweepSingleByProfile(Hit, Start, End, FQuat::Identity, CollisionProfileName, FCollisionShape::MakeSphere(TraceRadius), Params))
 	{
-		bHit = true;
-		HitZ = Hit.ImpactPoint.Z;
+		Foot.bGroundHit = true;
+		Foot.GroundZ = Hit.ImpactPoint.Z;
+	}
+
+#if ENABLE_ANIM_DEBUG && ENABLE_DRAW_DEBUG
+	const bool bShowDebug = (CVarAnimNodeFootPlacementDebug.GetValueOnAnyThread() != 0);
+	if (bShowDebug)
+	{
+		AsyncTask(ENamedThreads::GameThread, [World, Hit]()
+		{
+			DrawDebugLine(World, Hit.TraceStart, Hit.TraceEnd, FColor::Red, false, -1.0f, SDPG_Foreground);
+			if (Hit.bBlockingHit)
+				DrawDebugCircle(World, FTransform(Hit.Normal.Rotation(), Hit.Location, FVector::OneVector).ToMatrixNoScale(), 5.0f, 16, FColor::Red, false, -1.0f, SDPG_Foreground);
+		});
 	}
+#endif
+}
+
+void FAnimNode_FootPlacement::CalculateFootPlacement(const FVector& BaseLocation, FFootPlacementBone& Foot)
+{
+	static const float AngleTolerance = 1e-3f;
 
-	if (World && bHit)
+	FFootPlacementOffset& OutFootOffset = Foot.Offset;
+	if (Foot.bGroundHit)
 	{
-		const float DeltaZ = HitZ - BaseLocation.Z;
+		const FVector& HitNormal = Foot.GroundNormal;
+		const float DeltaZ = Foot.GroundZ - BaseLocation.Z;
 		const float OffsetInterpSpeed = DeltaZ >= 0.f ? ZOffsetUpSpeed : ZOffsetDownSpeed;
 
 		OutFootOffset.Roll = FMath::FInterpTo(OutFootOffset.Roll, FMath::Clamp(FMath::RadiansToDegrees(FMath::Atan2(HitNormal.Y, HitNormal.Z)), MinAngle, MaxAngle), DeltaTime, OffsetInterpSpeed);
@@ -225,17 +259,4 @@ void FAnimNode_FootPlacement::CalculateFootPlacement(const USkeletalMeshComponen
 		OutFootOffset.Roll = 0.0f;
 		OutFootOffset.Pitch = 0.0f;
 	}
-
-#if ENABLE_ANIM_DEBUG && ENABLE_DRAW_DEBUG
-	const bool bShowDebug = (CVarAnimNodeFootPlacementDebug.GetValueOnAnyThread() != 0);
-	if (bShowDebug)
-	{
-		AsyncTask(ENamedThreads::GameThread, [World, Hit]()
-		{
-			DrawDebugLine(World, Hit.TraceStart, Hit.TraceEnd, FColor::Red, false, -1.0f, SDPG_Foreground);
-			if (Hit.bBlockingHit)
-				DrawDebugCircle(World, FTransform(Hit.Normal.Rotation(), Hit.Location, FVector::OneVector).ToMatrixNoScale(), 5.0f, 16, FColor::Red, false, -1.0f, SDPG_Foreground);
-		});
-	}
-#endif
 }
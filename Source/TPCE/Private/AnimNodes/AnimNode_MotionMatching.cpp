@@ -0,0 +1,119 @@
+// This source code is licensed under the MIT license found in the LICENSE file in the root directory of this source tree.
+
+#include "AnimNodes/AnimNode_MotionMatching.h"
+#include "AnimNodes/AnimNode_Inertialization.h"
+#include "Animation/AnimInstanceProxy.h"
+#include "Animation/AnimSequence.h"
+#include "Animation/MotionDatabase.h"
+
+FAnimNode_MotionMatching::FAnimNode_MotionMatching()
+	: Database(nullptr)
+	, DesiredVelocity(FVector::ZeroVector)
+	, SearchInterval(0.1f)
+	, MinCostImprovement(0.1f)
+	, SearchTimeBudget(0.f)
+	, BlendTime(0.2f)
+	, CurrentSequenceIndex(INDEX_NONE)
+	, CurrentTime(0.f)
+	, TimeSinceSearch(0.f)
+	, LastSearchCost(0.f)
+{
+	bTeleportToExplicitTime = false;
+}
+
+void FAnimNode_MotionMatching::Initialize_AnyThread(const FAnimationInitializeContext& Context)
+{
+	Super::Initialize_AnyThread(Context);
+
+	CurrentSequenceIndex = INDEX_NONE;
+	CurrentTime = 0.f;
+	TimeSinceSearch = 0.f;
+	LastSearchCost = 0.f;
+}
+
+void FAnimNode_MotionMatching::UpdateExplicitTime(const FAnimationUpdateContext& Context)
+{
+	bTeleportToExplicitTime = false;
+
+	if (Database && Database->IsValid())
+	{
+		const UAnimSequence* CurrentSequence = Database->Sequences.IsValidIndex(CurrentSequenceIndex) ? Database->Sequences[CurrentSequenceIndex] : nullptr;
+		if (CurrentSequence)
+		{
+			const float Length = CurrentSequence->GetPlayLength();
+			CurrentTime += Context.GetDeltaTime();
+			CurrentTime = bShouldLoop ? FMath::Fmod(CurrentTime, FMath::Max(Length, SMALL_NUMBER)) : FMath::Min(CurrentTime, Length);
+		}
+
+		TimeSinceSearch += Context.GetDeltaTime();
+		if (CurrentSequence == nullptr || TimeSinceSearch >= SearchInterval)
+		{
+			TimeSinceSearch = 0.f;
+			bTeleportToExplicitTime = SearchPose(Context);
+		}
+
+		ExplicitTime = CurrentTime;
+	}
+}
+
+bool FAnimNode_MotionMatching::SearchPose(const FAnimationUpdateContext& Context)
+{
+	const int32 NumFeatures = Database->GetNumFeatures();
+	const int32 CurrentSlot = Database->FindSlot(CurrentSequenceIndex, CurrentTime);
+
+	// Continue the current pose, at the mean of the database when there is none
+	TArray<float, TInlineAllocator<32>> Query;
+	Query.SetNumZeroed(NumFeatures);
+	if (CurrentSlot != INDEX_NONE)
+	{
+		Database->GetSlotFeatures(CurrentSlot, Query);
+	}
+
+	const int32 RootVelocityFeature = Database->GetRootVelocityFeature();
+	if (RootVelocityFeature != INDEX_NONE)
+	{
+		Query[RootVelocityFeature] = Database->NormalizeFeature(RootVelocityFeature, DesiredVelocity.X);
+		Query[RootVelocityFeature + 1] = Database->NormalizeFeature(RootVelocityFeature + 1, DesiredVelocity.Y);
+	}
+
+	const FMotionDatabaseSearchResult Result = Database->Search(Query, SearchTimeBudget * 0.001);
+	if (Result.Slot == INDEX_NONE)
+	{
+		return false;
+	}
+
+	LastSearchCost = Result.Cost;
+
+	if (CurrentSlot != INDEX_NONE)
+	{
+		const float CurrentCost = Database->GetSlotCost(CurrentSlot, Query);
+		const bool bSamePose = Database->GetSlotSequence(Result.Slot) == CurrentSequenceIndex && FMath::Abs(Database->GetSlotTime(Result.Slot) - CurrentTime) <= SearchInterval;
+		if (bSamePose || Result.Cost + MinCostImprovement >= CurrentCost)
+		{
+			LastSearchCost = CurrentCost;
+			return false;
+		}
+	}
+
+	CurrentSequenceIndex = Database->GetSlotSequence(Result.Slot);
+	CurrentTime = Database->GetSlotTime(Result.Slot);
+	Sequence = Database->Sequences[CurrentSequenceIndex];
+
+	if (CurrentSlot != INDEX_NONE && BlendTime > 0.f)
+	{
+		if (FAnimNode_Inertialization* Inertialization = Context.GetAncestor<FAnimNode_Inertialization>())
+		{
+			Inertialization->RequestInertialization(BlendTime);
+		}
+	}
+
+	return true;
+}
+
+void FAnimNode_MotionMatching::GatherDebugData(FNodeDebugData& DebugData)
+{
+	FString DebugLine = DebugData.GetNodeName(this);
+
+	DebugLine += FString::Printf(TEXT("('%s' Time: %.3f Cost: %.3f)"), *GetNameSafe(Sequence), ExplicitTime, LastSearchCost);
+	DebugData.AddDebugItem(DebugLine, true);
+}
@@ -0,0 +1,381 @@
+// This source code is licensed under the MIT license found in the LICENSE file in the root directory of this source tree.
+
+#include "Animation/MotionDatabase.h"
+#include "Animation/AnimSequence.h"
+#include "Animation/Skeleton.h"
+#include "Algo/BinarySearch.h"
+#include "HAL/PlatformTime.h"
+#include "TPCE.h"
+
+DECLARE_CYCLE_STAT(TEXT("MotionDatabase Search"), STAT_MotionDatabase_Search, STATGROUP_Anim);
+
+namespace MotionDatabase
+{
+	// Poses whose cost is computed at once
+	const int32 SlotsPerVector = 4;
+}
+
+UMotionDatabase::UMotionDatabase()
+	: SampleRate(30.0f)
+	, RootVelocityWeight(1.0f)
+	, SyncPhaseWeight(1.0f)
+	, MaxLeafSize(16)
+	, PoseSampleRate(30.0f)
+	, NumPoses(0)
+	, NumFeatures(0)
+	, SlotStride(0)
+	, RootVelocityFeature(INDEX_NONE)
+{
+}
+
+int32 UMotionDatabase::FindSlot(int32 SequenceIndex, float Time) const
+{
+	if (!SequenceFirstPoses.IsValidIndex(SequenceIndex))
+	{
+		return INDEX_NONE;
+	}
+
+	const int32 FirstPose = SequenceFirstPoses[SequenceIndex];
+	const int32 EndPose = SequenceFirstPoses.IsValidIndex(SequenceIndex + 1) ? SequenceFirstPoses[SequenceIndex + 1] : NumPoses;
+	if (FirstPose >= EndPose)
+	{
+		return INDEX_NONE;
+	}
+
+	const int32 Pose = FirstPose + FMath::Clamp(FMath::RoundToInt(Time * PoseSampleRate), 0, EndPose - FirstPose - 1);
+	return PoseSlots[Pose];
+}
+
+void UMotionDatabase::GetSlotFeatures(int32 Slot, TArrayView<float> OutFeatures) const
+{
+	check(OutFeatures.Num() >= NumFeatures);
+
+	for (int32 Feature = 0; Feature < NumFeatures; ++Feature)
+	{
+		OutFeatures[Feature] = FeatureValues[Feature * SlotStride + Slot];
+	}
+}
+
+float UMotionDatabase::GetSlotCost(int32 Slot, TArrayView<const float> Query) const
+{
+	check(Query.Num() >= NumFeatures);
+
+	float Cost = 0.0f;
+	for (int32 Feature = 0; Feature < NumFeatures; ++Feature)
+	{
+		Cost += FMath::Square(FeatureValues[Feature * SlotStride + Slot] - Query[Feature]);
+	}
+
+	return Cost;
+}
+
+FMotionDatabaseSearchResult UMotionDatabase::Search(TArrayView<const float> Query, double TimeBudget) const
+{
+	SCOPE_CYCLE_COUNTER(STAT_MotionDatabase_Search);
+
+	FMotionDatabaseSearchResult Result;
+	if (!IsValid() || Nodes.Num() == 0 || Query.Num() < NumFeatures)
+	{
+		return Result;
+	}
+
+	const double StartTime = FPlatformTime::Seconds();
+
+	struct FPendingNode
+	{
+		int32 Node;
+		float MinCost;
+	};
+
+	// Nearest child first, the other one is only visited if it may hold a better pose than the best one so far
+	TArray<FPendingNode, TInlineAllocator<64>> PendingNodes;
+	PendingNodes.Add({ 0, 0.0f });
+
+	while (PendingNodes.Num() > 0)
+	{
+		const FPendingNode Pending = PendingNodes.Pop(false);
+		if (Pending.MinCost >= Result.Cost)
+		{
+			continue;
+		}
+
+		const FMotionDatabaseNode& Node = Nodes[Pending.Node];
+		if (Node.IsLeaf())
+		{
+			SearchLeaf(Node, Query, Result);
+
+			if (TimeBudget > 0.0 && FPlatformTime::Seconds() - StartTime > TimeBudget)
+			{
+				break;
+			}
+			continue;
+		}
+
+		const float Distance = Query[Node.SplitFeature] - Node.SplitValue;
+		const int32 LeftChild = Pending.Node + 1;
+		const int32 RightChild = Node.RightChildOrFirstSlot;
+
+		PendingNodes.Add({ Distance < 0.0f ? RightChild : LeftChild, FMath::Max(Pending.MinCost, FMath::Square(Distance)) });
+		PendingNodes.Add({ Distance < 0.0f ? LeftChild : RightChild, Pending.MinCost });
+	}
+
+	return Result;
+}
+
+void UMotionDatabase::SearchLeaf(const FMotionDatabaseNode& Leaf, TArrayView<const float> Query, FMotionDatabaseSearchResult& Result) const
+{
+	using namespace MotionDatabase;
+
+	const int32 FirstSlot = Leaf.RightChildOrFirstSlot;
+	const int32 EndSlot = FirstSlot + Leaf.NumSlots;
+	const float* Values = FeatureValues.GetData();
+
+	// Rows are padded, so loading past the last slot of the leaf stays in bounds
+	for (int32 Slot = FirstSlot; Slot < EndSlot; Slot += SlotsPerVector)
+	{
+		VectorRegister Costs = VectorZero();
+		for (int32 Feature = 0; Feature < NumFeatures; ++Feature)
+		{
+			const VectorRegister Difference = VectorSubtract(VectorLoad(Values + Feature * SlotStride + Slot), VectorLoadFloat1(&Query[Feature]));
+			Costs = VectorMultiplyAdd(Difference, Difference, Costs);
+		}
+
+		float SlotCosts[SlotsPerVector];
+		VectorStore(Costs, SlotCosts);
+
+		const int32 NumLanes = FMath::Min(SlotsPerVector, EndSlot - Slot);
+		for (int32 Lane = 0; Lane < NumLanes; ++Lane)
+		{
+			if (SlotCosts[Lane] < Result.Cost)
+			{
+				Result.Cost = SlotCosts[Lane];
+				Result.Slot = Slot + Lane;
+			}
+		}
+	}
+}
+
+#if WITH_EDITOR
+void UMotionDatabase::Build()
+{
+	// Features with a weight, grouped features are added in pairs
+	FeatureNames.Reset();
+	TArray<float> Weights;
+	for (const FMotionDatabaseCurveFeature& CurveFeature : CurveFeatures)
+	{
+		if (CurveFeature.CurveName != NAME_None && CurveFeature.Weight > 0.0f)
+		{
+			FeatureNames.Add(CurveFeature.CurveName);
+			Weights.Add(CurveFeature.Weight);
+		}
+	}
+	const int32 NumCurveFeatures = FeatureNames.Num();
+
+	RootVelocityFeature = INDEX_NONE;
+	if (RootVelocityWeight > 0.0f)
+	{
+		RootVelocityFeature = FeatureNames.Num();
+		FeatureNames.Append({ TEXT("RootVelocityX"), TEXT("RootVelocityY") });
+		Weights.Append({ RootVelocityWeight, RootVelocityWeight });
+	}
+
+	int32 SyncPhaseFeature = INDEX_NONE;
+	if (SyncPhaseWeight > 0.0f)
+	{
+		SyncPhaseFeature = FeatureNames.Num();
+		FeatureNames.Append({ TEXT("SyncPhaseSin"), TEXT("SyncPhaseCos") });
+		Weights.Append({ SyncPhaseWeight, SyncPhaseWeight });
+	}
+
+	NumFeatures = FeatureNames.Num();
+	PoseSampleRate = SampleRate;
+
+	// Sample features of all poses, one row per pose
+	TArray<float> PoseFeatures;
+	TArray<int32> PoseSequences;
+	TArray<float> PoseTimes;
+	SequenceFirstPoses.Reset();
+
+	const float SampleInterval = 1.0f / PoseSampleRate;
+	for (int32 SequenceIndex = 0; SequenceIndex < Sequences.Num(); ++SequenceIndex)
+	{
+		SequenceFirstPoses.Add(PoseSequences.Num());
+
+		const UAnimSequence* Sequence = Sequences[SequenceIndex];
+		const USkeleton* Skeleton = Sequence ? Sequence->GetSkeleton() : nullptr;
+		if (Skeleton == nullptr || NumFeatures == 0)
+		{
+			continue;
+		}
+
+		TArray<SmartName::UID_Type> CurveUIDs;
+		for (int32 Feature = 0; Feature < NumCurveFeatures; ++Feature)
+		{
+			CurveUIDs.Add(Skeleton->GetUIDByName(USkeleton::AnimCurveMappingName, FeatureNames[Feature]));
+		}
+
+		TArray<float> MarkerTimes;
+		for (const FAnimSyncMarker& Marker : Sequence->AuthoredSyncMarkers)
+		{
+			MarkerTimes.Add(Marker.Time);
+		}
+		MarkerTimes.Sort();
+
+		const float Length = Sequence->GetPlayLength();
+		const int32 NumSamples = FMath::FloorToInt(Length * PoseSampleRate) + 1;
+		for (int32 Sample = 0; Sample < NumSamples; ++Sample)
+		{
+			const float Time = FMath::Min(Sample * SampleInterval, Length);
+			PoseSequences.Add(SequenceIndex);
+			PoseTimes.Add(Time);
+
+			const int32 Offset = PoseFeatures.AddZeroed(NumFeatures);
+			float* Features = PoseFeatures.GetData() + Offset;
+			for (int32 Feature = 0; Feature < NumCurveFeatures; ++Feature)
+			{
+				Features[Feature] = CurveUIDs[Feature] != SmartName::MaxUID ? Sequence->EvaluateCurveData(CurveUIDs[Feature], Time, true) : 0.0f;
+			}
+
+			if (RootVelocityFeature != INDEX_NONE)
+			{
+				const float RangeStart = FMath::Max(FMath::Min(Time, Length - SampleInterval), 0.0f);
+				const float RangeEnd = FMath::Min(RangeStart + SampleInterval, Length);
+				const FVector Velocity = Sequence->ExtractRootMotionFromRange(RangeStart, RangeEnd).GetTranslation() / FMath::Max(RangeEnd - RangeStart, SMALL_NUMBER);
+				Features[RootVelocityFeature] = Velocity.X;
+				Features[RootVelocityFeature + 1] = Velocity.Y;
+			}
+
+			if (SyncPhaseFeature != INDEX_NONE && MarkerTimes.Num() > 0)
+			{
+				// Phase between the surrounding markers, wrapping around as if the sequence loops
+				const int32 NextMarker = Algo::UpperBound(MarkerTimes, Time);
+				const float PrevTime = NextMarker > 0 ? MarkerTimes[NextMarker - 1] : MarkerTimes.Last() - Length;
+				const float NextTime = NextMarker < MarkerTimes.Num() ? MarkerTimes[NextMarker] : MarkerTimes[0] + Length;
+				const float Phase = (Time - PrevTime) / FMath::Max(NextTime - PrevTime, SMALL_NUMBER);
+				FMath::SinCos(&Features[SyncPhaseFeature], &Features[SyncPhaseFeature + 1], Phase * 2.0f * PI);
+			}
+		}
+	}
+
+	NumPoses = PoseSequences.Num();
+
+	// Normalize features so that weights are relative to how much features vary
+	FeatureOffsets.SetNumZeroed(NumFeatures);
+	FeatureScales.SetNumZeroed(NumFeatures);
+	for (int32 Feature = 0; Feature < NumFeatures; ++Feature)
+	{
+		double Sum = 0.0;
+		double SquaredSum = 0.0;
+		for (int32 Pose = 0; Pose < NumPoses; ++Pose)
+		{
+			const double Value = PoseFeatures[Pose * NumFeatures + Feature];
+			Sum += Value;
+			SquaredSum += Value * Value;
+		}
+
+		const double Mean = NumPoses > 0 ? Sum / NumPoses : 0.0;
+		const double Deviation = NumPoses > 0 ? FMath::Sqrt(FMath::Max(SquaredSum / NumPoses - Mean * Mean, 0.0)) : 0.0;
+		FeatureOffsets[Feature] = Mean;
+		FeatureScales[Feature] = Weights[Feature] / FMath::Max(Deviation, (double)KINDA_SMALL_NUMBER);
+
+		for (int32 Pose = 0; Pose < NumPoses; ++Pose)
+		{
+			float& Value = PoseFeatures[Pose * NumFeatures + Feature];
+			Value = NormalizeFeature(Feature, Value);
+		}
+	}
+
+	// Index poses and lay them out in tree order
+	TArray<int32> Poses;
+	Poses.SetNumUninitialized(NumPoses);
+	for (int32 Pose = 0; Pose < NumPoses; ++Pose)
+	{
+		Poses[Pose] = Pose;
+	}
+
+	Nodes.Reset();
+	if (NumPoses > 0 && NumFeatures > 0)
+	{
+		BuildNode(Poses, 0, NumPoses, PoseFeatures);
+	}
+
+	SlotStride = Align(NumPoses, MotionDatabase::SlotsPerVector) + MotionDatabase::SlotsPerVector;
+	FeatureValues.Reset();
+	FeatureValues.SetNumZeroed(NumFeatures * SlotStride);
+	SlotSequences.SetNumUninitialized(NumPoses);
+	SlotTimes.SetNumUninitialized(NumPoses);
+	PoseSlots.SetNumUninitialized(NumPoses);
+
+	for (int32 Slot = 0; Slot < NumPoses; ++Slot)
+	{
+		const int32 Pose = Poses[Slot];
+		PoseSlots[Pose] = Slot;
+		SlotSequences[Slot] = PoseSequences[Pose];
+		SlotTimes[Slot] = PoseTimes[Pose];
+
+		for (int32 Feature = 0; Feature < NumFeatures; ++Feature)
+		{
+			FeatureValues[Feature * SlotStride + Slot] = PoseFeatures[Pose * NumFeatures + Feature];
+		}
+	}
+
+	MarkPackageDirty();
+
+	UE_LOG(LogTPCE, Log, TEXT("Built motion database %s: %d poses, %d features, %d nodes"), *GetName(), NumPoses, NumFeatures, Nodes.Num());
+}
+
+int32 UMotionDatabase::BuildNode(TArray<int32>& Poses, int32 Begin, int32 End, const TArray<float>& PoseFeatures)
+{
+	const int32 NodeIndex = Nodes.AddDefaulted();
+	const int32 NumNodePoses = End - Begin;
+
+	// Split along the feature that varies the most
+	int32 SplitFeature = INDEX_NONE;
+	if (NumNodePoses > MaxLeafSize)
+	{
+		float MaxVariance = 0.0f;
+		for (int32 Feature = 0; Feature < NumFeatures; ++Feature)
+		{
+			float Sum = 0.0f;
+			float SquaredSum = 0.0f;
+			for (int32 Index = Begin; Index < End; ++Index)
+			{
+				const float Value = PoseFeatures[Poses[Index] * NumFeatures + Feature];
+				Sum += Value;
+				SquaredSum += Value * Value;
+			}
+
+			const float Mean = Sum / NumNodePoses;
+			const float Variance = SquaredSum / NumNodePoses - Mean * Mean;
+			if (Variance > MaxVariance)
+			{
+				MaxVariance = Variance;
+				SplitFeature = Feature;
+			}
+		}
+	}
+
+	// Identical poses can't be split further, keep them in a single leaf
+	if (SplitFeature == INDEX_NONE)
+	{
+		Nodes[NodeIndex].RightChildOrFirstSlot = Begin;
+		Nodes[NodeIndex].NumSlots = NumNodePoses;
+		return NodeIndex;
+	}
+
+	Sort(Poses.GetData() + Begin, NumNodePoses, [&PoseFeatures, SplitFeature, this](int32 A, int32 B)
+	{
+		return PoseFeatures[A * NumFeatures + SplitFeature] < PoseFeatures[B * NumFeatures + SplitFeature];
+	});
+
+	const int32 Middle = Begin + NumNodePoses / 2;
+	Nodes[NodeIndex].SplitFeature = SplitFeature;
+	Nodes[NodeIndex].SplitValue = PoseFeatures[Poses[Middle] * NumFeatures + SplitFeature];
+
+	BuildNode(Poses, Begin, Middle, PoseFeatures);
+	const int32 RightChild = BuildNode(Poses, Middle, End, PoseFeatures);
+	Nodes[NodeIndex].RightChildOrFirstSlot = RightChild;
+
+	return NodeIndex;
+}
+#endif // WITH_EDITOR
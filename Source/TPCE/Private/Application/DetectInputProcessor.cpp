@@ -2,8 +2,15 @@
 
 #include "Application/DetectInputProcessor.h"
 
+#include "Application/InputLatencyTracker.h"
+
 bool FDetectInputProcessor::HandleAnalogInputEvent(FSlateApplication& SlateApp, const FAnalogInputEvent& InAnalogInputEvent)
 {
+	if (FMath::Abs(InAnalogInputEvent.GetAnalogValue()) > 0.15f)
+	{
+		MARK_INPUT_LATENCY(InputEvent);
+	}
+
 	if (InAnalogInputEvent.GetKey().IsGamepadKey() && CurrentInputDevice != EPlayerControllerInputDevices::Gamepad && InAnalogInputEvent.GetAnalogValue() > 0.15f)
 	{
 		CurrentInputDevice = EPlayerControllerInputDevices::Gamepad;
@@ -15,6 +22,8 @@ bool FDetectInputProcessor::HandleAnalogInputEvent(FSlateApplication& SlateApp,
 
 bool FDetectInputProcessor::HandleKeyDownEvent(FSlateApplication& SlateApp, const FKeyEvent& InKeyEvent)
 {
+	MARK_INPUT_LATENCY(InputEvent);
+
 	if (InKeyEvent.GetKey().IsGamepadKey() && CurrentInputDevice != EPlayerControllerInputDevices::Gamepad)
 	{
 		CurrentInputDevice = EPlayerControllerInputDevices::Gamepad;
@@ -31,6 +40,11 @@ bool FDetectInputProcessor::HandleKeyDownEvent(FSlateApplication& SlateApp, cons
 
 bool FDetectInputProcessor::HandleMouseMoveEvent(FSlateApplication& SlateApp, const FPointerEvent& MouseEvent)
 {
+	if (!MouseEvent.GetCursorDelta().IsZero())
+	{
+		MARK_INPUT_LATENCY(InputEvent);
+	}
+
 	if (CurrentInputDevice != EPlayerControllerInputDevices::Mouse && MouseEvent.GetCursorDelta().Size() > 2.f)
 	{
 		CurrentInputDevice = EPlayerControllerInputDevices::Mouse;
@@ -42,6 +56,8 @@ bool FDetectInputProcessor::HandleMouseMoveEvent(FSlateApplication& SlateApp, co
 
 bool FDetectInputProcessor::HandleMouseWheelOrGestureEvent(FSlateApplication& SlateApp, const FPointerEvent& InWheelEvent, const FPointerEvent* InGestureEvent)
 {
+	MARK_INPUT_LATENCY(InputEvent);
+
 	if (CurrentInputDevice != EPlayerControllerInputDevices::Mouse)
 	{
 		CurrentInputDevice = EPlayerControllerInputDevices::Mouse;
@@ -53,6 +69,8 @@ bool FDetectInputProcessor::HandleMouseWheelOrGestureEvent(FSlateApplication& Sl
 
 bool FDetectInputProcessor::HandleMouseButtonDownEvent(FSlateApplication& SlateApp, const FPointerEvent& MouseEvent)
 {
+	MARK_INPUT_LATENCY(InputEvent);
+
 	if (CurrentInputDevice != EPlayerControllerInputDevices::Mouse)
 	{
 		CurrentInputDevice = EPlayerControllerInputDevices::Mouse;
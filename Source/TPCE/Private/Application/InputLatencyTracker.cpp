@@ -0,0 +1,280 @@
+// This source code is licensed under the MIT license found in the LICENSE file in the root directory of this source tree.
+
+#include "Application/InputLatencyTracker.h"
+
+#include "HAL/IConsoleManager.h"
+#include "Misc/DateTime.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Misc/ScopeLock.h"
+#include "ProfilingDebugging/CsvProfiler.h"
+#include "Framework/Application/SlateApplication.h"
+#include "Rendering/SlateRenderer.h"
+#include "RHIResources.h"
+#include "RenderingThread.h"
+#include "TPCE.h"
+
+CSV_DEFINE_CATEGORY(InputLatency, true);
+
+namespace InputLatency
+{
+	static int32 Enable = 0;
+
+	void OnEnableChanged(IConsoleVariable* Var)
+	{
+		if (Enable == 0)
+		{
+			FInputLatencyTracker::Get().ClearPending();
+		}
+	}
+
+	static FAutoConsoleVariableRef CVarEnable(
+		TEXT("input.Latency.Enable"),
+		Enable,
+		TEXT("If non zero, track the latency from input events to the presented frame. Requires an FDetectInputProcessor to be registered."),
+		FConsoleVariableDelegate::CreateStatic(OnEnableChanged));
+
+	static const ANSICHAR* CsvStatNames[] = { "EventToProcessInput", "ProcessInputToCameraPOV", "CameraPOVToPresent", "EventToPresent" };
+	static_assert(UE_ARRAY_COUNT(CsvStatNames) == EInputLatencyStage::Num, "CSV stat names out of sync with EInputLatencyStage");
+
+#if WITH_INPUT_LATENCY_STATS
+	void DumpCSV(const TArray<FString>& Args)
+	{
+		FString CSV = FInputLatencyTracker::GetCSVHeader();
+		FInputLatencyTracker::Get().AppendCSV(CSV);
+
+		const FString FileName = Args.Num() > 0 ? Args[0] : FString::Printf(TEXT("InputLatency-%s.csv"), *FDateTime::Now().ToString());
+		const FString FilePath = FPaths::Combine(FPaths::ProfilingDir(), TEXT("InputLatency"), FileName);
+		if (FFileHelper::SaveStringToFile(CSV, *FilePath))
+		{
+			UE_LOG(LogTPCE, Display, TEXT("Wrote input latency stats to %s"), *FilePath);
+		}
+		else
+		{
+			UE_LOG(LogTPCE, Warning, TEXT("Failed to write input latency stats to %s"), *FilePath);
+		}
+	}
+
+	void Reset(const TArray<FString>& Args)
+	{
+		FInputLatencyTracker::Get().Reset();
+	}
+
+	static FAutoConsoleCommandWithArgs DumpCSVCmd(
+		TEXT("input.Latency.DumpCSV"),
+		TEXT("Write the accumulated input latency of each stage to a CSV file in the profiling directory. Optional argument: file name."),
+		FConsoleCommandWithArgsDelegate::CreateStatic(DumpCSV));
+
+	static FAutoConsoleCommandWithArgs ResetCmd(
+		TEXT("input.Latency.Reset"),
+		TEXT("Clear the accumulated input latency."),
+		FConsoleCommandWithArgsDelegate::CreateStatic(Reset));
+#endif // WITH_INPUT_LATENCY_STATS
+}
+
+FInputLatencyTracker::FInputLatencyTracker()
+	: PendingEventCycles(0)
+	, ProcessedEventCycles(0)
+	, ProcessInputCycles(0)
+	, RenderThread_EventCycles(0)
+	, RenderThread_CameraPOVCycles(0)
+	, bDelegatesBound(false)
+{
+}
+
+FInputLatencyTracker& FInputLatencyTracker::Get()
+{
+	static FInputLatencyTracker Tracker;
+	return Tracker;
+}
+
+bool FInputLatencyTracker::IsEnabled()
+{
+	return InputLatency::Enable != 0;
+}
+
+void FInputLatencyTracker::MarkInputEvent()
+{
+	check(IsInGameThread());
+
+	// Later events are folded into the oldest one until it is processed
+	if (PendingEventCycles == 0)
+	{
+		PendingEventCycles = FPlatformTime::Cycles64();
+	}
+}
+
+void FInputLatencyTracker::MarkProcessInput()
+{
+	check(IsInGameThread());
+
+	if (PendingEventCycles == 0)
+	{
+		return;
+	}
+
+	BindDelegates();
+
+	const uint64 Cycles = FPlatformTime::Cycles64();
+	RecordStage(EInputLatencyStage::EventToProcessInput, PendingEventCycles, Cycles);
+
+	ProcessedEventCycles = PendingEventCycles;
+	ProcessInputCycles = Cycles;
+	PendingEventCycles = 0;
+}
+
+void FInputLatencyTracker::MarkCameraPOV()
+{
+	check(IsInGameThread());
+
+	if (ProcessInputCycles == 0)
+	{
+		return;
+	}
+
+	const uint64 Cycles = FPlatformTime::Cycles64();
+	RecordStage(EInputLatencyStage::ProcessInputToCameraPOV, ProcessInputCycles, Cycles);
+
+	ProcessInputCycles = 0;
+
+	if (!BackBufferReadyHandle.IsValid())
+	{
+		return;
+	}
+
+	// The world ticks before Slate draws the frame, so the stamps reach the render thread ahead of its present
+	const uint64 EventCycles = ProcessedEventCycles;
+	FInputLatencyTracker* Tracker = this;
+	ENQUEUE_RENDER_COMMAND(InputLatencyCameraPOV)(
+		[Tracker, EventCycles, Cycles](FRHICommandListImmediate& RHICmdList)
+		{
+			// Keep the oldest frame if the previous one wasn't presented yet
+			if (Tracker->RenderThread_CameraPOVCycles == 0)
+			{
+				Tracker->RenderThread_EventCycles = EventCycles;
+				Tracker->RenderThread_CameraPOVCycles = Cycles;
+			}
+		});
+}
+
+void FInputLatencyTracker::Shutdown()
+{
+	if (BackBufferReadyHandle.IsValid())
+	{
+		if (FSlateApplication::IsInitialized() && FSlateApplication::Get().GetRenderer())
+		{
+			FSlateApplication::Get().GetRenderer()->OnBackBufferReadyToPresent().Remove(BackBufferReadyHandle);
+		}
+		BackBufferReadyHandle.Reset();
+	}
+
+	bDelegatesBound = false;
+	PendingEventCycles = ProcessedEventCycles = ProcessInputCycles = 0;
+}
+
+void FInputLatencyTracker::ClearPending()
+{
+	check(IsInGameThread());
+
+	PendingEventCycles = ProcessedEventCycles = ProcessInputCycles = 0;
+
+	if (BackBufferReadyHandle.IsValid())
+	{
+		FInputLatencyTracker* Tracker = this;
+		ENQUEUE_RENDER_COMMAND(InputLatencyClearPending)(
+			[Tracker](FRHICommandListImmediate& RHICmdList)
+			{
+				Tracker->RenderThread_EventCycles = 0;
+				Tracker->RenderThread_CameraPOVCycles = 0;
+			});
+	}
+}
+
+void FInputLatencyTracker::Reset()
+{
+	FScopeLock Lock(&StatsCritical);
+	for (FInputLatencyStatEntry& Entry : Stats)
+	{
+		Entry.Reset();
+	}
+}
+
+FInputLatencyStatEntry FInputLatencyTracker::GetStat(EInputLatencyStage::Type Stage) const
+{
+	FScopeLock Lock(&StatsCritical);
+	return Stats[Stage];
+}
+
+const TCHAR* FInputLatencyTracker::GetStageName(EInputLatencyStage::Type Stage)
+{
+	static const TCHAR* Names[] = { TEXT("EventToProcessInput"), TEXT("ProcessInputToCameraPOV"), TEXT("CameraPOVToPresent"), TEXT("EventToPresent") };
+	static_assert(UE_ARRAY_COUNT(Names) == EInputLatencyStage::Num, "Stage names out of sync with EInputLatencyStage");
+	return (Stage >= 0 && Stage < EInputLatencyStage::Num) ? Names[Stage] : TEXT("Invalid");
+}
+
+FString FInputLatencyTracker::GetCSVHeader()
+{
+	return TEXT("Stage,Count,AverageMs,MinMs,MaxMs\n");
+}
+
+void FInputLatencyTracker::AppendCSV(FString& Out) const
+{
+	FScopeLock Lock(&StatsCritical);
+	for (int32 StageIndex = 0; StageIndex < EInputLatencyStage::Num; ++StageIndex)
+	{
+		const FInputLatencyStatEntry& Entry = Stats[StageIndex];
+		Out += FString::Printf(TEXT("%s,%d,%.4f,%.4f,%.4f\n"),
+			GetStageName((EInputLatencyStage::Type)StageIndex),
+			Entry.Count,
+			Entry.GetAverageSeconds() * 1000.0,
+			Entry.MinSeconds * 1000.0,
+			Entry.MaxSeconds * 1000.0);
+	}
+}
+
+void FInputLatencyTracker::BindDelegates()
+{
+	if (bDelegatesBound)
+	{
+		return;
+	}
+
+	bDelegatesBound = true;
+
+	// Without a Slate renderer (e.g. dedicated servers) the present stage is not tracked
+	if (FSlateApplication::IsInitialized() && FSlateApplication::Get().GetRenderer())
+	{
+		BackBufferReadyHandle = FSlateApplication::Get().GetRenderer()->OnBackBufferReadyToPresent().AddLambda(
+			[this](SWindow&, const FTexture2DRHIRef&) { RenderThread_OnPresent(); });
+	}
+}
+
+void FInputLatencyTracker::RenderThread_OnPresent()
+{
+	// Called once per window, the first one presents the tracked frame
+	if (RenderThread_CameraPOVCycles == 0)
+	{
+		return;
+	}
+
+	const uint64 Cycles = FPlatformTime::Cycles64();
+	RecordStage(EInputLatencyStage::CameraPOVToPresent, RenderThread_CameraPOVCycles, Cycles);
+	RecordStage(EInputLatencyStage::EventToPresent, RenderThread_EventCycles, Cycles);
+
+	RenderThread_EventCycles = 0;
+	RenderThread_CameraPOVCycles = 0;
+}
+
+void FInputLatencyTracker::RecordStage(EInputLatencyStage::Type Stage, uint64 StartCycles, uint64 EndCycles)
+{
+	const double Seconds = FPlatformTime::ToSeconds64(EndCycles - StartCycles);
+
+	{
+		FScopeLock Lock(&StatsCritical);
+		Stats[Stage].Add(Seconds);
+	}
+
+#if CSV_PROFILER
+	FCsvProfiler::RecordCustomStat(InputLatency::CsvStatNames[Stage], CSV_CATEGORY_INDEX(InputLatency), (float)(Seconds * 1000.0), ECsvCustomStatOp::Set);
+#endif
+}
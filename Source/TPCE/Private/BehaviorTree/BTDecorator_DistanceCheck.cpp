@@ -7,6 +7,7 @@
 #include "BehaviorTree/Blackboard/BlackboardKeyType_Object.h"
 #include "BehaviorTree/Blackboard/BlackboardKeyType_Vector.h"
 #include "AIController.h"
+#include "BehaviorTree/BTDistanceSubsystem.h"
 
 UBTDecorator_DistanceCheck::UBTDecorator_DistanceCheck(const FObjectInitializer& ObjectInitializer)
 	: Super(ObjectInitializer)
@@ -15,13 +16,17 @@ UBTDecorator_DistanceCheck::UBTDecorator_DistanceCheck(const FObjectInitializer&
 	MinDistance = 0.f;
 	MaxDistance = 0.f;
 	GeometricDistanceType = FAIDistanceType::Distance3D;
+	bUseDistanceCache = false;
+	bUseProximityTrigger = false;
 
 	// Accept only actors and vectors
 	Observed.AddObjectFilter(this, GET_MEMBER_NAME_CHECKED(UBTDecorator_DistanceCheck, Observed), AActor::StaticClass());
 	Observed.AddVectorFilter(this, GET_MEMBER_NAME_CHECKED(UBTDecorator_DistanceCheck, Observed));
 
 	bNotifyBecomeRelevant = true;
+	bNotifyCeaseRelevant = true;
 	bNotifyTick = true;
+	bTickIntervals = true;
 	FlowAbortMode = EBTFlowAbortMode::None;
 }
 
@@ -54,11 +59,23 @@ bool UBTDecorator_DistanceCheck::CalculateDistance(const UBehaviorTreeComponent&
 	return false;
 }
 
+bool UBTDecorator_DistanceCheck::CalculateCachedDistance(const UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory, float& DistanceSqr) const
+{
+	// The target is kept up to date by the blackboard observer
+	const TNodeInstanceMemory* MyMemory = CastInstanceNodeMemory<TNodeInstanceMemory>(NodeMemory);
+	UBTDistanceSubsystem* DistanceSubsystem = UBTDistanceSubsystem::Get(&OwnerComp);
+
+	return DistanceSubsystem && DistanceSubsystem->GetDistanceSquared(MyMemory->DistancePairHandle, GeometricDistanceType, DistanceSqr);
+}
 
-FORCEINLINE bool UBTDecorator_DistanceCheck::CalcConditionImpl(const UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory) const
+FORCEINLINE bool UBTDecorator_DistanceCheck::CalcConditionImpl(const UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory, bool bUseCachedDistance) const
 {
 	float DistanceSqr;
-	return CalculateDistance(OwnerComp, Observed, DistanceSqr)
+	const bool bValidDistance = bUseCachedDistance
+		? CalculateCachedDistance(OwnerComp, NodeMemory, DistanceSqr)
+		: CalculateDistance(OwnerComp, Observed, DistanceSqr);
+
+	return bValidDistance
 		&& (MinDistanceSqr <= 0.f || DistanceSqr >= MinDistanceSqr) && (MaxDistanceSqr <= 0.f || DistanceSqr <= MaxDistanceSqr);
 }
 
@@ -71,18 +88,141 @@ void UBTDecorator_DistanceCheck::OnBecomeRelevant(UBehaviorTreeComponent& OwnerC
 {
 	TNodeInstanceMemory* MyMemory = (TNodeInstanceMemory*)NodeMemory;
 	MyMemory->bLastRawResult = CalcConditionImpl(OwnerComp, NodeMemory);
+	MyMemory->DistancePairHandle = INDEX_NONE;
+	MyMemory->bProximityTriggerEnabled = false;
+
+	if (bUseDistanceCache || bUseProximityTrigger)
+	{
+		RegisterDistancePair(OwnerComp, *MyMemory);
+
+		// Once registered the trigger notifies the decorator, so it no longer needs to tick
+		if (bUseProximityTrigger && EnableProximityTrigger(OwnerComp, *MyMemory))
+		{
+			SetNextTickTime(NodeMemory, FLT_MAX);
+		}
+	}
+}
+
+bool UBTDecorator_DistanceCheck::RegisterDistancePair(UBehaviorTreeComponent& OwnerComp, TNodeInstanceMemory& MyMemory)
+{
+	if (MyMemory.DistancePairHandle != INDEX_NONE)
+	{
+		return true;
+	}
+
+	UBTDistanceSubsystem* DistanceSubsystem = UBTDistanceSubsystem::Get(&OwnerComp);
+	UBlackboardComponent* MyBlackboard = OwnerComp.GetBlackboardComponent();
+	const AAIController* MyController = OwnerComp.GetAIOwner();
+	if (DistanceSubsystem == nullptr || MyBlackboard == nullptr || MyController == nullptr || MyController->GetPawn() == nullptr)
+	{
+		return false;
+	}
+
+	MyMemory.DistancePairHandle = DistanceSubsystem->RegisterPair(MyController->GetPawn());
+	if (MyMemory.DistancePairHandle == INDEX_NONE)
+	{
+		return false;
+	}
+
+	// The target only needs to be refreshed when the entry changes, moving target actors are sampled by the subsystem
+	DistanceSubsystem->SetPairTargetFromBlackboard(MyMemory.DistancePairHandle, *MyBlackboard, Observed.GetSelectedKeyID());
+	MyBlackboard->RegisterObserver(Observed.GetSelectedKeyID(), this, FOnBlackboardChangeNotification::CreateUObject(this, &UBTDecorator_DistanceCheck::OnBlackboardKeyValueChange));
+	return true;
+}
+
+bool UBTDecorator_DistanceCheck::EnableProximityTrigger(UBehaviorTreeComponent& OwnerComp, TNodeInstanceMemory& MyMemory)
+{
+	UBTDistanceSubsystem* DistanceSubsystem = UBTDistanceSubsystem::Get(&OwnerComp);
+	if (DistanceSubsystem == nullptr || !RegisterDistancePair(OwnerComp, MyMemory))
+	{
+		return false;
+	}
+
+	MyMemory.bLastRawResult = DistanceSubsystem->EnableProximityTrigger(MyMemory.DistancePairHandle, GeometricDistanceType, MinDistance, MaxDistance,
+		FOnProximityTriggerChanged::CreateUObject(this, &UBTDecorator_DistanceCheck::OnProximityTriggerChanged, TWeakObjectPtr<UBehaviorTreeComponent>(&OwnerComp)));
+
+	MyMemory.bProximityTriggerEnabled = true;
+	return true;
+}
+
+void UBTDecorator_DistanceCheck::OnCeaseRelevant(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory)
+{
+	TNodeInstanceMemory* MyMemory = (TNodeInstanceMemory*)NodeMemory;
+	if (MyMemory->bProximityTriggerEnabled)
+	{
+		MyMemory->bProximityTriggerEnabled = false;
+		SetNextTickTime(NodeMemory, 0.f);
+	}
+
+	if (MyMemory->DistancePairHandle != INDEX_NONE)
+	{
+		if (UBlackboardComponent* MyBlackboard = OwnerComp.GetBlackboardComponent())
+		{
+			MyBlackboard->UnregisterObserversFrom(this);
+		}
+
+		if (UBTDistanceSubsystem* DistanceSubsystem = UBTDistanceSubsystem::Get(&OwnerComp))
+		{
+			DistanceSubsystem->UnregisterPair(MyMemory->DistancePairHandle);
+		}
+		MyMemory->DistancePairHandle = INDEX_NONE;
+	}
+}
+
+EBlackboardNotificationResult UBTDecorator_DistanceCheck::OnBlackboardKeyValueChange(const UBlackboardComponent& Blackboard, FBlackboard::FKey ChangedKeyID)
+{
+	UBehaviorTreeComponent* OwnerComp = Cast<UBehaviorTreeComponent>(Blackboard.GetBrainComponent());
+	if (OwnerComp == nullptr)
+	{
+		return EBlackboardNotificationResult::RemoveObserver;
+	}
+
+	const TNodeInstanceMemory* MyMemory = CastInstanceNodeMemory<TNodeInstanceMemory>(OwnerComp->GetNodeMemory(this, OwnerComp->FindInstanceContainingNode(this)));
+	UBTDistanceSubsystem* DistanceSubsystem = UBTDistanceSubsystem::Get(OwnerComp);
+	if (MyMemory && DistanceSubsystem && MyMemory->DistancePairHandle != INDEX_NONE && ChangedKeyID == Observed.GetSelectedKeyID())
+	{
+		// Also reevaluates the proximity trigger right away, which calls back OnProximityTriggerChanged if the result flips
+		DistanceSubsystem->SetPairTargetFromBlackboard(MyMemory->DistancePairHandle, Blackboard, ChangedKeyID);
+	}
+
+	return EBlackboardNotificationResult::ContinueObserving;
 }
 
-void UBTDecorator_DistanceCheck::OnBlackboardChange(const UBlackboardComponent& Blackboard, FBlackboard::FKey ChangedKeyID)
+void UBTDecorator_DistanceCheck::OnProximityTriggerChanged(bool bInside, TWeakObjectPtr<UBehaviorTreeComponent> OwnerComp)
 {
-	check(false);
+	if (!OwnerComp.IsValid())
+	{
+		return;
+	}
+
+	TNodeInstanceMemory* MyMemory = CastInstanceNodeMemory<TNodeInstanceMemory>(OwnerComp->GetNodeMemory(this, OwnerComp->FindInstanceContainingNode(this)));
+	if (MyMemory && bInside != MyMemory->bLastRawResult)
+	{
+		MyMemory->bLastRawResult = bInside;
+		OwnerComp->RequestExecution(this);
+	}
 }
 
 void UBTDecorator_DistanceCheck::TickNode(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory, float DeltaSeconds)
 {
 	TNodeInstanceMemory* MyMemory = CastInstanceNodeMemory<TNodeInstanceMemory>(NodeMemory);
 
-	const bool bResult = CalcConditionImpl(OwnerComp, NodeMemory);
+	if (bUseProximityTrigger)
+	{
+		// The trigger notifies the decorator once registered. Until then, e.g. while the pawn isn't possessed yet, keep polling
+		const bool bLastRawResult = MyMemory->bLastRawResult;
+		if (MyMemory->bProximityTriggerEnabled || EnableProximityTrigger(OwnerComp, *MyMemory))
+		{
+			SetNextTickTime(NodeMemory, FLT_MAX);
+			if (MyMemory->bLastRawResult != bLastRawResult)
+			{
+				OwnerComp.RequestExecution(this);
+			}
+			return;
+		}
+	}
+
+	const bool bResult = CalcConditionImpl(OwnerComp, NodeMemory, MyMemory->DistancePairHandle != INDEX_NONE);
 	if (bResult != MyMemory->bLastRawResult)
 	{
 		MyMemory->bLastRawResult = bResult;
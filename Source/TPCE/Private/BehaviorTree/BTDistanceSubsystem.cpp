@@ -0,0 +1,603 @@
+// This source code is licensed under the MIT license found in the LICENSE file in the root directory of this source tree.
+
+#include "BehaviorTree/BTDistanceSubsystem.h"
+
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+#include "GameFramework/Actor.h"
+#include "GameFramework/Pawn.h"
+#include "BehaviorTree/BlackboardComponent.h"
+#include "BehaviorTree/Blackboard/BlackboardKeyType_Object.h"
+#include "BehaviorTree/Blackboard/BlackboardKeyType_Vector.h"
+#include "Math/VectorRegister.h"
+#include "HAL/IConsoleManager.h"
+
+DECLARE_CYCLE_STAT(TEXT("BTDistanceSubsystem Tick"), STAT_BTDistanceSubsystem_Tick, STATGROUP_AIBehaviorTree);
+
+static TAutoConsoleVariable<float> CVarProximityCellSize(TEXT("ai.BTDistance.ProximityCellSize"), 200.f, TEXT("Grid cell size used to quantize actor locations for proximity triggers. Applied when a world is initialized."));
+
+static FORCEINLINE FIntVector GetGridCell(const FVector& Location, float CellSize)
+{
+	return FIntVector(FMath::FloorToInt(Location.X / CellSize), FMath::FloorToInt(Location.Y / CellSize), FMath::FloorToInt(Location.Z / CellSize));
+}
+
+/** Get the minimum and maximum squared distance between any two points of cells A and B. */
+static void GetCellDistanceBoundsSquared(const FIntVector& A, const FIntVector& B, FAIDistanceType DistanceType, float CellSize, float& OutMinSqr, float& OutMaxSqr)
+{
+	const FIntVector Delta(FMath::Abs(A.X - B.X), FMath::Abs(A.Y - B.Y), FMath::Abs(A.Z - B.Z));
+	const FVector MinDelta = FVector(FMath::Max(0, Delta.X - 1), FMath::Max(0, Delta.Y - 1), FMath::Max(0, Delta.Z - 1)) * CellSize;
+	const FVector MaxDelta = FVector(Delta.X + 1, Delta.Y + 1, Delta.Z + 1) * CellSize;
+
+	switch (DistanceType)
+	{
+	case FAIDistanceType::Distance3D:
+		OutMinSqr = MinDelta.SizeSquared();
+		OutMaxSqr = MaxDelta.SizeSquared();
+		break;
+	case FAIDistanceType::Distance2D:
+		OutMinSqr = MinDelta.SizeSquared2D();
+		OutMaxSqr = MaxDelta.SizeSquared2D();
+		break;
+	case FAIDistanceType::DistanceZ:
+		OutMinSqr = FMath::Square(MinDelta.Z);
+		OutMaxSqr = FMath::Square(MaxDelta.Z);
+		break;
+	default:
+		checkNoEntry();
+		OutMinSqr = 0.f;
+		OutMaxSqr = MAX_flt;
+	}
+}
+
+void UBTDistanceSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	CellSize = FMath::Max(1.f, CVarProximityCellSize.GetValueOnGameThread());
+}
+
+void UBTDistanceSubsystem::Deinitialize()
+{
+	Pairs.Empty();
+	Actors.Empty();
+	ActorIndices.Empty();
+	DirtyTriggers.Empty();
+	BoundaryTriggers.Empty();
+
+	Super::Deinitialize();
+}
+
+UBTDistanceSubsystem* UBTDistanceSubsystem::Get(const UObject* WorldContextObject)
+{
+	const UWorld* World = GEngine ? GEngine->GetWorldFromContextObject(WorldContextObject, EGetWorldErrorMode::ReturnNull) : nullptr;
+	return World ? World->GetSubsystem<UBTDistanceSubsystem>() : nullptr;
+}
+
+ETickableTickType UBTDistanceSubsystem::GetTickableTickType() const
+{
+	return HasAnyFlags(RF_ClassDefaultObject) ? ETickableTickType::Never : ETickableTickType::Conditional;
+}
+
+bool UBTDistanceSubsystem::IsTickable() const
+{
+	return Pairs.Num() > 0;
+}
+
+TStatId UBTDistanceSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UBTDistanceSubsystem, STATGROUP_Tickables);
+}
+
+void UBTDistanceSubsystem::Tick(float DeltaTime)
+{
+	SCOPE_CYCLE_COUNTER(STAT_BTDistanceSubsystem_Tick);
+
+	// Sample every referenced actor once regardless of how many pairs share it. Actors that changed cells mark their triggers dirty.
+	for (TSparseArray<FActorEntry>::TConstIterator It(Actors); It; ++It)
+	{
+		SampleActor(It.GetIndex());
+	}
+
+	for (const int32 Handle : BoundaryTriggers)
+	{
+		MarkTriggerDirty(Handle);
+	}
+
+	// Idle triggers are skipped entirely
+	for (TSparseArray<FPairEntry>::TConstIterator It(Pairs); It; ++It)
+	{
+		if (!It->bTrigger || It->bTriggerDirty)
+		{
+			GatherPair(It.GetIndex());
+		}
+	}
+
+	ComputeDistances(0, AgentX.Num());
+
+	if (DirtyTriggers.Num() > 0)
+	{
+		// Delegates may register or unregister pairs
+		const TArray<int32> TriggersToEvaluate = MoveTemp(DirtyTriggers);
+		DirtyTriggers.Reset();
+
+		for (const int32 Handle : TriggersToEvaluate)
+		{
+			if (Pairs.IsValidIndex(Handle) && Pairs[Handle].bTrigger && Pairs[Handle].bTriggerDirty)
+			{
+				EvaluateTrigger(Handle, true);
+			}
+		}
+	}
+}
+
+int32 UBTDistanceSubsystem::RegisterPair(AActor* Agent, bool bIncludeAgentRadius, bool bIncludeGoalRadius)
+{
+	if (Agent == nullptr)
+	{
+		return INDEX_NONE;
+	}
+
+	FPairEntry Pair;
+	Pair.AgentIndex = AcquireActor(Agent, bIncludeAgentRadius);
+	Pair.TargetIndex = INDEX_NONE;
+	Pair.TargetLocation = FAISystem::InvalidLocation;
+	Pair.bHasTarget = false;
+	Pair.bIncludeAgentRadius = bIncludeAgentRadius;
+	Pair.bIncludeGoalRadius = bIncludeGoalRadius;
+	Pair.bHasResult = false;
+	Pair.TriggerDistanceType = FAIDistanceType::Distance3D;
+	Pair.TriggerMinDistanceSqr = 0.f;
+	Pair.TriggerMaxDistanceSqr = 0.f;
+	Pair.bTrigger = false;
+	Pair.bTriggerInside = false;
+	Pair.bTriggerDirty = false;
+
+	const int32 Handle = Pairs.Add(Pair);
+	ReservePairBuffers();
+	return Handle;
+}
+
+void UBTDistanceSubsystem::UnregisterPair(int32& Handle)
+{
+	if (Pairs.IsValidIndex(Handle))
+	{
+		const FPairEntry& Pair = Pairs[Handle];
+		if (Pair.bTrigger)
+		{
+			UnlinkTrigger(Pair.AgentIndex, Handle);
+			if (Pair.TargetIndex != INDEX_NONE)
+			{
+				UnlinkTrigger(Pair.TargetIndex, Handle);
+			}
+			BoundaryTriggers.Remove(Handle);
+		}
+
+		ReleaseActor(Pair.AgentIndex, Pair.bIncludeAgentRadius);
+		if (Pair.TargetIndex != INDEX_NONE)
+		{
+			ReleaseActor(Pair.TargetIndex, Pair.bIncludeGoalRadius && Actors[Pair.TargetIndex].bIsPawn);
+		}
+		Pairs.RemoveAt(Handle);
+	}
+	Handle = INDEX_NONE;
+}
+
+void UBTDistanceSubsystem::SetPairTarget(int32 Handle, AActor* TargetActor)
+{
+	if (!Pairs.IsValidIndex(Handle))
+	{
+		return;
+	}
+
+	if (TargetActor == nullptr)
+	{
+		ClearPairTarget(Handle);
+		return;
+	}
+
+	const FPairEntry& Pair = Pairs[Handle];
+	if (Pair.TargetIndex != INDEX_NONE && Actors[Pair.TargetIndex].Key == TObjectKey<AActor>(TargetActor))
+	{
+		// Same target, nothing to do
+		return;
+	}
+
+	const bool bNeedsCylinder = Pair.bIncludeGoalRadius && TargetActor->IsA<APawn>();
+	SetPairTargetIndex(Handle, AcquireActor(TargetActor, bNeedsCylinder), FAISystem::InvalidLocation);
+}
+
+void UBTDistanceSubsystem::SetPairTarget(int32 Handle, const FVector& TargetLocation)
+{
+	if (!Pairs.IsValidIndex(Handle))
+	{
+		return;
+	}
+
+	const FPairEntry& Pair = Pairs[Handle];
+	if (Pair.bHasTarget && Pair.TargetIndex == INDEX_NONE && Pair.TargetLocation == TargetLocation)
+	{
+		// Same target, nothing to do
+		return;
+	}
+
+	SetPairTargetIndex(Handle, INDEX_NONE, TargetLocation);
+}
+
+void UBTDistanceSubsystem::ClearPairTarget(int32 Handle)
+{
+	if (Pairs.IsValidIndex(Handle) && Pairs[Handle].bHasTarget)
+	{
+		SetPairTargetIndex(Handle, INDEX_NONE, FAISystem::InvalidLocation);
+	}
+}
+
+void UBTDistanceSubsystem::SetPairTargetIndex(int32 Handle, int32 TargetIndex, const FVector& TargetLocation)
+{
+	FPairEntry& Pair = Pairs[Handle];
+	if (Pair.TargetIndex != INDEX_NONE)
+	{
+		if (Pair.bTrigger)
+		{
+			UnlinkTrigger(Pair.TargetIndex, Handle);
+		}
+		ReleaseActor(Pair.TargetIndex, Pair.bIncludeGoalRadius && Actors[Pair.TargetIndex].bIsPawn);
+	}
+
+	Pair.TargetIndex = TargetIndex;
+	Pair.TargetLocation = TargetLocation;
+	Pair.bHasTarget = (TargetIndex != INDEX_NONE) || FAISystem::IsValidLocation(TargetLocation);
+
+	if (Pair.bTrigger && TargetIndex != INDEX_NONE)
+	{
+		LinkTrigger(TargetIndex, Handle);
+	}
+
+	UpdatePairImmediate(Handle);
+
+	if (Pair.bTrigger)
+	{
+		EvaluateTrigger(Handle, true);
+	}
+}
+
+bool UBTDistanceSubsystem::EnableProximityTrigger(int32 Handle, FAIDistanceType DistanceType, float MinDistance, float MaxDistance, const FOnProximityTriggerChanged& Delegate)
+{
+	if (!Pairs.IsValidIndex(Handle))
+	{
+		return false;
+	}
+
+	FPairEntry& Pair = Pairs[Handle];
+	Pair.OnTriggerChanged = Delegate;
+	Pair.TriggerDistanceType = DistanceType;
+	Pair.TriggerMinDistanceSqr = FMath::Square(MinDistance);
+	Pair.TriggerMaxDistanceSqr = FMath::Square(MaxDistance);
+
+	if (!Pair.bTrigger)
+	{
+		Pair.bTrigger = true;
+		LinkTrigger(Pair.AgentIndex, Handle);
+		if (Pair.TargetIndex != INDEX_NONE)
+		{
+			LinkTrigger(Pair.TargetIndex, Handle);
+		}
+	}
+
+	UpdatePairImmediate(Handle);
+	return EvaluateTrigger(Handle, false);
+}
+
+bool UBTDistanceSubsystem::SetPairTargetFromBlackboard(int32 Handle, const UBlackboardComponent& Blackboard, FBlackboard::FKey KeyID)
+{
+	const TSubclassOf<UBlackboardKeyType> KeyType = Blackboard.GetKeyType(KeyID);
+	if (KeyType == UBlackboardKeyType_Object::StaticClass())
+	{
+		if (AActor* TargetActor = Cast<AActor>(Blackboard.GetValue<UBlackboardKeyType_Object>(KeyID)))
+		{
+			SetPairTarget(Handle, TargetActor);
+			return true;
+		}
+	}
+	else if (KeyType == UBlackboardKeyType_Vector::StaticClass())
+	{
+		const FVector TargetLocation = Blackboard.GetValue<UBlackboardKeyType_Vector>(KeyID);
+		if (FAISystem::IsValidLocation(TargetLocation))
+		{
+			SetPairTarget(Handle, TargetLocation);
+			return true;
+		}
+	}
+
+	ClearPairTarget(Handle);
+	return false;
+}
+
+bool UBTDistanceSubsystem::GetDistanceSquared(int32 Handle, FAIDistanceType DistanceType, float& OutDistanceSqr) const
+{
+	if (!Pairs.IsValidIndex(Handle) || !Pairs[Handle].bHasResult)
+	{
+		return false;
+	}
+
+	switch (DistanceType)
+	{
+	case FAIDistanceType::Distance3D:
+		OutDistanceSqr = DistSquared3D[Handle];
+		return true;
+	case FAIDistanceType::Distance2D:
+		OutDistanceSqr = DistSquared2D[Handle];
+		return true;
+	case FAIDistanceType::DistanceZ:
+		OutDistanceSqr = FMath::Square(DistZ[Handle]);
+		return true;
+	default:
+		checkNoEntry();
+	}
+	return false;
+}
+
+bool UBTDistanceSubsystem::GetDistance(int32 Handle, FAIDistanceType DistanceType, float& OutDistance) const
+{
+	if (!Pairs.IsValidIndex(Handle) || !Pairs[Handle].bHasResult)
+	{
+		return false;
+	}
+
+	switch (DistanceType)
+	{
+	case FAIDistanceType::Distance3D:
+		OutDistance = FMath::Max(0.f, FMath::Sqrt(DistSquared3D[Handle]) - RadiusSums[Handle]);
+		return true;
+	case FAIDistanceType::Distance2D:
+		OutDistance = FMath::Max(0.f, FMath::Sqrt(DistSquared2D[Handle]) - RadiusSums[Handle]);
+		return true;
+	case FAIDistanceType::DistanceZ:
+		OutDistance = FMath::Max(0.f, DistZ[Handle] - HalfHeightSums[Handle]);
+		return true;
+	default:
+		checkNoEntry();
+	}
+	return false;
+}
+
+int32 UBTDistanceSubsystem::AcquireActor(AActor* Actor, bool bNeedsCylinder)
+{
+	check(Actor);
+
+	int32 ActorIndex;
+	if (const int32* ExistingIndex = ActorIndices.Find(Actor))
+	{
+		ActorIndex = *ExistingIndex;
+	}
+	else
+	{
+		FActorEntry Entry;
+		Entry.Actor = Actor;
+		Entry.Key = Actor;
+		Entry.RefCount = 0;
+		Entry.CylinderRefCount = 0;
+		Entry.Cell = FIntVector::ZeroValue;
+		Entry.bIsPawn = Actor->IsA<APawn>();
+		Entry.bValid = false;
+
+		ActorIndex = Actors.Add(Entry);
+		ActorIndices.Add(Entry.Key, ActorIndex);
+
+		const int32 NumActorSamples = Actors.GetMaxIndex();
+		if (ActorLocations.Num() < NumActorSamples)
+		{
+			ActorLocations.SetNumZeroed(NumActorSamples);
+			ActorRadii.SetNumZeroed(NumActorSamples);
+			ActorHalfHeights.SetNumZeroed(NumActorSamples);
+		}
+	}
+
+	FActorEntry& Entry = Actors[ActorIndex];
+	Entry.RefCount++;
+	if (bNeedsCylinder)
+	{
+		Entry.CylinderRefCount++;
+	}
+
+	return ActorIndex;
+}
+
+void UBTDistanceSubsystem::LinkTrigger(int32 ActorIndex, int32 Handle)
+{
+	Actors[ActorIndex].TriggerHandles.Add(Handle);
+}
+
+void UBTDistanceSubsystem::UnlinkTrigger(int32 ActorIndex, int32 Handle)
+{
+	Actors[ActorIndex].TriggerHandles.RemoveSingleSwap(Handle, false);
+}
+
+void UBTDistanceSubsystem::MarkTriggerDirty(int32 Handle)
+{
+	FPairEntry& Pair = Pairs[Handle];
+	if (!Pair.bTriggerDirty)
+	{
+		Pair.bTriggerDirty = true;
+		DirtyTriggers.Add(Handle);
+	}
+}
+
+bool UBTDistanceSubsystem::EvaluateTrigger(int32 Handle, bool bNotify)
+{
+	FPairEntry& Pair = Pairs[Handle];
+	Pair.bTriggerDirty = false;
+
+	bool bInside = false;
+	bool bOnBoundary = false;
+
+	float DistanceSqr;
+	if (GetDistanceSquared(Handle, Pair.TriggerDistanceType, DistanceSqr))
+	{
+		bInside = (Pair.TriggerMinDistanceSqr <= 0.f || DistanceSqr >= Pair.TriggerMinDistanceSqr)
+			&& (Pair.TriggerMaxDistanceSqr <= 0.f || DistanceSqr <= Pair.TriggerMaxDistanceSqr);
+
+		// Without a cell change the result can only flip if a ring lies between the closest and farthest points of both cells
+		const FIntVector TargetCell = (Pair.TargetIndex != INDEX_NONE) ? Actors[Pair.TargetIndex].Cell : GetGridCell(Pair.TargetLocation, CellSize);
+		float CellMinDistanceSqr, CellMaxDistanceSqr;
+		GetCellDistanceBoundsSquared(Actors[Pair.AgentIndex].Cell, TargetCell, Pair.TriggerDistanceType, CellSize, CellMinDistanceSqr, CellMaxDistanceSqr);
+
+		bOnBoundary = (Pair.TriggerMinDistanceSqr > 0.f && CellMinDistanceSqr <= Pair.TriggerMinDistanceSqr && Pair.TriggerMinDistanceSqr <= CellMaxDistanceSqr)
+			|| (Pair.TriggerMaxDistanceSqr > 0.f && CellMinDistanceSqr <= Pair.TriggerMaxDistanceSqr && Pair.TriggerMaxDistanceSqr <= CellMaxDistanceSqr);
+	}
+
+	if (bOnBoundary)
+	{
+		BoundaryTriggers.Add(Handle);
+	}
+	else
+	{
+		BoundaryTriggers.Remove(Handle);
+	}
+
+	if (bInside != Pair.bTriggerInside)
+	{
+		Pair.bTriggerInside = bInside;
+		if (bNotify)
+		{
+			// Copy since the delegate may add pairs and invalidate the reference
+			const FOnProximityTriggerChanged Delegate = Pair.OnTriggerChanged;
+			Delegate.ExecuteIfBound(bInside);
+		}
+	}
+
+	return bInside;
+}
+
+void UBTDistanceSubsystem::ReleaseActor(int32 ActorIndex, bool bNeedsCylinder)
+{
+	FActorEntry& Entry = Actors[ActorIndex];
+	if (bNeedsCylinder)
+	{
+		Entry.CylinderRefCount--;
+	}
+
+	if (--Entry.RefCount <= 0)
+	{
+		ActorIndices.Remove(Entry.Key);
+		Actors.RemoveAt(ActorIndex);
+	}
+}
+
+bool UBTDistanceSubsystem::SampleActor(int32 ActorIndex)
+{
+	FActorEntry& Entry = Actors[ActorIndex];
+	const AActor* Actor = Entry.Actor.Get();
+	const bool bWasValid = Entry.bValid;
+	bool bCellChanged = false;
+	Entry.bValid = (Actor != nullptr);
+
+	if (Actor)
+	{
+		ActorLocations[ActorIndex] = Actor->GetActorLocation();
+
+		const FIntVector Cell = GetGridCell(ActorLocations[ActorIndex], CellSize);
+		bCellChanged = (Cell != Entry.Cell);
+		Entry.Cell = Cell;
+
+		if (Entry.CylinderRefCount > 0)
+		{
+			Actor->GetSimpleCollisionCylinder(ActorRadii[ActorIndex], ActorHalfHeights[ActorIndex]);
+		}
+		else
+		{
+			ActorRadii[ActorIndex] = 0.f;
+			ActorHalfHeights[ActorIndex] = 0.f;
+		}
+	}
+
+	if (bCellChanged || bWasValid != Entry.bValid)
+	{
+		for (const int32 Handle : Entry.TriggerHandles)
+		{
+			MarkTriggerDirty(Handle);
+		}
+	}
+
+	return Entry.bValid;
+}
+
+void UBTDistanceSubsystem::GatherPair(int32 Handle)
+{
+	FPairEntry& Pair = Pairs[Handle];
+
+	const bool bValidAgent = Actors[Pair.AgentIndex].bValid;
+	const bool bValidTarget = Pair.bHasTarget && (Pair.TargetIndex == INDEX_NONE || Actors[Pair.TargetIndex].bValid);
+	Pair.bHasResult = bValidAgent && bValidTarget;
+
+	if (!Pair.bHasResult)
+	{
+		return;
+	}
+
+	const FVector& AgentLocation = ActorLocations[Pair.AgentIndex];
+	AgentX[Handle] = AgentLocation.X;
+	AgentY[Handle] = AgentLocation.Y;
+	AgentZ[Handle] = AgentLocation.Z;
+
+	float RadiusSum = Pair.bIncludeAgentRadius ? ActorRadii[Pair.AgentIndex] : 0.f;
+	float HalfHeightSum = Pair.bIncludeAgentRadius ? ActorHalfHeights[Pair.AgentIndex] : 0.f;
+
+	const FVector& TargetLocation = (Pair.TargetIndex != INDEX_NONE) ? ActorLocations[Pair.TargetIndex] : Pair.TargetLocation;
+	TargetX[Handle] = TargetLocation.X;
+	TargetY[Handle] = TargetLocation.Y;
+	TargetZ[Handle] = TargetLocation.Z;
+
+	if (Pair.bIncludeGoalRadius && Pair.TargetIndex != INDEX_NONE && Actors[Pair.TargetIndex].bIsPawn)
+	{
+		RadiusSum += ActorRadii[Pair.TargetIndex];
+		HalfHeightSum += ActorHalfHeights[Pair.TargetIndex];
+	}
+
+	RadiusSums[Handle] = RadiusSum;
+	HalfHeightSums[Handle] = HalfHeightSum;
+}
+
+void UBTDistanceSubsystem::UpdatePairImmediate(int32 Handle)
+{
+	const FPairEntry& Pair = Pairs[Handle];
+	SampleActor(Pair.AgentIndex);
+	if (Pair.TargetIndex != INDEX_NONE)
+	{
+		SampleActor(Pair.TargetIndex);
+	}
+
+	GatherPair(Handle);
+
+	const int32 StartIndex = Handle & ~3;
+	ComputeDistances(StartIndex, StartIndex + 4);
+}
+
+void UBTDistanceSubsystem::ReservePairBuffers()
+{
+	const int32 NumPadded = Align(Pairs.GetMaxIndex(), 4);
+	if (AgentX.Num() < NumPadded)
+	{
+		for (FFloatBuffer* Buffer : { &AgentX, &AgentY, &AgentZ, &TargetX, &TargetY, &TargetZ, &RadiusSums, &HalfHeightSums, &DistSquared3D, &DistSquared2D, &DistZ })
+		{
+			Buffer->SetNumZeroed(NumPadded);
+		}
+	}
+}
+
+void UBTDistanceSubsystem::ComputeDistances(int32 StartIndex, int32 EndIndex)
+{
+	checkSlow(StartIndex % 4 == 0 && EndIndex % 4 == 0 && EndIndex <= AgentX.Num());
+
+	// Unused slots hold stale but finite values so they can be processed along with the rest
+	for (int32 Index = StartIndex; Index < EndIndex; Index += 4)
+	{
+		const VectorRegister DeltaX = VectorSubtract(VectorLoadAligned(&TargetX[Index]), VectorLoadAligned(&AgentX[Index]));
+		const VectorRegister DeltaY = VectorSubtract(VectorLoadAligned(&TargetY[Index]), VectorLoadAligned(&AgentY[Index]));
+		const VectorRegister DeltaZ = VectorSubtract(VectorLoadAligned(&TargetZ[Index]), VectorLoadAligned(&AgentZ[Index]));
+
+		const VectorRegister DistSqXY = VectorMultiplyAdd(DeltaY, DeltaY, VectorMultiply(DeltaX, DeltaX));
+		VectorStoreAligned(DistSqXY, &DistSquared2D[Index]);
+		VectorStoreAligned(VectorMultiplyAdd(DeltaZ, DeltaZ, DistSqXY), &DistSquared3D[Index]);
+		VectorStoreAligned(VectorAbs(DeltaZ), &DistZ[Index]);
+	}
+}
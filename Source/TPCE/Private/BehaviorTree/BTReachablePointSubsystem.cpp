@@ -0,0 +1,286 @@
+// This source code is licensed under the MIT license found in the LICENSE file in the root directory of this source tree.
+
+#include "BehaviorTree/BTReachablePointSubsystem.h"
+
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+#include "NavigationSystem.h"
+#include "NavigationData.h"
+#include "HAL/IConsoleManager.h"
+
+DECLARE_CYCLE_STAT(TEXT("BTReachablePointSubsystem Tick"), STAT_BTReachablePointSubsystem_Tick, STATGROUP_AIBehaviorTree);
+
+static TAutoConsoleVariable<int32> CVarReachablePointMaxQueriesPerFrame(TEXT("ai.ReachablePoint.MaxQueriesPerFrame"), 4, TEXT("Maximum number of deferred reachable point navmesh queries processed per frame."));
+static TAutoConsoleVariable<float> CVarReachablePointCacheCellSize(TEXT("ai.ReachablePoint.CacheCellSize"), 250.f, TEXT("Grid cell size used to key pre-sampled reachable points by origin. Applied when a world is initialized."));
+static TAutoConsoleVariable<float> CVarReachablePointCacheLifetime(TEXT("ai.ReachablePoint.CacheLifetime"), 30.f, TEXT("Time in seconds before pre-sampled reachable points are discarded. Applied when a world is initialized."));
+static TAutoConsoleVariable<int32> CVarReachablePointCacheSamples(TEXT("ai.ReachablePoint.CacheSamples"), 8, TEXT("Number of reachable points sampled per origin cell. Applied when a world is initialized."));
+
+void UBTReachablePointSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	NextQueryId = 0;
+	PendingQueriesHead = 0;
+	CacheCellSize = FMath::Max(1.f, CVarReachablePointCacheCellSize.GetValueOnGameThread());
+	CacheLifetime = FMath::Max(0.f, CVarReachablePointCacheLifetime.GetValueOnGameThread());
+	CacheSamples = FMath::Max(1, CVarReachablePointCacheSamples.GetValueOnGameThread());
+}
+
+void UBTReachablePointSubsystem::Deinitialize()
+{
+	PendingQueries.Empty();
+	PendingQueriesHead = 0;
+	Cache.Empty();
+
+	Super::Deinitialize();
+}
+
+UBTReachablePointSubsystem* UBTReachablePointSubsystem::Get(const UObject* WorldContextObject)
+{
+	const UWorld* World = GEngine ? GEngine->GetWorldFromContextObject(WorldContextObject, EGetWorldErrorMode::ReturnNull) : nullptr;
+	return World ? World->GetSubsystem<UBTReachablePointSubsystem>() : nullptr;
+}
+
+ETickableTickType UBTReachablePointSubsystem::GetTickableTickType() const
+{
+	return HasAnyFlags(RF_ClassDefaultObject) ? ETickableTickType::Never : ETickableTickType::Conditional;
+}
+
+bool UBTReachablePointSubsystem::IsTickable() const
+{
+	return PendingQueries.Num() > PendingQueriesHead;
+}
+
+TStatId UBTReachablePointSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UBTReachablePointSubsystem, STATGROUP_Tickables);
+}
+
+void UBTReachablePointSubsystem::Tick(float DeltaTime)
+{
+	SCOPE_CYCLE_COUNTER(STAT_BTReachablePointSubsystem_Tick);
+
+	// Every navmesh query counts towards the budget, queries answered from the cache are free
+	const int32 MaxQueries = FMath::Max(1, CVarReachablePointMaxQueriesPerFrame.GetValueOnGameThread());
+	int32 NumQueries = 0;
+
+	while (PendingQueries.Num() > PendingQueriesHead && NumQueries < MaxQueries)
+	{
+		// Sample the cell of the next query within the budget, it stays queued until the cell is complete
+		const FPendingQuery& NextQuery = PendingQueries[PendingQueriesHead];
+		if (NextQuery.QueryId != 0 && NextQuery.Request.bUseCache && NextQuery.Request.Querier.IsValid() && FindCacheEntry(NextQuery.Request) == nullptr)
+		{
+			NumQueries += SampleCacheEntry(NextQuery.Request, MaxQueries - NumQueries);
+
+			const FCacheEntry* Entry = Cache.Find(MakeCacheKey(NextQuery.Request));
+			if (Entry && Entry->NumSamples < CacheSamples)
+			{
+				continue;
+			}
+		}
+
+		// Dequeue first since delegates may queue or cancel queries
+		const FPendingQuery Query = PopPendingQuery();
+		if (Query.QueryId != 0)
+		{
+			NumQueries += ProcessQuery(Query);
+		}
+	}
+}
+
+UBTReachablePointSubsystem::FPendingQuery UBTReachablePointSubsystem::PopPendingQuery()
+{
+	FPendingQuery Query = MoveTemp(PendingQueries[PendingQueriesHead++]);
+
+	if (PendingQueriesHead == PendingQueries.Num())
+	{
+		PendingQueries.Reset();
+		PendingQueriesHead = 0;
+	}
+	else if (PendingQueriesHead >= 32 && PendingQueriesHead * 2 >= PendingQueries.Num())
+	{
+		PendingQueries.RemoveAt(0, PendingQueriesHead, false);
+		PendingQueriesHead = 0;
+	}
+
+	return Query;
+}
+
+uint32 UBTReachablePointSubsystem::RequestReachablePoint(const FReachablePointRequest& Request, const FOnReachablePointQueryFinished& Delegate)
+{
+	// Zero is reserved for invalid ids
+	if (++NextQueryId == 0)
+	{
+		++NextQueryId;
+	}
+
+	FPendingQuery& Query = PendingQueries.AddDefaulted_GetRef();
+	Query.QueryId = NextQueryId;
+	Query.Request = Request;
+	Query.Delegate = Delegate;
+
+	return Query.QueryId;
+}
+
+void UBTReachablePointSubsystem::CancelQuery(uint32 QueryId)
+{
+	// Only mark the query so that the queue isn't shifted, it's skipped when dequeued
+	for (int32 QueryIndex = PendingQueriesHead; QueryIndex < PendingQueries.Num(); ++QueryIndex)
+	{
+		FPendingQuery& Query = PendingQueries[QueryIndex];
+		if (Query.QueryId == QueryId)
+		{
+			Query.QueryId = 0;
+			Query.Delegate.Unbind();
+			break;
+		}
+	}
+}
+
+bool UBTReachablePointSubsystem::GetCachedReachablePoint(const FReachablePointRequest& Request, FVector& OutPoint) const
+{
+	const FCacheEntry* Entry = FindCacheEntry(Request);
+	if (Entry == nullptr)
+	{
+		return false;
+	}
+
+	// Prefer points within radius of the actual origin since samples were taken around the first origin seen in the cell
+	const float RadiusSqr = FMath::Square(Request.Radius);
+	const int32 StartIndex = FMath::RandHelper(Entry->Points.Num());
+	for (int32 Offset = 0; Offset < Entry->Points.Num(); ++Offset)
+	{
+		const FVector& Point = Entry->Points[(StartIndex + Offset) % Entry->Points.Num()];
+		if (FVector::DistSquaredXY(Point, Request.Origin) <= RadiusSqr)
+		{
+			OutPoint = Point;
+			return true;
+		}
+	}
+
+	return false;
+}
+
+bool UBTReachablePointSubsystem::GetRandomReachablePoint(const FReachablePointRequest& Request, FVector& OutPoint)
+{
+	UWorld* MyWorld = GEngine ? GEngine->GetWorldFromContextObject(Request.Querier.Get(), EGetWorldErrorMode::ReturnNull) : nullptr;
+	if (MyWorld == nullptr)
+	{
+		return false;
+	}
+
+	if (UNavigationSystemV1* NavSys = FNavigationSystem::GetCurrent<UNavigationSystemV1>(MyWorld))
+	{
+		if (ANavigationData* NavData = NavSys->GetDefaultNavDataInstance(FNavigationSystem::DontCreate))
+		{
+			FNavLocation RandomPoint(Request.Origin);
+			if (NavSys->GetRandomReachablePointInRadius(Request.Origin, Request.Radius, RandomPoint, NavData, UNavigationQueryFilter::GetQueryFilter(*NavData, Request.Querier.Get(), Request.FilterClass)))
+			{
+				OutPoint = RandomPoint.Location;
+				return true;
+			}
+		}
+	}
+
+	OutPoint = Request.Origin + FVector(FMath::RandPointInCircle(Request.Radius), 0.f);
+	return true;
+}
+
+void UBTReachablePointSubsystem::FlushCache()
+{
+	Cache.Reset();
+}
+
+UBTReachablePointSubsystem::FCacheKey UBTReachablePointSubsystem::MakeCacheKey(const FReachablePointRequest& Request) const
+{
+	FCacheKey Key;
+	Key.Cell = FIntVector(FMath::FloorToInt(Request.Origin.X / CacheCellSize), FMath::FloorToInt(Request.Origin.Y / CacheCellSize), FMath::FloorToInt(Request.Origin.Z / CacheCellSize));
+	Key.Radius = FMath::RoundToInt(Request.Radius);
+	Key.FilterClass = *Request.FilterClass;
+	return Key;
+}
+
+bool UBTReachablePointSubsystem::IsCacheEntryExpired(const FCacheEntry& Entry) const
+{
+	return CacheLifetime > 0.f && GetWorld()->GetTimeSeconds() - Entry.Timestamp > CacheLifetime;
+}
+
+const UBTReachablePointSubsystem::FCacheEntry* UBTReachablePointSubsystem::FindCacheEntry(const FReachablePointRequest& Request) const
+{
+	const FCacheEntry* Entry = Cache.Find(MakeCacheKey(Request));
+	if (Entry && Entry->NumSamples >= CacheSamples && Entry->Points.Num() > 0 && !IsCacheEntryExpired(*Entry))
+	{
+		return Entry;
+	}
+	return nullptr;
+}
+
+UBTReachablePointSubsystem::FCacheEntry& UBTReachablePointSubsystem::FindOrResetCacheEntry(const FReachablePointRequest& Request)
+{
+	const FCacheKey Key = MakeCacheKey(Request);
+	FCacheEntry* Entry = Cache.Find(Key);
+	if (Entry == nullptr || IsCacheEntryExpired(*Entry) || (Entry->NumSamples >= CacheSamples && Entry->Points.Num() == 0))
+	{
+		Entry = &Cache.Add(Key);
+		Entry->Points.Reset(CacheSamples);
+		Entry->Timestamp = GetWorld()->GetTimeSeconds();
+		Entry->NumSamples = 0;
+	}
+
+	return *Entry;
+}
+
+int32 UBTReachablePointSubsystem::SampleCacheEntry(const FReachablePointRequest& Request, int32 MaxSamples)
+{
+	FCacheEntry& Entry = FindOrResetCacheEntry(Request);
+
+	const int32 NumSamples = FMath::Min(MaxSamples, CacheSamples - Entry.NumSamples);
+	for (int32 SampleIndex = 0; SampleIndex < NumSamples; ++SampleIndex)
+	{
+		FVector Point;
+		if (GetRandomReachablePoint(Request, Point))
+		{
+			Entry.Points.Add(Point);
+		}
+	}
+
+	Entry.NumSamples += NumSamples;
+	return NumSamples;
+}
+
+void UBTReachablePointSubsystem::AddCacheSample(const FReachablePointRequest& Request, const FVector& Point)
+{
+	FCacheEntry& Entry = FindOrResetCacheEntry(Request);
+	if (Entry.NumSamples < CacheSamples)
+	{
+		Entry.Points.Add(Point);
+		Entry.NumSamples++;
+	}
+}
+
+int32 UBTReachablePointSubsystem::ProcessQuery(const FPendingQuery& Query)
+{
+	if (!Query.Request.Querier.IsValid())
+	{
+		return 0;
+	}
+
+	FVector Point = Query.Request.Origin;
+	bool bSuccess = false;
+	int32 NumQueries = 0;
+
+	// The cell was sampled within the budget before the query was dequeued, but none of its points may be within radius
+	if (Query.Request.bUseCache)
+	{
+		bSuccess = GetCachedReachablePoint(Query.Request, Point);
+	}
+
+	if (!bSuccess)
+	{
+		bSuccess = GetRandomReachablePoint(Query.Request, Point);
+		NumQueries = 1;
+	}
+
+	Query.Delegate.ExecuteIfBound(Query.QueryId, bSuccess, bSuccess ? Point : Query.Request.Origin);
+	return NumQueries;
+}
@@ -8,6 +8,7 @@
 #include "BehaviorTree/Blackboard/BlackboardKeyType_Vector.h"
 #include "BehaviorTree/Blackboard/BlackboardKeyType_Float.h"
 #include "AIController.h"
+#include "BehaviorTree/BTDistanceSubsystem.h"
 
 UBTService_Distance::UBTService_Distance(const FObjectInitializer& ObjectInitializer)
 	: Super(ObjectInitializer)
@@ -15,8 +16,11 @@ UBTService_Distance::UBTService_Distance(const FObjectInitializer& ObjectInitial
 	NodeName = "Distance";
 	bNotifyTick = true;
 	bTickIntervals = true;
+	bNotifyBecomeRelevant = true;
+	bNotifyCeaseRelevant = true;
 
 	GeometricDistanceType = FAIDistanceType::Distance3D;
+	bUseDistanceCache = false;
 
 	// Accept only floats
 	BlackboardKey.AddFloatFilter(this, GET_MEMBER_NAME_CHECKED(ThisClass, BlackboardKey));
@@ -37,28 +41,110 @@ void UBTService_Distance::InitializeFromAsset(UBehaviorTree& Asset)
 	}
 }
 
+void UBTService_Distance::OnBecomeRelevant(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory)
+{
+	Super::OnBecomeRelevant(OwnerComp, NodeMemory);
+
+	TNodeInstanceMemory* MyMemory = CastInstanceNodeMemory<TNodeInstanceMemory>(NodeMemory);
+	MyMemory->DistancePairHandle = INDEX_NONE;
+
+	if (bUseDistanceCache)
+	{
+		const AAIController* MyController = OwnerComp.GetAIOwner();
+		UBTDistanceSubsystem* DistanceSubsystem = UBTDistanceSubsystem::Get(&OwnerComp);
+		UBlackboardComponent* MyBlackboard = OwnerComp.GetBlackboardComponent();
+		if (DistanceSubsystem && MyBlackboard && MyController && MyController->GetPawn())
+		{
+			MyMemory->DistancePairHandle = DistanceSubsystem->RegisterPair(MyController->GetPawn(), bReachTestIncludesAgentRadius, bReachTestIncludesGoalRadius);
+
+			// The target only needs to be refreshed when the entry changes, moving target actors are sampled by the subsystem
+			DistanceSubsystem->SetPairTargetFromBlackboard(MyMemory->DistancePairHandle, *MyBlackboard, Observed.GetSelectedKeyID());
+			MyBlackboard->RegisterObserver(Observed.GetSelectedKeyID(), this, FOnBlackboardChangeNotification::CreateUObject(this, &UBTService_Distance::OnObservedKeyValueChange));
+		}
+	}
+}
+
+void UBTService_Distance::OnCeaseRelevant(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory)
+{
+	TNodeInstanceMemory* MyMemory = CastInstanceNodeMemory<TNodeInstanceMemory>(NodeMemory);
+	if (MyMemory->DistancePairHandle != INDEX_NONE)
+	{
+		if (UBlackboardComponent* MyBlackboard = OwnerComp.GetBlackboardComponent())
+		{
+			MyBlackboard->UnregisterObserversFrom(this);
+		}
+
+		if (UBTDistanceSubsystem* DistanceSubsystem = UBTDistanceSubsystem::Get(&OwnerComp))
+		{
+			DistanceSubsystem->UnregisterPair(MyMemory->DistancePairHandle);
+		}
+		MyMemory->DistancePairHandle = INDEX_NONE;
+	}
+
+	Super::OnCeaseRelevant(OwnerComp, NodeMemory);
+}
+
+EBlackboardNotificationResult UBTService_Distance::OnObservedKeyValueChange(const UBlackboardComponent& Blackboard, FBlackboard::FKey ChangedKeyID)
+{
+	UBehaviorTreeComponent* OwnerComp = Cast<UBehaviorTreeComponent>(Blackboard.GetBrainComponent());
+	if (OwnerComp == nullptr)
+	{
+		return EBlackboardNotificationResult::RemoveObserver;
+	}
+
+	const TNodeInstanceMemory* MyMemory = CastInstanceNodeMemory<TNodeInstanceMemory>(OwnerComp->GetNodeMemory(this, OwnerComp->FindInstanceContainingNode(this)));
+	UBTDistanceSubsystem* DistanceSubsystem = UBTDistanceSubsystem::Get(OwnerComp);
+	if (MyMemory && DistanceSubsystem && MyMemory->DistancePairHandle != INDEX_NONE && ChangedKeyID == Observed.GetSelectedKeyID())
+	{
+		DistanceSubsystem->SetPairTargetFromBlackboard(MyMemory->DistancePairHandle, Blackboard, ChangedKeyID);
+	}
+
+	return EBlackboardNotificationResult::ContinueObserving;
+}
+
 void UBTService_Distance::TickNode(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory, float DeltaSeconds)
 {
 	Super::TickNode(OwnerComp, NodeMemory, DeltaSeconds);
 
-	FVector TargetLocation = FVector::ZeroVector;
+	float Distance;
+	if (CalculateDistance(OwnerComp, NodeMemory, Distance))
+	{
+		UBlackboardComponent* MyBlackboard = OwnerComp.GetBlackboardComponent();
+		MyBlackboard->SetValue<UBlackboardKeyType_Float>(BlackboardKey.GetSelectedKeyID(), Distance);
+	}
+}
+
+bool UBTService_Distance::CalculateDistance(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory, float& Distance) const
+{
 	UBlackboardComponent* MyBlackboard = OwnerComp.GetBlackboardComponent();
+	if (MyBlackboard == nullptr)
+	{
+		return false;
+	}
+
+	const TNodeInstanceMemory* MyMemory = CastInstanceNodeMemory<TNodeInstanceMemory>(NodeMemory);
+	if (MyMemory->DistancePairHandle != INDEX_NONE)
+	{
+		// The target is kept up to date by the blackboard observer, locations and cylinders come from the shared cache
+		UBTDistanceSubsystem* DistanceSubsystem = UBTDistanceSubsystem::Get(&OwnerComp);
+		return DistanceSubsystem && DistanceSubsystem->GetDistance(MyMemory->DistancePairHandle, GeometricDistanceType, Distance);
+	}
+
+	FVector TargetLocation = FVector::ZeroVector;
 	const AAIController* MyController = OwnerComp.GetAIOwner();
 
-	if (MyBlackboard && MyBlackboard->GetLocationFromEntry(Observed.GetSelectedKeyID(), TargetLocation) && MyController && MyController->GetPawn())
+	if (MyBlackboard->GetLocationFromEntry(Observed.GetSelectedKeyID(), TargetLocation) && MyController && MyController->GetPawn())
 	{
 		float CollisionRadiusSum = 0.f;
 		float CollisionHalfHeightSum = 0.f;
 
 		if (bReachTestIncludesAgentRadius)
 		{
-			// Could be cached
 			MyController->GetPawn()->GetSimpleCollisionCylinder(CollisionRadiusSum, CollisionHalfHeightSum);
 		}
 
 		if (bReachTestIncludesGoalRadius)
 		{
-			// Could be cached?
 			UObject* ObservedValue = MyBlackboard->GetValue<UBlackboardKeyType_Object>(Observed.GetSelectedKeyID());
 			if (AActor* ObservedPawn = Cast<APawn>(ObservedValue))
 			{
@@ -70,10 +156,11 @@ void UBTService_Distance::TickNode(UBehaviorTreeComponent& OwnerComp, uint8* Nod
 			}
 		}
 
-		const float Distance = GetGeometricDistance(MyController->GetPawn()->GetActorLocation(), TargetLocation, CollisionRadiusSum, CollisionHalfHeightSum);
-
-		MyBlackboard->SetValue<UBlackboardKeyType_Float>(BlackboardKey.GetSelectedKeyID(), Distance);
+		Distance = GetGeometricDistance(MyController->GetPawn()->GetActorLocation(), TargetLocation, CollisionRadiusSum, CollisionHalfHeightSum);
+		return true;
 	}
+
+	return false;
 }
 
 FString UBTService_Distance::GetStaticDescription() const
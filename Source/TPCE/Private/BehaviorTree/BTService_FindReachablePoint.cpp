@@ -6,7 +6,7 @@
 #include "BehaviorTree/BlackboardComponent.h"
 #include "BehaviorTree/Blackboard/BlackboardKeyType_Object.h"
 #include "BehaviorTree/Blackboard/BlackboardKeyType_Vector.h"
-#include "NavigationSystem.h"
+#include "BehaviorTree/BTReachablePointSubsystem.h"
 
 UBTService_FindReachablePoint::UBTService_FindReachablePoint(const FObjectInitializer& ObjectInitializer)
 	: Super(ObjectInitializer)
@@ -19,6 +19,9 @@ UBTService_FindReachablePoint::UBTService_FindReachablePoint(const FObjectInitia
 	bNotifyCeaseRelevant = true;
 
 	Radius = 100.f;
+	bAsyncQuery = false;
+	PendingFallback = EReachablePointPendingFallback::Origin;
+	bUseCachedPoints = false;
 
 	// Accept only actors and vectors
 	BlackboardKey.AddObjectFilter(this, GET_MEMBER_NAME_CHECKED(UBTService_FindReachablePoint, BlackboardKey), AActor::StaticClass());
@@ -43,6 +46,9 @@ void UBTService_FindReachablePoint::OnBecomeRelevant(UBehaviorTreeComponent& Own
 {
 	Super::OnBecomeRelevant(OwnerComp, NodeMemory);
 
+	TNodeInstanceMemory* MyMemory = CastInstanceNodeMemory<TNodeInstanceMemory>(NodeMemory);
+	MyMemory->QueryId = 0;
+
 	const AAIController* MyController = OwnerComp.GetAIOwner();
 	UBlackboardComponent* MyBlackboard = OwnerComp.GetBlackboardComponent();
 
@@ -69,6 +75,39 @@ void UBTService_FindReachablePoint::OnBecomeRelevant(UBehaviorTreeComponent& Own
 				OriginLocation += MyController->GetPawn()->GetActorQuat().RotateVector(OriginOffset);
 			}
 
+			UBTReachablePointSubsystem* ReachablePointSubsystem = (bAsyncQuery || bUseCachedPoints) ? UBTReachablePointSubsystem::Get(&OwnerComp) : nullptr;
+			if (ReachablePointSubsystem)
+			{
+				const FReachablePointRequest Request = MakeReachablePointRequest(*MyController, OriginLocation);
+
+				FVector CachedPoint;
+				if (bUseCachedPoints && ReachablePointSubsystem->GetCachedReachablePoint(Request, CachedPoint))
+				{
+					MyBlackboard->SetValue<UBlackboardKeyType_Vector>(BlackboardKey.GetSelectedKeyID(), CachedPoint);
+					return;
+				}
+
+				if (bAsyncQuery)
+				{
+					MyMemory->QueryId = ReachablePointSubsystem->RequestReachablePoint(Request,
+						FOnReachablePointQueryFinished::CreateUObject(this, &UBTService_FindReachablePoint::OnReachablePointQueryFinished, TWeakObjectPtr<UBehaviorTreeComponent>(&OwnerComp)));
+
+					switch (PendingFallback)
+					{
+					case EReachablePointPendingFallback::Origin:
+						MyBlackboard->SetValue<UBlackboardKeyType_Vector>(BlackboardKey.GetSelectedKeyID(), OriginLocation);
+						break;
+					case EReachablePointPendingFallback::Clear:
+						MyBlackboard->ClearValue(BlackboardKey.GetSelectedKeyID());
+						break;
+					default:
+						break;
+					}
+					return;
+				}
+
+			}
+
 			FVector Result;
 			if (!GetRandomReachablePoint(OwnerComp, OriginLocation, Result))
 			{
@@ -76,6 +115,11 @@ void UBTService_FindReachablePoint::OnBecomeRelevant(UBehaviorTreeComponent& Own
 				// An invalid location will cause a MoveTo task to fail, so return the origin instead
 				Result = OriginLocation;
 			}
+			else if (ReachablePointSubsystem && bUseCachedPoints)
+			{
+				// Keep the live result as a sample of the cell, which fills up one request at a time
+				ReachablePointSubsystem->AddCacheSample(MakeReachablePointRequest(*MyController, OriginLocation), Result);
+			}
 			MyBlackboard->SetValue<UBlackboardKeyType_Vector>(BlackboardKey.GetSelectedKeyID(), Result);
 		}
 		else
@@ -85,31 +129,53 @@ void UBTService_FindReachablePoint::OnBecomeRelevant(UBehaviorTreeComponent& Own
 	}
 }
 
-bool UBTService_FindReachablePoint::GetRandomReachablePoint(const UBehaviorTreeComponent& OwnerComp, const FVector& InOrigin, FVector& OutRandomPoint) const
+void UBTService_FindReachablePoint::OnCeaseRelevant(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory)
 {
-	if (const AAIController* MyController = OwnerComp.GetAIOwner())
+	TNodeInstanceMemory* MyMemory = CastInstanceNodeMemory<TNodeInstanceMemory>(NodeMemory);
+	if (MyMemory->QueryId != 0)
 	{
-		if (UWorld* MyWorld = MyController->GetWorld())
+		if (UBTReachablePointSubsystem* ReachablePointSubsystem = UBTReachablePointSubsystem::Get(&OwnerComp))
 		{
-			if (UNavigationSystemV1* NavSys = FNavigationSystem::GetCurrent<UNavigationSystemV1>(MyWorld))
-			{
-				if (ANavigationData* NavData = NavSys->GetDefaultNavDataInstance(FNavigationSystem::DontCreate))
-				{
-					const TSubclassOf<UNavigationQueryFilter> UseFilterClass = *FilterClass ? FilterClass : MyController->GetDefaultNavigationFilterClass();
-					FNavLocation RandomPoint(InOrigin);
-					if (NavSys->GetRandomReachablePointInRadius(InOrigin, Radius, RandomPoint, NavData, UNavigationQueryFilter::GetQueryFilter(*NavData, MyController, UseFilterClass)))
-					{
-						OutRandomPoint = RandomPoint.Location;
-						return true;
-					}
-				}
-			}
-
-			OutRandomPoint = InOrigin + FVector(FMath::RandPointInCircle(Radius), 0.f);
-			return true;
+			ReachablePointSubsystem->CancelQuery(MyMemory->QueryId);
 		}
+		MyMemory->QueryId = 0;
+	}
+
+	Super::OnCeaseRelevant(OwnerComp, NodeMemory);
+}
+
+void UBTService_FindReachablePoint::OnReachablePointQueryFinished(uint32 QueryId, bool bSuccess, const FVector& Point, TWeakObjectPtr<UBehaviorTreeComponent> OwnerComp)
+{
+	if (!OwnerComp.IsValid())
+	{
+		return;
+	}
+
+	TNodeInstanceMemory* MyMemory = CastInstanceNodeMemory<TNodeInstanceMemory>(OwnerComp->GetNodeMemory(this, OwnerComp->FindInstanceContainingNode(this)));
+	UBlackboardComponent* MyBlackboard = OwnerComp->GetBlackboardComponent();
+	if (MyMemory && MyBlackboard && MyMemory->QueryId == QueryId)
+	{
+		// Point is the origin if the query failed which is still preferable to an invalid location for a MoveTo task
+		MyBlackboard->SetValue<UBlackboardKeyType_Vector>(BlackboardKey.GetSelectedKeyID(), Point);
+		MyMemory->QueryId = 0;
 	}
-	return false;
+}
+
+FReachablePointRequest UBTService_FindReachablePoint::MakeReachablePointRequest(const AAIController& Controller, const FVector& InOrigin) const
+{
+	FReachablePointRequest Request;
+	Request.Origin = InOrigin;
+	Request.Radius = Radius;
+	Request.FilterClass = *FilterClass ? FilterClass : Controller.GetDefaultNavigationFilterClass();
+	Request.Querier = &Controller;
+	Request.bUseCache = bUseCachedPoints;
+	return Request;
+}
+
+bool UBTService_FindReachablePoint::GetRandomReachablePoint(const UBehaviorTreeComponent& OwnerComp, const FVector& InOrigin, FVector& OutRandomPoint) const
+{
+	const AAIController* MyController = OwnerComp.GetAIOwner();
+	return MyController && UBTReachablePointSubsystem::GetRandomReachablePoint(MakeReachablePointRequest(*MyController, InOrigin), OutRandomPoint);
 }
 
 FString UBTService_FindReachablePoint::GetStaticDescription() const
@@ -5,6 +5,9 @@
 #include "AIController.h"
 #include "GameFramework/Actor.h"
 #include "GameFramework/Character.h"
+#include "GameFramework/CharacterMovementComponent.h"
+#include "Engine/World.h"
+#include "TimerManager.h"
 #include "Animation/AnimInstance.h"
 #include "BehaviorTree/Blackboard/BlackboardKeyType_Object.h"
 #include "BehaviorTree/Blackboard/BlackboardKeyType_Vector.h"
@@ -15,8 +18,11 @@ UBTTask_TurnTo::UBTTask_TurnTo(const FObjectInitializer& ObjectInitializer)
 {
 	NodeName = "Turn To";
 	bNotifyTick = true;
+	bNotifyTaskFinished = true;
 
+	RotationMode = ETurnToRotationMode::Actor;
 	Speed = 1.f;
+	MovementRotationRate = 360.f;
 	SpeedCurveName = NAME_None;
 	Tolerance = 5.f;
 	bConstantSpeed = false;
@@ -27,13 +33,69 @@ UBTTask_TurnTo::UBTTask_TurnTo(const FObjectInitializer& ObjectInitializer)
 	BlackboardKey.AddVectorFilter(this, GET_MEMBER_NAME_CHECKED(UBTTask_TurnTo, BlackboardKey));
 }
 
+void UBTTask_TurnTo::InitializeFromAsset(UBehaviorTree& Asset)
+{
+	Super::InitializeFromAsset(Asset);
+
+	// The movement component applies the rotation and completion is checked from a timer
+	bNotifyTick = (RotationMode == ETurnToRotationMode::Actor);
+}
 
 EBTNodeResult::Type UBTTask_TurnTo::ExecuteTask(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory)
 {
+	TNodeInstanceMemory* MyMemory = CastInstanceNodeMemory<TNodeInstanceMemory>(NodeMemory);
+	MyMemory->bDrivenByMovement = false;
+	MyMemory->bDrivenByTimer = false;
+
+	if (RotationMode == ETurnToRotationMode::MovementComponent)
+	{
+		if (BeginMovementRotation(OwnerComp, *MyMemory))
+		{
+			return UpdateMovementRotation(OwnerComp, *MyMemory);
+		}
+
+		MyMemory->bDrivenByTimer = true;
+		MyMemory->TimerHandle = OwnerComp.GetWorld()->GetTimerManager().SetTimerForNextTick(
+			FTimerDelegate::CreateUObject(this, &UBTTask_TurnTo::OnActorRotationTimer, TWeakObjectPtr<UBehaviorTreeComponent>(&OwnerComp)));
+	}
+
 	return EBTNodeResult::InProgress;
 }
 
 void UBTTask_TurnTo::TickTask(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory, float DeltaSeconds)
+{
+	const EBTNodeResult::Type Result = UpdateActorRotation(OwnerComp, DeltaSeconds);
+	if (Result != EBTNodeResult::InProgress)
+	{
+		FinishLatentTask(OwnerComp, Result);
+	}
+}
+
+void UBTTask_TurnTo::OnActorRotationTimer(TWeakObjectPtr<UBehaviorTreeComponent> OwnerComp)
+{
+	if (!OwnerComp.IsValid())
+	{
+		return;
+	}
+
+	TNodeInstanceMemory* MyMemory = CastInstanceNodeMemory<TNodeInstanceMemory>(OwnerComp->GetNodeMemory(this, OwnerComp->FindInstanceContainingNode(this)));
+	if (MyMemory && MyMemory->bDrivenByTimer)
+	{
+		UWorld* MyWorld = OwnerComp->GetWorld();
+		const EBTNodeResult::Type Result = UpdateActorRotation(*OwnerComp, MyWorld->GetDeltaSeconds());
+		if (Result != EBTNodeResult::InProgress)
+		{
+			FinishLatentTask(*OwnerComp, Result);
+		}
+		else
+		{
+			MyMemory->TimerHandle = MyWorld->GetTimerManager().SetTimerForNextTick(
+				FTimerDelegate::CreateUObject(this, &UBTTask_TurnTo::OnActorRotationTimer, OwnerComp));
+		}
+	}
+}
+
+EBTNodeResult::Type UBTTask_TurnTo::UpdateActorRotation(UBehaviorTreeComponent& OwnerComp, float DeltaSeconds)
 {
 	AAIController* MyController = OwnerComp.GetAIOwner();
 	const UBlackboardComponent* MyBlackboard = OwnerComp.GetBlackboardComponent();
@@ -50,8 +112,6 @@ void UBTTask_TurnTo::TickTask(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemo
 			TargetRotation = GetLookAtRotation(MyPawn->GetActorLocation(), TargetLocation);
 		}
 
-		MyBlackboard->GetLocationFromEntry(BlackboardKey.GetSelectedKeyID(), TargetLocation);
-
 		// Scale speed by animation value if the curve name is given
 		float CurrentSpeed = Speed;
 		if (SpeedCurveName != NAME_None)
@@ -88,14 +148,164 @@ void UBTTask_TurnTo::TickTask(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemo
 			const float DeltaDegrees = FMath::RadiansToDegrees(NewRotation.AngularDistance(TargetRotation));
 			if (DeltaDegrees <= Tolerance)
 			{
-				FinishLatentTask(OwnerComp, EBTNodeResult::Succeeded);
+				return EBTNodeResult::Succeeded;
+			}
+		}
+
+		return EBTNodeResult::InProgress;
+	}
+
+	// Invalid state
+	return EBTNodeResult::Failed;
+}
+
+void UBTTask_TurnTo::OnTaskFinished(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory, EBTNodeResult::Type TaskResult)
+{
+	TNodeInstanceMemory* MyMemory = CastInstanceNodeMemory<TNodeInstanceMemory>(NodeMemory);
+	if (MyMemory->bDrivenByMovement || MyMemory->bDrivenByTimer)
+	{
+		if (UWorld* MyWorld = OwnerComp.GetWorld())
+		{
+			MyWorld->GetTimerManager().ClearTimer(MyMemory->TimerHandle);
+		}
+		MyMemory->bDrivenByTimer = false;
+	}
+
+	if (MyMemory->bDrivenByMovement)
+	{
+		if (AAIController* MyController = OwnerComp.GetAIOwner())
+		{
+			MyController->ClearFocus(EAIFocusPriority::Gameplay + 1);
+
+			if (ACharacter* MyCharacter = Cast<ACharacter>(MyController->GetPawn()))
+			{
+				MyCharacter->bUseControllerRotationPitch = MyMemory->bSavedUseControllerRotationPitch;
+				MyCharacter->bUseControllerRotationYaw = MyMemory->bSavedUseControllerRotationYaw;
+				MyCharacter->bUseControllerRotationRoll = MyMemory->bSavedUseControllerRotationRoll;
+
+				if (UCharacterMovementComponent* MovementComponent = MyCharacter->GetCharacterMovement())
+				{
+					MovementComponent->RotationRate = MyMemory->SavedRotationRate;
+					MovementComponent->bUseControllerDesiredRotation = MyMemory->bSavedUseControllerDesiredRotation;
+					MovementComponent->bOrientRotationToMovement = MyMemory->bSavedOrientRotationToMovement;
+				}
 			}
 		}
+
+		MyMemory->bDrivenByMovement = false;
+	}
+
+	Super::OnTaskFinished(OwnerComp, NodeMemory, TaskResult);
+}
+
+bool UBTTask_TurnTo::BeginMovementRotation(UBehaviorTreeComponent& OwnerComp, TNodeInstanceMemory& MyMemory)
+{
+	AAIController* MyController = OwnerComp.GetAIOwner();
+	const UBlackboardComponent* MyBlackboard = OwnerComp.GetBlackboardComponent();
+	ACharacter* MyCharacter = MyController ? Cast<ACharacter>(MyController->GetPawn()) : nullptr;
+	UCharacterMovementComponent* MovementComponent = MyCharacter ? MyCharacter->GetCharacterMovement() : nullptr;
+
+	if (MovementComponent == nullptr || MyBlackboard == nullptr)
+	{
+		return false;
+	}
+
+	// Focus updates the control rotation which the movement component follows as part of its own scoped movement update.
+	// Use a priority above gameplay so that other focus is restored when the task finishes.
+	const EAIFocusPriority::Type FocusPriority = EAIFocusPriority::Gameplay + 1;
+	if (BlackboardKey.SelectedKeyType == UBlackboardKeyType_Object::StaticClass())
+	{
+		AActor* TargetActor = Cast<AActor>(MyBlackboard->GetValue<UBlackboardKeyType_Object>(BlackboardKey.GetSelectedKeyID()));
+		if (TargetActor == nullptr)
+		{
+			return false;
+		}
+		MyController->SetFocus(TargetActor, FocusPriority);
 	}
 	else
+	{
+		FVector TargetLocation;
+		if (!MyBlackboard->GetLocationFromEntry(BlackboardKey.GetSelectedKeyID(), TargetLocation))
+		{
+			return false;
+		}
+		MyController->SetFocalPoint(TargetLocation, FocusPriority);
+	}
+
+	MyMemory.SavedRotationRate = MovementComponent->RotationRate;
+	MyMemory.bSavedUseControllerDesiredRotation = MovementComponent->bUseControllerDesiredRotation;
+	MyMemory.bSavedOrientRotationToMovement = MovementComponent->bOrientRotationToMovement;
+	MyMemory.bSavedUseControllerRotationPitch = MyCharacter->bUseControllerRotationPitch;
+	MyMemory.bSavedUseControllerRotationYaw = MyCharacter->bUseControllerRotationYaw;
+	MyMemory.bSavedUseControllerRotationRoll = MyCharacter->bUseControllerRotationRoll;
+	MyMemory.bDrivenByMovement = true;
+
+	MovementComponent->RotationRate = FRotator(bYawOnly ? 0.f : MovementRotationRate, MovementRotationRate, 0.f);
+	MovementComponent->bUseControllerDesiredRotation = true;
+	MovementComponent->bOrientRotationToMovement = false;
+
+	// Otherwise the controller snaps the pawn to the control rotation, bypassing the rotation rate
+	MyCharacter->bUseControllerRotationPitch = false;
+	MyCharacter->bUseControllerRotationYaw = false;
+	MyCharacter->bUseControllerRotationRoll = false;
+
+	return true;
+}
+
+EBTNodeResult::Type UBTTask_TurnTo::UpdateMovementRotation(UBehaviorTreeComponent& OwnerComp, TNodeInstanceMemory& MyMemory)
+{
+	// Continues indefinitely
+	if (Tolerance <= 0.f)
+	{
+		return EBTNodeResult::InProgress;
+	}
+
+	const AAIController* MyController = OwnerComp.GetAIOwner();
+	const APawn* MyPawn = MyController ? MyController->GetPawn() : nullptr;
+	if (MyPawn == nullptr)
 	{
 		// Invalid state
-		FinishLatentTask(OwnerComp, EBTNodeResult::Failed);
+		return EBTNodeResult::Failed;
+	}
+
+	// Walking and falling characters stay upright whatever the desired rotation, so only their yaw can reach the target
+	const ACharacter* MyCharacter = Cast<ACharacter>(MyPawn);
+	const UCharacterMovementComponent* MovementComponent = MyCharacter ? MyCharacter->GetCharacterMovement() : nullptr;
+	const bool bCompareYawOnly = bYawOnly || MovementComponent == nullptr || MovementComponent->ShouldRemainVertical();
+
+	const FQuat TargetRotation = GetLookAtRotation(MyPawn->GetActorLocation(), MyController->GetFocalPoint());
+	const float DeltaDegrees = bCompareYawOnly
+		? FMath::Abs(FRotator::NormalizeAxis(MyPawn->GetActorRotation().Yaw - TargetRotation.Rotator().Yaw))
+		: FMath::RadiansToDegrees(MyPawn->GetActorQuat().AngularDistance(TargetRotation));
+	if (DeltaDegrees <= Tolerance)
+	{
+		return EBTNodeResult::Succeeded;
+	}
+
+	// Check again when the movement component is expected to have covered the remaining angle
+	const float MinCheckInterval = 0.05f;
+	const float Delay = (MovementRotationRate > 0.f) ? FMath::Max(MinCheckInterval, (DeltaDegrees - Tolerance) / MovementRotationRate) : MinCheckInterval;
+	OwnerComp.GetWorld()->GetTimerManager().SetTimer(MyMemory.TimerHandle,
+		FTimerDelegate::CreateUObject(this, &UBTTask_TurnTo::OnMovementRotationTimer, TWeakObjectPtr<UBehaviorTreeComponent>(&OwnerComp)), Delay, false);
+
+	return EBTNodeResult::InProgress;
+}
+
+void UBTTask_TurnTo::OnMovementRotationTimer(TWeakObjectPtr<UBehaviorTreeComponent> OwnerComp)
+{
+	if (!OwnerComp.IsValid())
+	{
+		return;
+	}
+
+	TNodeInstanceMemory* MyMemory = CastInstanceNodeMemory<TNodeInstanceMemory>(OwnerComp->GetNodeMemory(this, OwnerComp->FindInstanceContainingNode(this)));
+	if (MyMemory && MyMemory->bDrivenByMovement)
+	{
+		const EBTNodeResult::Type Result = UpdateMovementRotation(*OwnerComp, *MyMemory);
+		if (Result != EBTNodeResult::InProgress)
+		{
+			FinishLatentTask(*OwnerComp, Result);
+		}
 	}
 }
 
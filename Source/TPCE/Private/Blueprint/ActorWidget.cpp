@@ -1,6 +1,7 @@
 // This source code is licensed under the MIT license found in the LICENSE file in the root directory of this source tree.
 
 #include "Blueprint/ActorWidget.h"
+#include "Components/ActorWidgetComponent.h"
 
 UActorWidget::UActorWidget(const FObjectInitializer& ObjectInitializer)
 	: Super(ObjectInitializer)
@@ -21,6 +22,17 @@ void UActorWidget::SetWidgetComponent(UActorWidgetComponent* NewWidgetComponent)
 		ActorWidgetComponent = NewWidgetComponent;
 		OnWidgetComponentChanged(OldWidgetComponent);
 		K2_OnWidgetComponentChanged(OldWidgetComponent);
+
+		// Rebound to new data
+		InvalidateWidgetComponent();
+	}
+}
+
+void UActorWidget::InvalidateWidgetComponent()
+{
+	if (ActorWidgetComponent)
+	{
+		ActorWidgetComponent->RequestRedraw();
 	}
 }
 
@@ -0,0 +1,159 @@
+// This source code is licensed under the MIT license found in the LICENSE file in the root directory of this source tree.
+
+#include "Blueprint/ActorWidgetPoolSubsystem.h"
+
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+#include "Blueprint/UserWidget.h"
+#include "Components/ActorWidgetComponent.h"
+#include "HAL/IConsoleManager.h"
+
+static TAutoConsoleVariable<int32> CVarActorWidgetPoolMaxAcquiresPerFrame(TEXT("ui.ActorWidgetPool.MaxAcquiresPerFrame"), 8, TEXT("Maximum number of pooled actor widgets assigned to components per frame. Widgets over budget are assigned on the next frames."));
+static TAutoConsoleVariable<float> CVarActorWidgetPoolReleaseDelay(TEXT("ui.ActorWidgetPool.ReleaseDelay"), .5f, TEXT("Time in seconds a component has to fail culling before its widget is returned to the pool."));
+static TAutoConsoleVariable<int32> CVarActorWidgetPoolMaxFreeWidgets(TEXT("ui.ActorWidgetPool.MaxFreeWidgets"), 32, TEXT("Maximum number of free widgets kept per widget class."));
+
+void UActorWidgetPoolSubsystem::Deinitialize()
+{
+	RegisteredComponents.Empty();
+	Pools.Empty();
+
+	Super::Deinitialize();
+}
+
+UActorWidgetPoolSubsystem* UActorWidgetPoolSubsystem::Get(const UObject* WorldContextObject)
+{
+	const UWorld* World = GEngine ? GEngine->GetWorldFromContextObject(WorldContextObject, EGetWorldErrorMode::ReturnNull) : nullptr;
+	return World ? World->GetSubsystem<UActorWidgetPoolSubsystem>() : nullptr;
+}
+
+ETickableTickType UActorWidgetPoolSubsystem::GetTickableTickType() const
+{
+	return HasAnyFlags(RF_ClassDefaultObject) ? ETickableTickType::Never : ETickableTickType::Conditional;
+}
+
+bool UActorWidgetPoolSubsystem::IsTickable() const
+{
+	return RegisteredComponents.Num() > 0;
+}
+
+TStatId UActorWidgetPoolSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UActorWidgetPoolSubsystem, STATGROUP_Tickables);
+}
+
+void UActorWidgetPoolSubsystem::Tick(float DeltaTime)
+{
+	const float TimeSeconds = GetWorld()->GetTimeSeconds();
+	const float ReleaseDelay = FMath::Max(0.f, CVarActorWidgetPoolReleaseDelay.GetValueOnGameThread());
+	int32 NumAcquiresLeft = FMath::Max(1, CVarActorWidgetPoolMaxAcquiresPerFrame.GetValueOnGameThread());
+
+	for (int32 Index = RegisteredComponents.Num() - 1; Index >= 0; --Index)
+	{
+		FRegisteredComponent& Entry = RegisteredComponents[Index];
+		UActorWidgetComponent* Component = Entry.Component.Get();
+		if (Component == nullptr)
+		{
+			RegisteredComponents.RemoveAtSwap(Index, 1, false);
+			continue;
+		}
+
+		if (Component->PassesWidgetCulling())
+		{
+			Entry.LastRelevantTime = TimeSeconds;
+			if (Component->GetWidget() == nullptr && NumAcquiresLeft > 0)
+			{
+				Component->AcquirePooledWidget(*this);
+				NumAcquiresLeft--;
+			}
+		}
+		else if (Component->GetWidget() && TimeSeconds - Entry.LastRelevantTime >= ReleaseDelay)
+		{
+			Component->ReleasePooledWidget(*this);
+		}
+	}
+}
+
+void UActorWidgetPoolSubsystem::RegisterComponent(UActorWidgetComponent* Component)
+{
+	check(Component);
+
+	if (!RegisteredComponents.ContainsByPredicate([Component](const FRegisteredComponent& Entry) { return Entry.Component == Component; }))
+	{
+		FRegisteredComponent& Entry = RegisteredComponents.AddDefaulted_GetRef();
+		Entry.Component = Component;
+		Entry.LastRelevantTime = -BIG_NUMBER;
+	}
+}
+
+void UActorWidgetPoolSubsystem::UnregisterComponent(UActorWidgetComponent* Component)
+{
+	check(Component);
+
+	const int32 Index = RegisteredComponents.IndexOfByPredicate([Component](const FRegisteredComponent& Entry) { return Entry.Component == Component; });
+	if (Index != INDEX_NONE)
+	{
+		RegisteredComponents.RemoveAtSwap(Index, 1, false);
+		Component->ReleasePooledWidget(*this);
+	}
+}
+
+UUserWidget* UActorWidgetPoolSubsystem::AcquireWidget(TSubclassOf<UUserWidget> WidgetClass)
+{
+	if (WidgetClass == nullptr)
+	{
+		return nullptr;
+	}
+
+	if (FActorWidgetPool* Pool = Pools.Find(WidgetClass))
+	{
+		while (Pool->FreeWidgets.Num() > 0)
+		{
+			UUserWidget* Widget = Pool->FreeWidgets.Pop(false);
+			if (IsValid(Widget))
+			{
+				return Widget;
+			}
+		}
+	}
+
+	return CreateWidget(GetWorld(), WidgetClass);
+}
+
+void UActorWidgetPoolSubsystem::ReleaseWidget(UUserWidget* Widget)
+{
+	if (!IsValid(Widget))
+	{
+		return;
+	}
+
+	FActorWidgetPool& Pool = Pools.FindOrAdd(Widget->GetClass());
+	if (Pool.FreeWidgets.Num() < CVarActorWidgetPoolMaxFreeWidgets.GetValueOnGameThread())
+	{
+		Pool.FreeWidgets.Add(Widget);
+	}
+}
+
+void UActorWidgetPoolSubsystem::PrewarmPool(TSubclassOf<UUserWidget> WidgetClass, int32 Count)
+{
+	if (WidgetClass == nullptr)
+	{
+		return;
+	}
+
+	FActorWidgetPool& Pool = Pools.FindOrAdd(WidgetClass);
+	while (Pool.FreeWidgets.Num() < Count)
+	{
+		UUserWidget* Widget = CreateWidget(GetWorld(), WidgetClass);
+		if (Widget == nullptr)
+		{
+			break;
+		}
+		Pool.FreeWidgets.Add(Widget);
+	}
+}
+
+int32 UActorWidgetPoolSubsystem::GetNumFreeWidgets(TSubclassOf<UUserWidget> WidgetClass) const
+{
+	const FActorWidgetPool* Pool = Pools.Find(WidgetClass);
+	return Pool ? Pool->FreeWidgets.Num() : 0;
+}
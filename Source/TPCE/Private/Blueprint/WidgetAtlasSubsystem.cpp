@@ -0,0 +1,181 @@
+// This source code is licensed under the MIT license found in the LICENSE file in the root directory of this source tree.
+
+#include "Blueprint/WidgetAtlasSubsystem.h"
+
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+#include "Engine/TextureRenderTarget2D.h"
+#include "HAL/IConsoleManager.h"
+#include "RHI.h"
+#include "ClearQuad.h"
+#include "RHICommandList.h"
+#include "RenderingThread.h"
+
+static TAutoConsoleVariable<int32> CVarWidgetAtlasPageSize(TEXT("ui.WidgetAtlas.PageSize"), 2048, TEXT("Size of widget atlas pages in pixels. Applied when a world is initialized."));
+static TAutoConsoleVariable<int32> CVarWidgetAtlasMaxPages(TEXT("ui.WidgetAtlas.MaxPages"), 4, TEXT("Maximum number of widget atlas pages. Widgets that don't fit fall back to their own render target. Applied when a world is initialized."));
+
+namespace WidgetAtlas
+{
+	// Slot sizes are rounded up so that released slots are more likely to fit other widgets
+	const int32 SlotGranularity = 16;
+
+	// Shelves are only shared by slots that are at least this fraction of the shelf height
+	const float MinShelfFill = .75f;
+}
+
+void UWidgetAtlasSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	PageSize = FMath::Clamp(CVarWidgetAtlasPageSize.GetValueOnGameThread(), 256, (int32)GetMax2DTextureDimension());
+	MaxPages = FMath::Max(1, CVarWidgetAtlasMaxPages.GetValueOnGameThread());
+}
+
+void UWidgetAtlasSubsystem::Deinitialize()
+{
+	Pages.Empty();
+	PageLayouts.Empty();
+
+	Super::Deinitialize();
+}
+
+UWidgetAtlasSubsystem* UWidgetAtlasSubsystem::Get(const UObject* WorldContextObject)
+{
+	const UWorld* World = GEngine ? GEngine->GetWorldFromContextObject(WorldContextObject, EGetWorldErrorMode::ReturnNull) : nullptr;
+	return World ? World->GetSubsystem<UWidgetAtlasSubsystem>() : nullptr;
+}
+
+FWidgetAtlasSlot UWidgetAtlasSubsystem::AllocateSlot(FIntPoint Size)
+{
+	FWidgetAtlasSlot Slot;
+
+	Size.X = FMath::DivideAndRoundUp(FMath::Max(Size.X, 1), WidgetAtlas::SlotGranularity) * WidgetAtlas::SlotGranularity;
+	Size.Y = FMath::DivideAndRoundUp(FMath::Max(Size.Y, 1), WidgetAtlas::SlotGranularity) * WidgetAtlas::SlotGranularity;
+	if (Size.X > PageSize || Size.Y > PageSize)
+	{
+		return Slot;
+	}
+
+	for (int32 PageIndex = 0; PageIndex < PageLayouts.Num(); ++PageIndex)
+	{
+		if (AllocateInPage(PageLayouts[PageIndex], Size, Slot.Rect))
+		{
+			Slot.PageIndex = PageIndex;
+			return Slot;
+		}
+	}
+
+	const int32 NewPageIndex = AddPage();
+	if (NewPageIndex != INDEX_NONE && AllocateInPage(PageLayouts[NewPageIndex], Size, Slot.Rect))
+	{
+		Slot.PageIndex = NewPageIndex;
+	}
+
+	return Slot;
+}
+
+void UWidgetAtlasSubsystem::ReleaseSlot(FWidgetAtlasSlot& Slot)
+{
+	if (PageLayouts.IsValidIndex(Slot.PageIndex))
+	{
+		for (FShelf& Shelf : PageLayouts[Slot.PageIndex].Shelves)
+		{
+			if (Shelf.Y == Slot.Rect.Min.Y)
+			{
+				Shelf.FreeRects.Add(Slot.Rect);
+				break;
+			}
+		}
+	}
+
+	Slot = FWidgetAtlasSlot();
+}
+
+bool UWidgetAtlasSubsystem::AllocateInPage(FPageLayout& Layout, FIntPoint Size, FIntRect& OutRect) const
+{
+	for (FShelf& Shelf : Layout.Shelves)
+	{
+		if (Size.Y > Shelf.Height || Size.Y < Shelf.Height * WidgetAtlas::MinShelfFill)
+		{
+			continue;
+		}
+
+		// Reuse the narrowest released slot that fits
+		int32 BestFreeIndex = INDEX_NONE;
+		for (int32 FreeIndex = 0; FreeIndex < Shelf.FreeRects.Num(); ++FreeIndex)
+		{
+			const int32 Width = Shelf.FreeRects[FreeIndex].Width();
+			if (Width >= Size.X && (BestFreeIndex == INDEX_NONE || Width < Shelf.FreeRects[BestFreeIndex].Width()))
+			{
+				BestFreeIndex = FreeIndex;
+			}
+		}
+
+		if (BestFreeIndex != INDEX_NONE)
+		{
+			OutRect = Shelf.FreeRects[BestFreeIndex];
+			Shelf.FreeRects.RemoveAtSwap(BestFreeIndex, 1, false);
+			return true;
+		}
+
+		if (Shelf.UsedWidth + Size.X <= PageSize)
+		{
+			OutRect = FIntRect(Shelf.UsedWidth, Shelf.Y, Shelf.UsedWidth + Size.X, Shelf.Y + Shelf.Height);
+			Shelf.UsedWidth += Size.X;
+			return true;
+		}
+	}
+
+	if (Layout.UsedHeight + Size.Y <= PageSize)
+	{
+		FShelf& Shelf = Layout.Shelves.AddDefaulted_GetRef();
+		Shelf.Y = Layout.UsedHeight;
+		Shelf.Height = Size.Y;
+		Shelf.UsedWidth = Size.X;
+		Layout.UsedHeight += Size.Y;
+
+		OutRect = FIntRect(0, Shelf.Y, Size.X, Shelf.Y + Shelf.Height);
+		return true;
+	}
+
+	return false;
+}
+
+int32 UWidgetAtlasSubsystem::AddPage()
+{
+	if (Pages.Num() >= MaxPages)
+	{
+		return INDEX_NONE;
+	}
+
+	UTextureRenderTarget2D* RenderTarget = NewObject<UTextureRenderTarget2D>(this, NAME_None, RF_Transient);
+	RenderTarget->ClearColor = FLinearColor::Transparent;
+	RenderTarget->InitCustomFormat(PageSize, PageSize, PF_B8G8R8A8, false);
+	RenderTarget->UpdateResourceImmediate(true);
+
+	FPageLayout& Layout = PageLayouts.AddDefaulted_GetRef();
+	Layout.UsedHeight = 0;
+
+	return Pages.Add(RenderTarget);
+}
+
+void UWidgetAtlasSubsystem::ClearSlot(const FWidgetAtlasSlot& Slot) const
+{
+	UTextureRenderTarget2D* RenderTarget = GetPageRenderTarget(Slot.PageIndex);
+	FTextureRenderTargetResource* Resource = RenderTarget ? RenderTarget->GameThread_GetRenderTargetResource() : nullptr;
+	if (Resource == nullptr)
+	{
+		return;
+	}
+
+	const FIntRect Rect = Slot.Rect;
+	ENQUEUE_RENDER_COMMAND(ClearWidgetAtlasSlot)(
+		[Resource, Rect](FRHICommandListImmediate& RHICmdList)
+		{
+			FRHIRenderPassInfo RPInfo(Resource->GetRenderTargetTexture(), ERenderTargetActions::Load_Store);
+			RHICmdList.BeginRenderPass(RPInfo, TEXT("ClearWidgetAtlasSlot"));
+			RHICmdList.SetViewport(Rect.Min.X, Rect.Min.Y, 0.f, Rect.Max.X, Rect.Max.Y, 1.f);
+			DrawClearQuad(RHICmdList, FLinearColor::Transparent);
+			RHICmdList.EndRenderPass();
+		});
+}
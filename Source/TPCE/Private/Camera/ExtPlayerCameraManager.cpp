@@ -2,6 +2,16 @@
 
 #include "Camera/ExtPlayerCameraManager.h"
 
+#include "Application/InputLatencyTracker.h"
+
+void AExtPlayerCameraManager::UpdateCamera(float DeltaTime)
+{
+	Super::UpdateCamera(DeltaTime);
+
+	// The POV is final once view target cameras, arms and camera modifiers are applied
+	MARK_INPUT_LATENCY(CameraPOV);
+}
+
 float AExtPlayerCameraManager::GetBlendTimeToGo() const
 {
 	return BlendTimeToGo;
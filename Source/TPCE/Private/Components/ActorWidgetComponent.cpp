@@ -2,12 +2,20 @@
 
 #include "Components/ActorWidgetComponent.h"
 #include "Blueprint/ActorWidget.h"
+#include "Blueprint/ActorWidgetPoolSubsystem.h"
+#include "Engine/LocalPlayer.h"
+#include "GameFramework/PlayerController.h"
 #include "Logging/LogMacros.h"
 #include "Kismet/Kismet.h"
 
 DEFINE_LOG_CATEGORY_STATIC(LogActorWidgetComponent, Log, All);
 
 UActorWidgetComponent::UActorWidgetComponent()
+	: bPoolWidget(false)
+	, PoolCullDistance(0.f)
+	, bPoolCullOffScreen(true)
+	, PoolOffScreenMargin(.1f)
+	, bRegisteredToPool(false)
 {
 	PrimaryComponentTick.bStartWithTickEnabled = false;
 	bAutoActivate = false;
@@ -78,8 +86,28 @@ void UActorWidgetComponent::OnVisibilityChanged()
 		GetUserWidgetObject()->SetVisibility(IsVisible() ? ESlateVisibility::Visible : ESlateVisibility::Hidden);
 }
 
+bool UActorWidgetComponent::ShouldDrawWidget() const
+{
+	return Super::ShouldDrawWidget() && RedrawPolicy.CanRedraw(*this, bRedrawRequested, LastWidgetRenderTime, GetCurrentTime());
+}
+
 void UActorWidgetComponent::InitWidget()
 {
+	if (bPoolWidget && !bRegisteredToPool && GetWidgetClass() && GetWorld() && GetWorld()->IsGameWorld())
+	{
+		// The widget is assigned by the pool once the component passes culling
+		if (UActorWidgetPoolSubsystem* Pool = UActorWidgetPoolSubsystem::Get(this))
+		{
+			Pool->RegisterComponent(this);
+			bRegisteredToPool = true;
+		}
+	}
+
+	if (bRegisteredToPool)
+	{
+		return;
+	}
+
 	Super::InitWidget();
 
 	if (UActorWidget* ActorWidget = Cast<UActorWidget>(GetWidget()))
@@ -118,6 +146,99 @@ void UActorWidgetComponent::OnRegister()
 	}
 }
 
+void UActorWidgetComponent::OnUnregister()
+{
+	if (bRegisteredToPool)
+	{
+		if (UActorWidgetPoolSubsystem* Pool = UActorWidgetPoolSubsystem::Get(this))
+		{
+			Pool->UnregisterComponent(this);
+		}
+		bRegisteredToPool = false;
+	}
+
+	Super::OnUnregister();
+}
+
+bool UActorWidgetComponent::PassesWidgetCulling() const
+{
+	const AActor* Owner = GetOwner();
+	if (!IsActive() || !IsVisible() || bHiddenInGame || (Owner && Owner->IsHidden()))
+	{
+		return false;
+	}
+
+	UWorld* World = GetWorld();
+	const APlayerController* PlayerController = GetOwnerPlayer() ? GetOwnerPlayer()->GetPlayerController(World) : World->GetFirstPlayerController();
+	if (PlayerController == nullptr)
+	{
+		return false;
+	}
+
+	const FVector Location = GetComponentLocation();
+
+	if (PoolCullDistance > 0.f)
+	{
+		FVector ViewLocation;
+		FRotator ViewRotation;
+		PlayerController->GetPlayerViewPoint(ViewLocation, ViewRotation);
+		if (FVector::DistSquared(ViewLocation, Location) > FMath::Square(PoolCullDistance))
+		{
+			return false;
+		}
+	}
+
+	if (bPoolCullOffScreen)
+	{
+		FVector2D ScreenPosition;
+		if (!PlayerController->ProjectWorldLocationToScreen(Location, ScreenPosition, true))
+		{
+			return false;
+		}
+
+		int32 SizeX, SizeY;
+		PlayerController->GetViewportSize(SizeX, SizeY);
+		const FVector2D Margin = FVector2D(SizeX, SizeY) * PoolOffScreenMargin;
+		if (ScreenPosition.X < -Margin.X || ScreenPosition.Y < -Margin.Y || ScreenPosition.X > SizeX + Margin.X || ScreenPosition.Y > SizeY + Margin.Y)
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+void UActorWidgetComponent::AcquirePooledWidget(UActorWidgetPoolSubsystem& Pool)
+{
+	if (GetWidget())
+	{
+		return;
+	}
+
+	if (UUserWidget* PooledWidget = Pool.AcquireWidget(GetWidgetClass()))
+	{
+		if (ULocalPlayer* LocalPlayer = GetOwnerPlayer())
+		{
+			PooledWidget->SetPlayerContext(FLocalPlayerContext(LocalPlayer, GetWorld()));
+		}
+
+		// Make sure the widget will not respond to visibility traces
+		PooledWidget->SetVisibility(IsVisible() ? ESlateVisibility::Visible : ESlateVisibility::Hidden);
+		SetWidget(PooledWidget);
+		RequestRedraw();
+	}
+}
+
+void UActorWidgetComponent::ReleasePooledWidget(UActorWidgetPoolSubsystem& Pool)
+{
+	if (UUserWidget* PooledWidget = GetWidget())
+	{
+		// Unbinds the actor widget from this component
+		SetWidget(nullptr);
+		Pool.ReleaseWidget(PooledWidget);
+	}
+}
+
 void UActorWidgetComponent::OnPlayerAdded(int32 PlayerIndex)
 {
 	ULocalPlayer* Player = GetWorld()->GetGameInstance()->GetLocalPlayerByIndex(PlayerIndex);
@@ -2,13 +2,41 @@
 
 #include "Components/ScalableWidgetComponent.h"
 
+#include "Engine/LocalPlayer.h"
 #include "Engine/TextureRenderTarget2D.h"
+#include "GameFramework/PlayerController.h"
+#include "Camera/PlayerCameraManager.h"
+#include "Materials/MaterialInstanceDynamic.h"
 #include "Slate/WidgetRenderer.h"
 #include "Widgets/SWindow.h"
 
+const FName UScalableWidgetComponent::AtlasUVRectParameterName(TEXT("AtlasUVRect"));
+
 UScalableWidgetComponent::UScalableWidgetComponent()
 	: RenderScale(1.0f)
+	, bAutoRenderScale(false)
+	, RenderScaleTiers({ 1.f, .5f, .25f })
+	, RenderScaleHysteresis(.15f)
+	, bUseRenderTargetAtlas(false)
+	, AtlasDrawSize(0, 0)
+{
+}
+
+void UScalableWidgetComponent::TickComponent(float DeltaTime, enum ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
 {
+	if (bAutoRenderScale)
+	{
+		UpdateAutoRenderScale();
+	}
+
+	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
+}
+
+void UScalableWidgetComponent::OnUnregister()
+{
+	ReleaseAtlasSlot();
+
+	Super::OnUnregister();
 }
 
 void UScalableWidgetComponent::SetRenderScale(const float NewRenderScale)
@@ -16,10 +44,87 @@ void UScalableWidgetComponent::SetRenderScale(const float NewRenderScale)
 	if (RenderScale != NewRenderScale)
 	{
 		RenderScale = NewRenderScale;
-		if (IsRegistered())
+
+		// The render target is resized on the next draw, which marks render state dirty only if needed
+		RequestRedraw();
+	}
+}
+
+void UScalableWidgetComponent::SetAutoRenderScale(bool bEnabled)
+{
+	bAutoRenderScale = bEnabled;
+}
+
+float UScalableWidgetComponent::GetProjectedRenderScale() const
+{
+	UWorld* World = GetWorld();
+	if (World == nullptr)
+	{
+		return -1.f;
+	}
+
+	const ULocalPlayer* LocalPlayer = GetOwnerPlayer();
+	const APlayerController* PlayerController = LocalPlayer ? LocalPlayer->GetPlayerController(World) : World->GetFirstPlayerController();
+	if (PlayerController == nullptr || PlayerController->PlayerCameraManager == nullptr)
+	{
+		return -1.f;
+	}
+
+	int32 ViewportSizeX, ViewportSizeY;
+	PlayerController->GetViewportSize(ViewportSizeX, ViewportSizeY);
+	const float HalfFOVRadians = FMath::DegreesToRadians(PlayerController->PlayerCameraManager->GetFOVAngle() * .5f);
+	if (ViewportSizeX <= 0 || HalfFOVRadians <= 0.f)
+	{
+		return -1.f;
+	}
+
+	// Widgets are drawn at one unit per pixel, so the pixels covered per unit of the quad is the projected render scale
+	const float Distance = FMath::Max(1.f, FVector::Dist(PlayerController->PlayerCameraManager->GetCameraLocation(), GetComponentLocation()));
+	const FVector WorldScale = GetComponentScale();
+	const float UnitsPerPixel = FMath::Max(FMath::Abs(WorldScale.Y), FMath::Abs(WorldScale.Z));
+	return UnitsPerPixel * ViewportSizeX / (2.f * Distance * FMath::Tan(HalfFOVRadians));
+}
+
+void UScalableWidgetComponent::UpdateAutoRenderScale()
+{
+	if (Space != EWidgetSpace::World || RenderScaleTiers.Num() == 0 || !IsVisible())
+	{
+		return;
+	}
+
+	const float ProjectedScale = GetProjectedRenderScale();
+	if (ProjectedScale < 0.f)
+	{
+		return;
+	}
+
+	// Return the smallest tier covering the scale, or the largest tier if none does
+	auto FindTier = [this](float Scale)
+	{
+		float BestTier = -1.f, MaxTier = -1.f;
+		for (const float Tier : RenderScaleTiers)
 		{
-			MarkRenderStateDirty();
+			MaxTier = FMath::Max(MaxTier, Tier);
+			if (Tier >= Scale && (BestTier < 0.f || Tier < BestTier))
+			{
+				BestTier = Tier;
+			}
 		}
+		return BestTier >= 0.f ? BestTier : MaxTier;
+	};
+
+	// Increase resolution right away but only decrease it once clearly below the next tier
+	const float UpTier = FindTier(ProjectedScale);
+	if (UpTier > RenderScale)
+	{
+		SetRenderScale(UpTier);
+		return;
+	}
+
+	const float DownTier = FindTier(ProjectedScale * (1.f + RenderScaleHysteresis));
+	if (DownTier < RenderScale && DownTier > 0.f)
+	{
+		SetRenderScale(DownTier);
 	}
 }
 
@@ -27,7 +132,74 @@ void UScalableWidgetComponent::UpdateRenderTarget(FIntPoint DesiredRenderTargetS
 {
 	// This depends on an engine modification (fix) to work correctly
 	// See https://github.com/greisane/UnrealEngine/commit/dd0cee91f4c54225f054283c36127c1c213c8f07
-	Super::UpdateRenderTarget(FIntPoint(DesiredRenderTargetSize.X * RenderScale, DesiredRenderTargetSize.Y * RenderScale));
+	const FIntPoint ScaledRenderTargetSize(DesiredRenderTargetSize.X * RenderScale, DesiredRenderTargetSize.Y * RenderScale);
+
+	if (UpdateAtlasSlot(ScaledRenderTargetSize))
+	{
+		return;
+	}
+
+	Super::UpdateRenderTarget(ScaledRenderTargetSize);
+}
+
+bool UScalableWidgetComponent::UpdateAtlasSlot(FIntPoint DesiredSize)
+{
+	UWidgetAtlasSubsystem* Atlas = (bUseRenderTargetAtlas && Space == EWidgetSpace::World) ? UWidgetAtlasSubsystem::Get(this) : nullptr;
+	if (Atlas == nullptr || DesiredSize.X <= 0 || DesiredSize.Y <= 0)
+	{
+		ReleaseAtlasSlot();
+		return false;
+	}
+
+	// Reallocate if the widget outgrew the slot or shrunk enough to waste most of it
+	if (AtlasSlot.IsValid())
+	{
+		const FIntPoint SlotSize = AtlasSlot.Rect.Size();
+		if (DesiredSize.X > SlotSize.X || DesiredSize.Y > SlotSize.Y || (DesiredSize.X * 2 < SlotSize.X && DesiredSize.Y * 2 < SlotSize.Y))
+		{
+			ReleaseAtlasSlot();
+		}
+	}
+
+	if (!AtlasSlot.IsValid())
+	{
+		AtlasSlot = Atlas->AllocateSlot(DesiredSize);
+		if (!AtlasSlot.IsValid())
+		{
+			return false;
+		}
+	}
+
+	AtlasDrawSize = DesiredSize;
+	RenderTarget = Atlas->GetPageRenderTarget(AtlasSlot.PageIndex);
+
+	if (MaterialInstance)
+	{
+		const float PageSize = Atlas->GetPageSize();
+		UpdateMaterialInstanceParameters();
+		MaterialInstance->SetVectorParameterValue(AtlasUVRectParameterName, FLinearColor(
+			AtlasSlot.Rect.Min.X / PageSize,
+			AtlasSlot.Rect.Min.Y / PageSize,
+			AtlasDrawSize.X / PageSize,
+			AtlasDrawSize.Y / PageSize));
+	}
+
+	return true;
+}
+
+void UScalableWidgetComponent::ReleaseAtlasSlot()
+{
+	if (AtlasSlot.IsValid())
+	{
+		// The shared render target must not be resized as if it were our own
+		RenderTarget = nullptr;
+
+		if (UWidgetAtlasSubsystem* Atlas = UWidgetAtlasSubsystem::Get(this))
+		{
+			Atlas->ReleaseSlot(AtlasSlot);
+		}
+		AtlasSlot = FWidgetAtlasSlot();
+	}
 }
 
 bool UScalableWidgetComponent::UpdateDrawSize()
@@ -69,6 +241,11 @@ bool UScalableWidgetComponent::UpdateDrawSize()
 	return true;
 }
 
+bool UScalableWidgetComponent::ShouldDrawWidget() const
+{
+	return Super::ShouldDrawWidget() && RedrawPolicy.CanRedraw(*this, bRedrawRequested, LastWidgetRenderTime, GetCurrentTime());
+}
+
 void UScalableWidgetComponent::DrawWidgetToRenderTarget(float DeltaTime)
 {
 	const FIntPoint PreviousDrawSize = CurrentDrawSize;
@@ -87,11 +264,37 @@ void UScalableWidgetComponent::DrawWidgetToRenderTarget(float DeltaTime)
 	UpdateRenderTarget(CurrentDrawSize);
 
 	// The render target could be null if the current draw size is zero
-	if (RenderTarget)
+	if (RenderTarget && AtlasSlot.IsValid())
+	{
+		bRedrawRequested = false;
+
+		// Only clear and draw our own region, the rest of the page belongs to other widgets
+		if (UWidgetAtlasSubsystem* Atlas = UWidgetAtlasSubsystem::Get(this))
+		{
+			Atlas->ClearSlot(AtlasSlot);
+		}
+
+		const FVector2D SlotOffset(AtlasSlot.Rect.Min);
+		const FVector2D SlotDrawSize(AtlasDrawSize);
+		const FGeometry WindowGeometry = FGeometry::MakeRoot(SlotDrawSize * (1.f / RenderScale), FSlateLayoutTransform(RenderScale, SlotOffset));
+
+		WidgetRenderer->SetShouldClearTarget(false);
+		WidgetRenderer->DrawWindow(
+			RenderTarget->GameThread_GetRenderTargetResource(),
+			SlateWindow->GetHittestGrid(),
+			SlateWindow.ToSharedRef(),
+			WindowGeometry,
+			FSlateRect(SlotOffset, SlotOffset + SlotDrawSize),
+			DeltaTime);
+
+		LastWidgetRenderTime = GetCurrentTime();
+	}
+	else if (RenderTarget)
 	{
 		bRedrawRequested = false;
 
 		// greisane: Render at render target size instead of CurrentDrawSize
+		WidgetRenderer->SetShouldClearTarget(true);
 		WidgetRenderer->DrawWindow(
 			RenderTarget,
 			SlateWindow->GetHittestGrid(),
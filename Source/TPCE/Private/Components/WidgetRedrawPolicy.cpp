@@ -0,0 +1,69 @@
+// This source code is licensed under the MIT license found in the LICENSE file in the root directory of this source tree.
+
+#include "Components/WidgetRedrawPolicy.h"
+
+#include "Components/WidgetComponent.h"
+#include "Blueprint/UserWidget.h"
+#include "Engine/LocalPlayer.h"
+#include "Engine/World.h"
+#include "GameFramework/PlayerController.h"
+#include "Camera/PlayerCameraManager.h"
+
+bool FWidgetRedrawPolicy::CanRedraw(const UWidgetComponent& Component, bool bRedrawRequested, double LastRedrawTime, double CurrentTime) const
+{
+	// Always allow the first draw
+	if (LastRedrawTime <= 0.0)
+	{
+		return true;
+	}
+
+	if (bRedrawOnInvalidationOnly && !bRedrawRequested)
+	{
+		const UUserWidget* Widget = Component.GetUserWidgetObject();
+		if (Widget == nullptr || !Widget->IsAnyAnimationPlaying())
+		{
+			return false;
+		}
+	}
+
+	const float MaxRedrawRate = GetMaxRedrawRate(Component);
+	if (MaxRedrawRate < 0.f)
+	{
+		return true;
+	}
+
+	// A pending redraw request is kept until the widget is close enough to redraw
+	return MaxRedrawRate > 0.f && CurrentTime - LastRedrawTime >= 1.f / MaxRedrawRate;
+}
+
+float FWidgetRedrawPolicy::GetMaxRedrawRate(const UWidgetComponent& Component) const
+{
+	if (DistanceRedrawRates.Num() == 0)
+	{
+		return -1.f;
+	}
+
+	UWorld* World = Component.GetWorld();
+	const ULocalPlayer* LocalPlayer = Component.GetOwnerPlayer();
+	const APlayerController* PlayerController = LocalPlayer ? LocalPlayer->GetPlayerController(World) : World->GetFirstPlayerController();
+	if (PlayerController == nullptr || PlayerController->PlayerCameraManager == nullptr)
+	{
+		return -1.f;
+	}
+
+	const float DistanceSqr = FVector::DistSquared(PlayerController->PlayerCameraManager->GetCameraLocation(), Component.GetComponentLocation());
+
+	// Use the rate of the closest distance band containing the component
+	float MaxRedrawRate = 0.f;
+	float BandDistance = BIG_NUMBER;
+	for (const FWidgetRedrawRate& Rate : DistanceRedrawRates)
+	{
+		if (DistanceSqr <= FMath::Square(Rate.MaxDistance) && Rate.MaxDistance < BandDistance)
+		{
+			MaxRedrawRate = Rate.MaxRedrawRate;
+			BandDistance = Rate.MaxDistance;
+		}
+	}
+
+	return MaxRedrawRate;
+}
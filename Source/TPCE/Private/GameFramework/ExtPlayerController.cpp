@@ -3,6 +3,7 @@
 #include "GameFramework/ExtPlayerController.h"
 
 #include "Engine/LocalPlayer.h"
+#include "Application/InputLatencyTracker.h"
 #include "GameFramework/Pawn.h"
 #include "Camera/CameraActor.h"
 #include "Camera/CameraComponent.h"
@@ -28,6 +29,9 @@ AExtPlayerController::AExtPlayerController(const FObjectInitializer& ObjectIniti
 	AutoManagedCameraTransitionParams.BlendTime = 1.0f;
 	AutoManagedCameraTransitionParams.BlendFunction = EViewTargetBlendFunction::VTBlend_Cubic;
 	AutoManagedCameraTransitionParams.BlendExp = 2.0f;
+
+	DescribedInputDevices = 0;
+	bInputBindingDescriptionsDirty = true;
 }
 
 void AExtPlayerController::SetupInputComponent()
@@ -146,6 +150,7 @@ void AExtPlayerController::PushInputComponent(UInputComponent* InInputComponent)
 
 	if (InInputComponent)
 	{
+		InvalidateInputBindingDescriptions();
 		OnInputStackChanged.Broadcast();
 	}
 }
@@ -154,6 +159,7 @@ bool AExtPlayerController::PopInputComponent(UInputComponent* InInputComponent)
 {
 	if (Super::PopInputComponent(InInputComponent))
 	{
+		InvalidateInputBindingDescriptions();
 		OnInputStackChanged.Broadcast();
 		return true;
 	}
@@ -182,11 +188,63 @@ EPlayerControllerInputDevices AExtPlayerController::GetKeyInputDevices(FKey Key)
 
 void AExtPlayerController::GetInputBindingDescriptions(TArray<FInputBindingDescription>& OutInputBindingDescriptions)
 {
-	OutInputBindingDescriptions.Empty();
+	OutInputBindingDescriptions = GetCachedInputBindingDescriptions();
+}
+
+bool AExtPlayerController::GetInputBindingDescriptionForAction(FName ActionName, FInputBindingDescription& OutInputBindingDescription)
+{
+	UpdateInputBindingDescriptions();
+
+	if (const int32* Index = InputBindingDescriptionIndices.Find(ActionName))
+	{
+		OutInputBindingDescription = InputBindingDescriptions[*Index];
+		return true;
+	}
+
+	return false;
+}
+
+void AExtPlayerController::InvalidateInputBindingDescriptions()
+{
+	bInputBindingDescriptionsDirty = true;
+}
+
+const TArray<FInputBindingDescription>& AExtPlayerController::GetCachedInputBindingDescriptions()
+{
+	UpdateInputBindingDescriptions();
+
+	return InputBindingDescriptions;
+}
+
+void AExtPlayerController::UpdateInputBindingDescriptions()
+{
+	// The pawn input component is part of the stack without being pushed, and is created after possession
+	const APawn* ControlledPawn = GetPawnOrSpectator();
+	UInputComponent* PawnInputComponent = ControlledPawn ? ControlledPawn->InputComponent : nullptr;
+
+	if (!bInputBindingDescriptionsDirty && DescribedInputDevices == InputDevices && DescribedPawnInputComponent.Get() == PawnInputComponent)
+	{
+		return;
+	}
+
+	bInputBindingDescriptionsDirty = false;
+	DescribedInputDevices = InputDevices;
+	DescribedPawnInputComponent = PawnInputComponent;
+
+	InputBindingDescriptions.Reset();
+	InputBindingDescriptionIndices.Reset();
+
+	if (PlayerInput == nullptr)
+	{
+		return;
+	}
 
 	TArray<UInputComponent*> InputComponentStack;
 	BuildInputStack(InputComponentStack);
 
+	// Descriptions by text hash, texts that collide are told apart by comparing them
+	TMultiMap<uint32, int32> TextHashIndices;
+
 	// Walk the stack, top to bottom
 	int32 StackIndex = InputComponentStack.Num() - 1;
 	for (; StackIndex >= 0; --StackIndex)
@@ -199,27 +257,49 @@ void AExtPlayerController::GetInputBindingDescriptions(TArray<FInputBindingDescr
 			{
 				FText Text;
 				const FInputActionBinding& ActionBinding = ExtInputComponent->GetActionBinding(ActionBindingIndex);
-				if (ExtInputComponent->GetActionBindingDescriptionForHandle(ActionBinding.GetHandle(), Text))
+				if (!ExtInputComponent->GetActionBindingDescriptionForHandle(ActionBinding.GetHandle(), Text))
 				{
-					const TArray<FInputActionKeyMapping>& KeysForAction = PlayerInput->GetKeysForAction(ActionBinding.GetActionName());
-					for (const FInputActionKeyMapping& KeyMapping : KeysForAction)
+					continue;
+				}
+
+				// Find the element with the same description, added when the first key mapping passes the device filter
+				const uint32 TextHash = GetTypeHash(Text.ToString());
+				int32 DescriptionIndex = INDEX_NONE;
+
+				const TArray<FInputActionKeyMapping>& KeysForAction = PlayerInput->GetKeysForAction(ActionBinding.GetActionName());
+				for (const FInputActionKeyMapping& KeyMapping : KeysForAction)
+				{
+					if (!EnumHasAnyFlags(GetKeyInputDevices(KeyMapping.Key), (EPlayerControllerInputDevices)InputDevices))
+					{
+						continue;
+					}
+
+					if (DescriptionIndex == INDEX_NONE)
 					{
-						if (EnumHasAnyFlags(GetKeyInputDevices(KeyMapping.Key), (EPlayerControllerInputDevices)InputDevices))
+						for (auto It = TextHashIndices.CreateConstKeyIterator(TextHash); It; ++It)
 						{
-							// Find an element with the same description or add a new one
-							FInputBindingDescription* InputBindingDescription = OutInputBindingDescriptions.FindByPredicate([&](FInputBindingDescription El)
-								{
-									return El.Text.EqualTo(Text);
-								});
-							if (!InputBindingDescription)
+							if (InputBindingDescriptions[It.Value()].Text.EqualTo(Text))
 							{
-								InputBindingDescription = &OutInputBindingDescriptions.Emplace_GetRef();
+								DescriptionIndex = It.Value();
+								break;
 							}
+						}
 
-							InputBindingDescription->Text = Text;
-							InputBindingDescription->KeyMappings.Add(KeyMapping);
+						if (DescriptionIndex == INDEX_NONE)
+						{
+							DescriptionIndex = InputBindingDescriptions.Num();
+							InputBindingDescriptions.Emplace_GetRef().Text = Text;
+							TextHashIndices.Add(TextHash, DescriptionIndex);
+						}
+
+						// Bindings higher in the stack take precedence
+						if (!InputBindingDescriptionIndices.Contains(ActionBinding.GetActionName()))
+						{
+							InputBindingDescriptionIndices.Add(ActionBinding.GetActionName(), DescriptionIndex);
 						}
 					}
+
+					InputBindingDescriptions[DescriptionIndex].KeyMappings.Add(KeyMapping);
 				}
 			}
 		}
@@ -285,6 +365,11 @@ void AExtPlayerController::PostProcessInput(const float DeltaTime, const bool bG
 		PawnControl->ProcessInput(DeltaTime, bGamePaused);
 	}
 
+	if (IsLocalController())
+	{
+		MARK_INPUT_LATENCY(ProcessInput);
+	}
+
 	Super::PostProcessInput(DeltaTime, bGamePaused);
 }
 
@@ -4,6 +4,7 @@
 
 #include "Components/PushToTargetComponent.h"
 #include "Curves/CurveLinearColor.h"
+#include "GameFramework/FloaterAnimationSubsystem.h"
 #include "UObject/ConstructorHelpers.h"
 
 FName AFloaterActor::PushToTargetName(TEXT("PushToTarget"));
@@ -26,52 +27,22 @@ AFloaterActor::AFloaterActor()
 	PushToTarget->bStayUpright = false;
 	PushToTarget->bForceSubStepping = false;
 
-	PrimaryActorTick.bCanEverTick = true;
-	PrimaryActorTick.bStartWithTickEnabled = false;
-	PrimaryActorTick.bTickEvenWhenPaused = false;
+	// Animations are played by UFloaterAnimationSubsystem
+	PrimaryActorTick.bCanEverTick = false;
 }
 
 void AFloaterActor::BeginPlay()
 {
-	if (PopUpCurve && PopInCurve)
-	{
-		FOnTimelineLinearColorStatic OnTimelineProgressDelegate;
-		OnTimelineProgressDelegate.BindUObject(this, &AFloaterActor::OnTimelineProgress);
-		FOnTimelineEventStatic OnTimelineFinishedDelegate;
-		OnTimelineFinishedDelegate.BindUObject(this, &AFloaterActor::OnTimelineFinished);
-		float MinTime, MaxTime;
-
-		PopUpTimeline.AddInterpLinearColor(PopUpCurve, OnTimelineProgressDelegate);
-		PopUpCurve->GetTimeRange(MinTime, MaxTime);
-		PopUpTimeline.SetTimelineLength(MaxTime);
-		PopUpTimeline.SetTimelineLengthMode(ETimelineLengthMode::TL_TimelineLength);
-		PopUpTimeline.SetTimelineFinishedFunc(OnTimelineFinishedDelegate);
-		PopUpTimeline.SetLooping(false);
-
-		PopInTimeline.AddInterpLinearColor(PopInCurve, OnTimelineProgressDelegate);
-		PopInCurve->GetTimeRange(MinTime, MaxTime);
-		PopInTimeline.SetTimelineLength(MaxTime);
-		PopInTimeline.SetTimelineLengthMode(ETimelineLengthMode::TL_TimelineLength);
-		PopInTimeline.SetTimelineFinishedFunc(OnTimelineFinishedDelegate);
-		PopInTimeline.SetLooping(false);
-	}
-
 	ShowState = IsHidden() ? EFloaterShowState::Hidden : EFloaterShowState::Shown;
-	if (ShowState == EFloaterShowState::Shown)
-	{
-		SetActorTickEnabled(true);
-	}
 
 	Super::BeginPlay();
 }
 
-void AFloaterActor::Tick(float DeltaTime)
+void AFloaterActor::EndPlay(const EEndPlayReason::Type EndPlayReason)
 {
-	Super::Tick(DeltaTime);
+	StopAnimation();
 
-	// Update scale
-	PopUpTimeline.TickTimeline(DeltaTime);
-	PopInTimeline.TickTimeline(DeltaTime);
+	Super::EndPlay(EndPlayReason);
 }
 
 void AFloaterActor::SetActorHiddenInGame(bool bNewHidden)
@@ -80,8 +51,7 @@ void AFloaterActor::SetActorHiddenInGame(bool bNewHidden)
 
 	if (bNewHidden && ShowState != EFloaterShowState::Hidden)
 	{
-		PopUpTimeline.Stop();
-		PopInTimeline.Stop();
+		StopAnimation();
 		ShowState = EFloaterShowState::Hidden;
 	}
 	else if (!bNewHidden && ShowState != EFloaterShowState::Showing)
@@ -100,18 +70,14 @@ void AFloaterActor::Show()
 		SetActorRelativeScale3D(FVector::ZeroVector);
 
 		ShowState = EFloaterShowState::Showing;
-		PopUpTimeline.SetPlayRate(AnimationRate);
-		PopUpTimeline.PlayFromStart();
-
-		SetActorTickEnabled(true);
 		SetActorHiddenInGame(false);
+		PlayAnimation(PopUpCurve, false);
 	}
 	else if (ShowState == EFloaterShowState::Hiding)
 	{
 		// Undo current progress
 		ShowState = EFloaterShowState::Showing;
-		PopInTimeline.SetPlayRate(AnimationRate);
-		PopInTimeline.Reverse();
+		PlayAnimation(PopInCurve, true);
 	}
 }
 
@@ -121,25 +87,53 @@ void AFloaterActor::Hide()
 	{
 		// Resume playing the rest of the curve
 		ShowState = EFloaterShowState::Hiding;
-		PopInTimeline.SetPlayRate(AnimationRate);
-		PopInTimeline.PlayFromStart();
+		PlayAnimation(PopInCurve, false);
 	}
 	else if (ShowState == EFloaterShowState::Showing)
 	{
 		// Undo current progress
 		ShowState = EFloaterShowState::Hiding;
-		PopUpTimeline.SetPlayRate(AnimationRate);
-		PopUpTimeline.Reverse();
+		PlayAnimation(PopUpCurve, true);
+	}
+}
+
+void AFloaterActor::PlayAnimation(UCurveLinearColor* Curve, bool bReverse)
+{
+	UFloaterAnimationSubsystem* AnimationSubsystem = UFloaterAnimationSubsystem::Get(this);
+	if (AnimationSubsystem && AnimationSubsystem->Play(this, Curve, AnimationRate, bReverse))
+	{
+		return;
+	}
+
+	// Nothing to play, jump to the end
+	if (Curve)
+	{
+		float MinTime, MaxTime;
+		Curve->GetTimeRange(MinTime, MaxTime);
+		ApplyAnimationValue(Curve->GetLinearColorValue(bReverse ? 0.f : MaxTime));
+	}
+	else if (ShowState == EFloaterShowState::Showing)
+	{
+		ApplyAnimationValue(FLinearColor(1.f, 1.f, 1.f, 0.f));
+	}
+	OnAnimationFinished();
+}
+
+void AFloaterActor::StopAnimation()
+{
+	if (UFloaterAnimationSubsystem* AnimationSubsystem = UFloaterAnimationSubsystem::Get(this))
+	{
+		AnimationSubsystem->Stop(this);
 	}
 }
 
-void AFloaterActor::OnTimelineProgress(FLinearColor Value)
+void AFloaterActor::ApplyAnimationValue(const FLinearColor& Value)
 {
 	SetActorRelativeScale3D(FVector(Value));
 	PushToTarget->WorldOffset.Z = Value.A;
 }
 
-void AFloaterActor::OnTimelineFinished()
+void AFloaterActor::OnAnimationFinished()
 {
 	if (ShowState == EFloaterShowState::Showing)
 	{
@@ -150,7 +144,6 @@ void AFloaterActor::OnTimelineFinished()
 		// Finished hiding
 		ShowState = EFloaterShowState::Hidden;
 
-		SetActorTickEnabled(false);
 		SetActorHiddenInGame(true);
 	}
 }
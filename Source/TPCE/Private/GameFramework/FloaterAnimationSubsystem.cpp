@@ -0,0 +1,208 @@
+// This source code is licensed under the MIT license found in the LICENSE file in the root directory of this source tree.
+
+#include "GameFramework/FloaterAnimationSubsystem.h"
+
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+#include "Curves/CurveLinearColor.h"
+#include "GameFramework/FloaterActor.h"
+#include "HAL/IConsoleManager.h"
+
+DECLARE_CYCLE_STAT(TEXT("FloaterAnimationSubsystem Tick"), STAT_FloaterAnimationSubsystem_Tick, STATGROUP_Game);
+
+static TAutoConsoleVariable<float> CVarFloaterCurveSampleRate(TEXT("ui.Floater.CurveSampleRate"), 60.f, TEXT("Samples per second used to bake floater animation curves. Applied when a world is initialized."));
+
+void UFloaterAnimationSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	SampleRate = FMath::Max(1.f, CVarFloaterCurveSampleRate.GetValueOnGameThread());
+}
+
+void UFloaterAnimationSubsystem::Deinitialize()
+{
+	BakedCurves.Empty();
+	BakedCurveLookup.Empty();
+	Floaters.Empty();
+	FloaterKeys.Empty();
+	CurveIndices.Empty();
+	Times.Empty();
+	PlayRates.Empty();
+	Values.Empty();
+	AnimationLookup.Empty();
+
+	Super::Deinitialize();
+}
+
+UFloaterAnimationSubsystem* UFloaterAnimationSubsystem::Get(const UObject* WorldContextObject)
+{
+	const UWorld* World = GEngine ? GEngine->GetWorldFromContextObject(WorldContextObject, EGetWorldErrorMode::ReturnNull) : nullptr;
+	return World ? World->GetSubsystem<UFloaterAnimationSubsystem>() : nullptr;
+}
+
+ETickableTickType UFloaterAnimationSubsystem::GetTickableTickType() const
+{
+	return HasAnyFlags(RF_ClassDefaultObject) ? ETickableTickType::Never : ETickableTickType::Conditional;
+}
+
+bool UFloaterAnimationSubsystem::IsTickable() const
+{
+	return Floaters.Num() > 0;
+}
+
+TStatId UFloaterAnimationSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UFloaterAnimationSubsystem, STATGROUP_Tickables);
+}
+
+void UFloaterAnimationSubsystem::Tick(float DeltaTime)
+{
+	SCOPE_CYCLE_COUNTER(STAT_FloaterAnimationSubsystem_Tick);
+
+	const int32 NumAnimations = Floaters.Num();
+	TArray<int32, TInlineAllocator<16>> FinishedIndices;
+
+	// Advance and sample all animations
+	for (int32 Index = 0; Index < NumAnimations; ++Index)
+	{
+		const FBakedCurve& BakedCurve = BakedCurves[CurveIndices[Index]];
+		const float Time = FMath::Clamp(Times[Index] + DeltaTime * PlayRates[Index], 0.f, BakedCurve.Duration);
+		Times[Index] = Time;
+		Values[Index] = SampleCurve(BakedCurve, Time);
+
+		if (PlayRates[Index] >= 0.f ? Time >= BakedCurve.Duration : Time <= 0.f)
+		{
+			FinishedIndices.Add(Index);
+		}
+	}
+
+	// Apply results
+	for (int32 Index = 0; Index < NumAnimations; ++Index)
+	{
+		if (AFloaterActor* Floater = Floaters[Index].Get())
+		{
+			Floater->ApplyAnimationValue(Values[Index]);
+		}
+		else
+		{
+			FinishedIndices.AddUnique(Index);
+		}
+	}
+
+	if (FinishedIndices.Num() > 0)
+	{
+		// Remove all finished animations before notifying since floaters may start new ones
+		TArray<AFloaterActor*, TInlineAllocator<16>> FinishedFloaters;
+		FinishedIndices.Sort(TGreater<int32>());
+		for (const int32 Index : FinishedIndices)
+		{
+			if (AFloaterActor* Floater = Floaters[Index].Get())
+			{
+				FinishedFloaters.Add(Floater);
+			}
+			RemoveAnimation(Index);
+		}
+
+		for (AFloaterActor* Floater : FinishedFloaters)
+		{
+			Floater->OnAnimationFinished();
+		}
+	}
+}
+
+bool UFloaterAnimationSubsystem::Play(AFloaterActor* Floater, const UCurveLinearColor* Curve, float PlayRate, bool bReverse)
+{
+	if (Floater == nullptr || Curve == nullptr)
+	{
+		return false;
+	}
+
+	const int32 CurveIndex = FindOrBakeCurve(Curve);
+	const float Rate = FMath::Abs(PlayRate) * (bReverse ? -1.f : 1.f);
+
+	if (const int32* ExistingIndex = AnimationLookup.Find(Floater))
+	{
+		const int32 Index = *ExistingIndex;
+		if (!bReverse || CurveIndices[Index] != CurveIndex)
+		{
+			Times[Index] = bReverse ? BakedCurves[CurveIndex].Duration : 0.f;
+		}
+		CurveIndices[Index] = CurveIndex;
+		PlayRates[Index] = Rate;
+		return true;
+	}
+
+	const int32 Index = Floaters.Add(Floater);
+	FloaterKeys.Add(Floater);
+	CurveIndices.Add(CurveIndex);
+	Times.Add(bReverse ? BakedCurves[CurveIndex].Duration : 0.f);
+	PlayRates.Add(Rate);
+	Values.Add(FLinearColor::Black);
+	AnimationLookup.Add(Floater, Index);
+	return true;
+}
+
+void UFloaterAnimationSubsystem::Stop(AFloaterActor* Floater)
+{
+	if (const int32* Index = AnimationLookup.Find(Floater))
+	{
+		RemoveAnimation(*Index);
+	}
+}
+
+int32 UFloaterAnimationSubsystem::FindOrBakeCurve(const UCurveLinearColor* Curve)
+{
+	check(Curve);
+
+	if (const int32* CurveIndex = BakedCurveLookup.Find(Curve))
+	{
+		return *CurveIndex;
+	}
+
+	// Timelines play from zero to the end of the curve, so bake the same range
+	float MinTime, MaxTime;
+	Curve->GetTimeRange(MinTime, MaxTime);
+
+	FBakedCurve& BakedCurve = BakedCurves.AddDefaulted_GetRef();
+	BakedCurve.Duration = FMath::Max(0.f, MaxTime);
+
+	const int32 NumSamples = FMath::Max(2, FMath::CeilToInt(BakedCurve.Duration * SampleRate) + 1);
+	BakedCurve.Samples.SetNumUninitialized(NumSamples);
+	for (int32 SampleIndex = 0; SampleIndex < NumSamples; ++SampleIndex)
+	{
+		BakedCurve.Samples[SampleIndex] = Curve->GetLinearColorValue(BakedCurve.Duration * SampleIndex / (NumSamples - 1));
+	}
+
+	return BakedCurveLookup.Add(Curve, BakedCurves.Num() - 1);
+}
+
+FLinearColor UFloaterAnimationSubsystem::SampleCurve(const FBakedCurve& BakedCurve, float Time) const
+{
+	if (BakedCurve.Duration <= 0.f)
+	{
+		return BakedCurve.Samples.Last();
+	}
+
+	const float SamplePosition = Time / BakedCurve.Duration * (BakedCurve.Samples.Num() - 1);
+	const int32 SampleIndex = FMath::Clamp(FMath::FloorToInt(SamplePosition), 0, BakedCurve.Samples.Num() - 2);
+	const float Alpha = FMath::Clamp(SamplePosition - SampleIndex, 0.f, 1.f);
+	return FMath::Lerp(BakedCurve.Samples[SampleIndex], BakedCurve.Samples[SampleIndex + 1], Alpha);
+}
+
+void UFloaterAnimationSubsystem::RemoveAnimation(int32 Index)
+{
+	AnimationLookup.Remove(FloaterKeys[Index]);
+
+	const int32 LastIndex = Floaters.Num() - 1;
+	if (Index != LastIndex)
+	{
+		AnimationLookup.Add(FloaterKeys[LastIndex], Index);
+	}
+
+	Floaters.RemoveAtSwap(Index, 1, false);
+	FloaterKeys.RemoveAtSwap(Index, 1, false);
+	CurveIndices.RemoveAtSwap(Index, 1, false);
+	Times.RemoveAtSwap(Index, 1, false);
+	PlayRates.RemoveAtSwap(Index, 1, false);
+	Values.RemoveAtSwap(Index, 1, false);
+}
@@ -46,6 +46,7 @@ void UAIJob::BeginDestroy()
 void UAIJob::BeginJob()
 {
 	check(JobsComponent);
+	SCOPE_AIJOB_STAT(JobStats, EAIJobStat::BeginJob);
 
 	if (bActive)
 	{
@@ -57,7 +58,10 @@ void UAIJob::BeginJob()
 	TimeBecameActive = GetWorld()->GetTimeSeconds();
 
 	OnBeginJob();
-	ReceiveBeginJob();
+	{
+		SCOPE_AIJOB_BLUEPRINT_STAT(JobStats, EAIJobStat::BeginJob);
+		ReceiveBeginJob();
+	}
 }
 
 void UAIJob::FinishJob()
@@ -74,8 +78,13 @@ void UAIJob::FinishJob()
 		return;
 	}
 
+	SCOPE_AIJOB_STAT(JobStats, EAIJobStat::EndJob);
+
 	OnEndJob();
-	ReceiveEndJob();
+	{
+		SCOPE_AIJOB_BLUEPRINT_STAT(JobStats, EAIJobStat::EndJob);
+		ReceiveEndJob();
+	}
 
 	bActive = false;
 	TimeBecameInactive = GetWorld()->GetTimeSeconds();
@@ -83,6 +92,8 @@ void UAIJob::FinishJob()
 
 void UAIJob::Tick(float DeltaSeconds)
 {
+	SCOPE_AIJOB_STAT(JobStats, EAIJobStat::Tick);
+	SCOPE_AIJOB_BLUEPRINT_STAT(JobStats, EAIJobStat::Tick);
 	ReceiveTick(DeltaSeconds);
 }
 
@@ -122,6 +133,7 @@ FString UAIJob::GetJobName() const
 float UAIJob::ScoreJob() const
 {
 	check(JobsComponent);
+	SCOPE_AIJOB_STAT(JobStats, EAIJobStat::Score);
 
 	if (bActive && RunningTimeLimit > 0.f && GetJobTimeActive() > RunningTimeLimit)
 	{
@@ -129,6 +141,7 @@ float UAIJob::ScoreJob() const
 		return 0.f;
 	}
 
+	SCOPE_AIJOB_BLUEPRINT_STAT(JobStats, EAIJobStat::Score);
 	return ReceiveScoreJob();
 }
 
@@ -0,0 +1,41 @@
+// This source code is licensed under the MIT license found in the LICENSE file in the root directory of this source tree.
+
+#include "Jobs/AIJobStats.h"
+
+void FAIJobStats::Reset()
+{
+	for (FAIJobStatEntry& Entry : Entries)
+	{
+		Entry.Reset();
+	}
+}
+
+const TCHAR* FAIJobStats::GetStatName(EAIJobStat::Type Stat)
+{
+	static const TCHAR* Names[] = { TEXT("Score"), TEXT("Tick"), TEXT("BeginJob"), TEXT("EndJob") };
+	static_assert(UE_ARRAY_COUNT(Names) == EAIJobStat::Num, "Stat names out of sync with EAIJobStat");
+	return (Stat >= 0 && Stat < EAIJobStat::Num) ? Names[Stat] : TEXT("Invalid");
+}
+
+FString FAIJobStats::GetCSVHeader()
+{
+	return TEXT("Owner,Job,Stat,Count,TotalMs,AverageMs,MaxMs,NativeMs,BlueprintMs\n");
+}
+
+void FAIJobStats::AppendCSV(const FString& OwnerName, const FString& JobName, FString& Out) const
+{
+	for (int32 StatIndex = 0; StatIndex < EAIJobStat::Num; ++StatIndex)
+	{
+		const FAIJobStatEntry& Entry = Entries[StatIndex];
+		Out += FString::Printf(TEXT("%s,%s,%s,%d,%.4f,%.4f,%.4f,%.4f,%.4f\n"),
+			*OwnerName,
+			*JobName,
+			GetStatName((EAIJobStat::Type)StatIndex),
+			Entry.Count,
+			Entry.TotalSeconds * 1000.0,
+			Entry.GetAverageSeconds() * 1000.0,
+			Entry.MaxSeconds * 1000.0,
+			Entry.GetNativeSeconds() * 1000.0,
+			Entry.BlueprintSeconds * 1000.0);
+	}
+}
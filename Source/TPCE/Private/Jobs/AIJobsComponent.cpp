@@ -5,6 +5,11 @@
 #include "Engine/Engine.h"
 #include "Engine/World.h"
 #include "TimerManager.h"
+#include "UObject/UObjectIterator.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/DateTime.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
 #include "AIController.h"
 #include "GameFramework/ExtAIController.h"
 #include "Jobs/AIJob.h"
@@ -16,6 +21,56 @@
 
 DEFINE_LOG_CATEGORY(LogAIJobs);
 
+#if WITH_AIJOB_STATS
+
+namespace AIJobStats
+{
+	void ForEachJobsComponent(UWorld* World, TFunctionRef<void(UAIJobsComponent&)> Func)
+	{
+		for (TObjectIterator<UAIJobsComponent> It; It; ++It)
+		{
+			if (It->GetWorld() == World && !It->IsTemplate() && !It->IsPendingKill())
+			{
+				Func(**It);
+			}
+		}
+	}
+
+	void DumpStatsCSV(const TArray<FString>& Args, UWorld* World)
+	{
+		FString CSV = FAIJobStats::GetCSVHeader();
+		ForEachJobsComponent(World, [&CSV](UAIJobsComponent& JobsComponent) { JobsComponent.AppendJobStatsCSV(CSV); });
+
+		const FString FileName = Args.Num() > 0 ? Args[0] : FString::Printf(TEXT("AIJobStats-%s.csv"), *FDateTime::Now().ToString());
+		const FString FilePath = FPaths::Combine(FPaths::ProfilingDir(), TEXT("AIJobs"), FileName);
+		if (FFileHelper::SaveStringToFile(CSV, *FilePath))
+		{
+			UE_LOG(LogAIJobs, Display, TEXT("Wrote AI job stats to %s"), *FilePath);
+		}
+		else
+		{
+			UE_LOG(LogAIJobs, Warning, TEXT("Failed to write AI job stats to %s"), *FilePath);
+		}
+	}
+
+	void ResetStats(const TArray<FString>& Args, UWorld* World)
+	{
+		ForEachJobsComponent(World, [](UAIJobsComponent& JobsComponent) { JobsComponent.ResetJobStats(); });
+	}
+
+	static FAutoConsoleCommandWithWorldAndArgs DumpStatsCSVCmd(
+		TEXT("ai.Jobs.DumpStatsCSV"),
+		TEXT("Write the timing of all AI jobs in the world to a CSV file in the profiling directory. Optional argument: file name."),
+		FConsoleCommandWithWorldAndArgsDelegate::CreateStatic(DumpStatsCSV));
+
+	static FAutoConsoleCommandWithWorldAndArgs ResetStatsCmd(
+		TEXT("ai.Jobs.ResetStats"),
+		TEXT("Clear the timing of all AI jobs in the world."),
+		FConsoleCommandWithWorldAndArgsDelegate::CreateStatic(ResetStats));
+}
+
+#endif // WITH_AIJOB_STATS
+
 UAIJobsComponent::UAIJobsComponent()
 	: UpdateInterval(.2f)
 {
@@ -145,6 +200,10 @@ bool UAIJobsComponent::RemoveJob(UAIJob* Job)
 
 void UAIJobsComponent::EvaluateJobs()
 {
+#if WITH_AIJOB_STATS
+	FAIJobScopedStat ScopedEvaluationStat(EvaluationStats, false);
+#endif // WITH_AIJOB_STATS
+
 	if (CurrentJob && !CurrentJob->IsActive() && CurrentJob->bRunOnce)
 	{
 		RemoveJob(CurrentJob);
@@ -184,6 +243,28 @@ void UAIJobsComponent::EvaluateJobs()
 	SetTimer(UpdateInterval);
 }
 
+#if WITH_AIJOB_STATS
+
+void UAIJobsComponent::ResetJobStats()
+{
+	EvaluationStats.Reset();
+	for (UAIJob* Job : AvailableJobs)
+	{
+		Job->ResetJobStats();
+	}
+}
+
+void UAIJobsComponent::AppendJobStatsCSV(FString& Out) const
+{
+	const FString OwnerName = GetNameSafe(GetOwner());
+	for (const UAIJob* Job : AvailableJobs)
+	{
+		Job->GetJobStats().AppendCSV(OwnerName, Job->GetJobName(), Out);
+	}
+}
+
+#endif // WITH_AIJOB_STATS
+
 #if WITH_GAMEPLAY_DEBUGGER
 
 void UAIJobsComponent::DescribeSelfToGameplayDebugger(FGameplayDebuggerCategory* DebuggerCategory) const
@@ -226,6 +307,44 @@ void UAIJobsComponent::DescribeSelfToGameplayDebugger(FGameplayDebuggerCategory*
 	{
 		DebuggerCategory->AddTextLine(TEXT("No active job."));
 	}
+
+#if WITH_AIJOB_STATS
+	DebuggerCategory->AddTextLine(TEXT("--"));
+	DebuggerCategory->AddTextLine(FString::Printf(TEXT("Evaluations: {yellow}%d{white}, Avg: {yellow}%.3fms{white}, Max: {yellow}%.3fms"),
+		EvaluationStats.Count, EvaluationStats.GetAverageSeconds() * 1000.0, EvaluationStats.MaxSeconds * 1000.0));
+
+	// Sort by total time so the most expensive jobs come first
+	SortedJobs.Sort([](const UAIJob& A, const UAIJob& B)
+		{
+			double TotalA = 0.0, TotalB = 0.0;
+			for (int32 StatIndex = 0; StatIndex < EAIJobStat::Num; ++StatIndex)
+			{
+				TotalA += A.GetJobStats().Entries[StatIndex].TotalSeconds;
+				TotalB += B.GetJobStats().Entries[StatIndex].TotalSeconds;
+			}
+			return TotalA > TotalB;
+		});
+
+	for (const UAIJob* Job : SortedJobs)
+	{
+		FString Description = FString::Printf(TEXT("%s:"), *Job->GetJobName());
+		const FAIJobStats& Stats = Job->GetJobStats();
+		for (int32 StatIndex = 0; StatIndex < EAIJobStat::Num; ++StatIndex)
+		{
+			const FAIJobStatEntry& Entry = Stats.Entries[StatIndex];
+			if (Entry.Count > 0)
+			{
+				Description += FString::Printf(TEXT(" %s {yellow}%.3f{white}/{orange}%.3fms{white} x%d (BP {yellow}%.0f%%{white})"),
+					FAIJobStats::GetStatName((EAIJobStat::Type)StatIndex),
+					Entry.GetAverageSeconds() * 1000.0,
+					Entry.MaxSeconds * 1000.0,
+					Entry.Count,
+					Entry.TotalSeconds > 0.0 ? 100.0 * Entry.BlueprintSeconds / Entry.TotalSeconds : 0.0);
+			}
+		}
+		DebuggerCategory->AddTextLine(Description);
+	}
+#endif // WITH_AIJOB_STATS
 }
 
 #endif // WITH_GAMEPLAY_DEBUGGER
@@ -5,6 +5,8 @@
 #include "Components/SkyLightComponent.h"
 #include "Engine/StaticMeshSocket.h"
 #include "Engine/Canvas.h"
+#include "CanvasItem.h"
+#include "Math/VectorRegister.h"
 
 UGameplayStaticsEx::UGameplayStaticsEx(const FObjectInitializer& ObjectInitializer)
 	: Super(ObjectInitializer)
@@ -54,164 +56,361 @@ void UGameplayStaticsEx::SetSourceCubemapAngle(USkyLightComponent* SkyLightCompo
 	SkyLightComponent->SetCaptureIsDirty();
 }
 
-void UGameplayStaticsEx::DrawPolyline(UCanvas* InCanvas, UMaterialInterface* RenderMaterial, const TArray<FVector2D>& Points, float Thickness, float UTiling)
+namespace PolylineMesh
 {
-	if (InCanvas && RenderMaterial && Points.Num() > 1)
+	// Below this many points the vectorized miter computation isn't worth the setup
+	const int32 MinPointsForVectorizedMiters = 32;
+
+	/** Offset of a polyline end point, perpendicular to its only segment. */
+	FVector2D GetEndOffset(const FVector2D& From, const FVector2D& To, float Thickness)
+	{
+		const FVector2D Direction = (To - From).GetSafeNormal();
+		return FVector2D(-Direction.Y, Direction.X) * Thickness;
+	}
+
+	void ComputeMiterOffsets(const TArray<FVector2D>& Points, float Thickness, FVector2D* OutOffsets)
+	{
+		const int32 NumPoints = Points.Num();
+		for (int32 PointIdx = 1; PointIdx < NumPoints - 1; PointIdx++)
+		{
+			// Compute miter join normal and length
+			const FVector2D DirectionA = (Points[PointIdx] - Points[PointIdx - 1]).GetSafeNormal();
+			const FVector2D DirectionB = (Points[PointIdx + 1] - Points[PointIdx]).GetSafeNormal();
+			const FVector2D Tangent = (DirectionA + DirectionB).GetSafeNormal();
+			const FVector2D Perp = FVector2D(-DirectionA.Y, DirectionA.X);
+			const FVector2D Miter = FVector2D(-Tangent.Y, Tangent.X);
+			OutOffsets[PointIdx] = Miter * (Thickness / FVector2D::DotProduct(Miter, Perp));
+		}
+	}
+
+	/** Normalize 2D vectors held in two registers, returning zero for degenerate vectors like GetSafeNormal. */
+	FORCEINLINE void VectorSafeNormal2D(VectorRegister& X, VectorRegister& Y)
+	{
+		const VectorRegister SizeSquared = VectorMultiplyAdd(Y, Y, VectorMultiply(X, X));
+		const VectorRegister Mask = VectorCompareGT(SizeSquared, VectorSetFloat1(SMALL_NUMBER));
+		const VectorRegister InvSize = VectorSelect(Mask, VectorReciprocalSqrtAccurate(SizeSquared), VectorZero());
+		X = VectorMultiply(X, InvSize);
+		Y = VectorMultiply(Y, InvSize);
+	}
+
+	/** Same as ComputeMiterOffsets, four corners at a time on transposed point data. */
+	void ComputeMiterOffsetsVectorized(const TArray<FVector2D>& Points, float Thickness, FVector2D* OutOffsets)
 	{
 		const int32 NumPoints = Points.Num();
+		const int32 NumSegments = NumPoints - 1;
+		const int32 PaddedNum = Align(NumPoints, 4) + 4;
+
+		// Zero padding lets the loops read past the end, results for padding lanes are discarded
+		TArray<float, TInlineAllocator<256>> Buffer;
+		Buffer.SetNumZeroed(PaddedNum * 4);
+		float* PointX = Buffer.GetData();
+		float* PointY = PointX + PaddedNum;
+		float* DirX = PointY + PaddedNum;
+		float* DirY = DirX + PaddedNum;
 
-		TArray<FVector2D> Offsets;
-		Offsets.Reserve(NumPoints);
 		for (int32 PointIdx = 0; PointIdx < NumPoints; PointIdx++)
 		{
-			FVector2D Direction;
-			float Length = Thickness;
-
-			if (PointIdx == 0)
-			{
-				// Starting point uses (next - current)
-				Direction = (Points[PointIdx + 1] - Points[PointIdx]).GetSafeNormal();
-			}
-			else if (PointIdx == NumPoints - 1)
-			{
-				// Ending point uses (current - previous)
-				Direction = (Points[PointIdx] - Points[PointIdx - 1]).GetSafeNormal();
-			}
-			else
-			{
-				// Compute miter join normal and length
-				const FVector2D DirectionA = (Points[PointIdx] - Points[PointIdx - 1]).GetSafeNormal();
-				const FVector2D DirectionB = (Points[PointIdx + 1] - Points[PointIdx]).GetSafeNormal();
-				const FVector2D Tangent = (DirectionA + DirectionB).GetSafeNormal();
-				const FVector2D Perp = FVector2D(-DirectionA.Y, DirectionA.X);
-				const FVector2D Miter = FVector2D(-Tangent.Y, Tangent.X);
-				Direction = Tangent;
-				Length = Thickness / FVector2D::DotProduct(Miter, Perp);
-			}
+			PointX[PointIdx] = Points[PointIdx].X;
+			PointY[PointIdx] = Points[PointIdx].Y;
+		}
 
-			const FVector2D Normal = FVector2D(-Direction.Y, Direction.X);
-			Offsets.Add(Normal * Length);
+		for (int32 SegmentIdx = 0; SegmentIdx < NumSegments; SegmentIdx += 4)
+		{
+			VectorRegister X = VectorSubtract(VectorLoad(&PointX[SegmentIdx + 1]), VectorLoad(&PointX[SegmentIdx]));
+			VectorRegister Y = VectorSubtract(VectorLoad(&PointY[SegmentIdx + 1]), VectorLoad(&PointY[SegmentIdx]));
+			VectorSafeNormal2D(X, Y);
+			VectorStore(X, &DirX[SegmentIdx]);
+			VectorStore(Y, &DirY[SegmentIdx]);
 		}
 
-		TArray<FCanvasUVTri> Triangles;
-		float U = 0.f;
-		for (int32 PointIdx = 1; PointIdx < NumPoints; PointIdx++)
+		// Corner N joins segments N - 1 and N. With Miter = Perp(Tangent), dot(Miter, Perp(A)) equals dot(Tangent, A)
+		const VectorRegister ThicknessVec = VectorSetFloat1(Thickness);
+		for (int32 CornerIdx = 1; CornerIdx < NumSegments; CornerIdx += 4)
 		{
-			const FVector2D Pos0 = Points[PointIdx - 1];
-			const FVector2D Pos1 = Points[PointIdx];
-			const FVector2D Off0 = Offsets[PointIdx - 1];
-			const FVector2D Off1 = Offsets[PointIdx];
-			const float Distance = (UTiling != 0.f) ? (FVector2D::Distance(Pos0, Pos1) / UTiling) : 0.f;
-
-			FCanvasUVTri& Tri0 = Triangles.Emplace_GetRef();
-			Tri0.V0_Pos = Pos0 + Off0;
-			Tri0.V1_Pos = Pos0 - Off0;
-			Tri0.V2_Pos = Pos1 + Off1;
-			Tri0.V0_UV = FVector2D(U, 1.f);
-			Tri0.V1_UV = FVector2D(U, 0.f);
-			Tri0.V2_UV = FVector2D(U + Distance, 1.f);
-
-			FCanvasUVTri& Tri1 = Triangles.Emplace_GetRef();
-			Tri1.V0_Pos = Pos0 - Off0;
-			Tri1.V1_Pos = Pos1 - Off1;
-			Tri1.V2_Pos = Pos1 + Off1;
-			Tri1.V0_UV = FVector2D(U, 0.f);
-			Tri1.V1_UV = FVector2D(U + Distance, 0.f);
-			Tri1.V2_UV = FVector2D(U + Distance, 1.f);
-
-			U += Distance;
+			const VectorRegister AX = VectorLoad(&DirX[CornerIdx - 1]);
+			const VectorRegister AY = VectorLoad(&DirY[CornerIdx - 1]);
+			VectorRegister TangentX = VectorAdd(AX, VectorLoad(&DirX[CornerIdx]));
+			VectorRegister TangentY = VectorAdd(AY, VectorLoad(&DirY[CornerIdx]));
+			VectorSafeNormal2D(TangentX, TangentY);
+
+			const VectorRegister Length = VectorDivide(ThicknessVec, VectorMultiplyAdd(TangentY, AY, VectorMultiply(TangentX, AX)));
+
+			float OffsetX[4], OffsetY[4];
+			VectorStore(VectorNegate(VectorMultiply(TangentY, Length)), OffsetX);
+			VectorStore(VectorMultiply(TangentX, Length), OffsetY);
+
+			const int32 NumLanes = FMath::Min(4, NumSegments - CornerIdx);
+			for (int32 Lane = 0; Lane < NumLanes; Lane++)
+			{
+				OutOffsets[CornerIdx + Lane] = FVector2D(OffsetX[Lane], OffsetY[Lane]);
+			}
 		}
+	}
+}
+
+bool FPolylineMesh::Update(const TArray<FVector2D>& InPoints, float InThickness, float InUTiling)
+{
+	if (InThickness == Thickness && InUTiling == UTiling && InPoints.Num() == Points.Num()
+		&& FMemory::Memcmp(InPoints.GetData(), Points.GetData(), Points.Num() * sizeof(FVector2D)) == 0)
+	{
+		return false;
+	}
+
+	Points = InPoints;
+	Thickness = InThickness;
+	UTiling = InUTiling;
+	BuildTriangles(Points, Thickness, UTiling, TriangleItem.TriangleList);
+	return true;
+}
+
+void FPolylineMesh::Reset()
+{
+	Points.Reset();
+	TriangleItem.TriangleList.Reset();
+}
+
+void FPolylineMesh::Draw(UCanvas* Canvas, UMaterialInterface* RenderMaterial) const
+{
+	TriangleItem.MaterialRenderProxy = RenderMaterial->GetRenderProxy();
+	Canvas->DrawItem(TriangleItem);
+}
+
+void FPolylineMesh::BuildTriangles(const TArray<FVector2D>& Points, float Thickness, float UTiling, TArray<FCanvasUVTri>& OutTriangles)
+{
+	OutTriangles.Reset();
+
+	const int32 NumPoints = Points.Num();
+	if (NumPoints < 2)
+	{
+		return;
+	}
+
+	TArray<FVector2D, TInlineAllocator<64>> Offsets;
+	Offsets.SetNumUninitialized(NumPoints);
+
+	// Starting point uses (next - current), ending point uses (current - previous)
+	Offsets[0] = PolylineMesh::GetEndOffset(Points[0], Points[1], Thickness);
+	Offsets[NumPoints - 1] = PolylineMesh::GetEndOffset(Points[NumPoints - 2], Points[NumPoints - 1], Thickness);
+
+	if (NumPoints >= PolylineMesh::MinPointsForVectorizedMiters)
+	{
+		PolylineMesh::ComputeMiterOffsetsVectorized(Points, Thickness, Offsets.GetData());
+	}
+	else
+	{
+		PolylineMesh::ComputeMiterOffsets(Points, Thickness, Offsets.GetData());
+	}
 
+	OutTriangles.Reserve((NumPoints - 1) * 2);
+	float U = 0.f;
+	for (int32 PointIdx = 1; PointIdx < NumPoints; PointIdx++)
+	{
+		const FVector2D Pos0 = Points[PointIdx - 1];
+		const FVector2D Pos1 = Points[PointIdx];
+		const FVector2D Off0 = Offsets[PointIdx - 1];
+		const FVector2D Off1 = Offsets[PointIdx];
+		const float Distance = (UTiling != 0.f) ? (FVector2D::Distance(Pos0, Pos1) / UTiling) : 0.f;
+
+		FCanvasUVTri& Tri0 = OutTriangles.Emplace_GetRef();
+		Tri0.V0_Pos = Pos0 + Off0;
+		Tri0.V1_Pos = Pos0 - Off0;
+		Tri0.V2_Pos = Pos1 + Off1;
+		Tri0.V0_UV = FVector2D(U, 1.f);
+		Tri0.V1_UV = FVector2D(U, 0.f);
+		Tri0.V2_UV = FVector2D(U + Distance, 1.f);
+
+		FCanvasUVTri& Tri1 = OutTriangles.Emplace_GetRef();
+		Tri1.V0_Pos = Pos0 - Off0;
+		Tri1.V1_Pos = Pos1 - Off1;
+		Tri1.V2_Pos = Pos1 + Off1;
+		Tri1.V0_UV = FVector2D(U, 0.f);
+		Tri1.V1_UV = FVector2D(U + Distance, 0.f);
+		Tri1.V2_UV = FVector2D(U + Distance, 1.f);
+
+		U += Distance;
+	}
+}
+
+void UGameplayStaticsEx::DrawPolyline(UCanvas* InCanvas, UMaterialInterface* RenderMaterial, const TArray<FVector2D>& Points, float Thickness, float UTiling)
+{
+	if (InCanvas && RenderMaterial && Points.Num() > 1)
+	{
 		FCanvasTriangleItem TriangleItem(FVector2D::ZeroVector, FVector2D::ZeroVector, FVector2D::ZeroVector, NULL);
 		TriangleItem.MaterialRenderProxy = RenderMaterial->GetRenderProxy();
-		TriangleItem.TriangleList = MoveTemp(Triangles);
+		FPolylineMesh::BuildTriangles(Points, Thickness, UTiling, TriangleItem.TriangleList);
 		TriangleItem.bFreezeTime = false;
 
 		InCanvas->DrawItem(TriangleItem);
 	}
 }
 
-void ChamferCorner(TArray<FVector2D>& Points, const FVector2D& P0, const FVector2D& P1, const FVector2D& P2, float Radius, float AngleStep)
+bool UGameplayStaticsEx::UpdatePolylineMesh(FPolylineMesh& PolylineMesh, const TArray<FVector2D>& Points, float Thickness, float UTiling)
 {
-	FVector2D V0 = P1 - P0;
-	FVector2D V1 = P1 - P2;
-	const float V0Size = V0.Size();
-	const float V1Size = V1.Size();
-	const float MinSize = FMath::Min(V0Size, V1Size);
-	V0 /= V0Size;
-	V1 /= V1Size;
+	return PolylineMesh.Update(Points, Thickness, UTiling);
+}
 
-	// Calculate length of segment between corner and the points of intersection with the circle of a given radius
-	const float Angle = FMath::Acos(V0 | V1);
-	if ((PI - Angle) < AngleStep)
+void UGameplayStaticsEx::DrawPolylineMesh(UCanvas* InCanvas, UMaterialInterface* RenderMaterial, const FPolylineMesh& PolylineMesh)
+{
+	if (InCanvas && RenderMaterial && !PolylineMesh.IsEmpty())
 	{
-		// Segments are colinear, output the existing corner and exit
-		Points.Emplace(P1);
-		return;
+		PolylineMesh.Draw(InCanvas, RenderMaterial);
 	}
+}
+
+namespace ChamferTessellation
+{
+	struct FCacheEntry
+	{
+		TArray<FVector2D> InPoints;
+		float Radius;
+		float Step;
+		TArray<FVector2D> OutPoints;
+		uint64 LastUsedFrame;
+	};
+
+	const int32 MaxCacheEntries = 64;
 
-	const float HalfAngleTan = FMath::Tan(FMath::Abs(Angle) / 2);
-	float SegmentLen = Radius / HalfAngleTan;
-	if (SegmentLen > MinSize)
+	// Frames an entry is kept without being used, polylines drawn every frame stay cached
+	const uint64 MaxCacheEntryAge = 60;
+
+	uint32 GetCacheKey(const TArray<FVector2D>& Points, float Radius, float Step)
 	{
-		SegmentLen = MinSize;
-		Radius = MinSize * HalfAngleTan;
+		const uint32 PointsHash = FCrc::MemCrc32(Points.GetData(), Points.Num() * sizeof(FVector2D));
+		return HashCombine(HashCombine(PointsHash, GetTypeHash(Radius)), GetTypeHash(Step));
 	}
 
-	// Points of intersection are calculated by the proportion between the coordinates of the vector, length of vector and the length of the segment
-	const FVector2D C0 = P1 - SegmentLen * V0;
-	const FVector2D C1 = P1 - SegmentLen * V1;
+	/** Chamfer a corner. Step is in radians, arc points are evenly spaced so that no division is much shorter than the others. */
+	void ChamferCorner(TArray<FVector2D>& Points, const FVector2D& P0, const FVector2D& P1, const FVector2D& P2, float Radius, float Step)
+	{
+		FVector2D V0 = P1 - P0;
+		FVector2D V1 = P1 - P2;
+		const float V0Size = V0.Size();
+		const float V1Size = V1.Size();
+		const float MinSize = FMath::Min(V0Size, V1Size);
+		V0 /= V0Size;
+		V1 /= V1Size;
+
+		// The arc sweeps PI minus the angle between the segments
+		const float CosAngle = FMath::Clamp(V0 | V1, -1.f, 1.f);
+		const float Sweep = PI - FMath::Acos(CosAngle);
+		if (Sweep < Step)
+		{
+			// Segments are colinear, output the existing corner and exit
+			Points.Emplace(P1);
+			return;
+		}
+
+		// Calculate length of segment between corner and the points of intersection with the circle of a given radius
+		const float HalfAngleTan = FMath::Sqrt((1.f - CosAngle) / (1.f + CosAngle));
+		float SegmentLen = Radius / HalfAngleTan;
+		if (SegmentLen > MinSize)
+		{
+			SegmentLen = MinSize;
+			Radius = MinSize * HalfAngleTan;
+		}
 
-	// Calculate coordinates of the circle center by the addition of angular vectors
-	const FVector2D C = P1 * 2 - C0 - C1;
-	const float R = FMath::Sqrt(SegmentLen * SegmentLen + Radius * Radius);
-	const FVector2D CircleCenter = P1 - (R / C.Size()) * C;
+		// Points of intersection are calculated by the proportion between the coordinates of the vector, length of vector and the length of the segment
+		const FVector2D C0 = P1 - SegmentLen * V0;
+		const FVector2D C1 = P1 - SegmentLen * V1;
 
-	// Calculate arc
-	const float StartAngle = FMath::Atan2(C0.Y - CircleCenter.Y, C0.X - CircleCenter.X);
-	const float EndAngle = FMath::Atan2(C1.Y - CircleCenter.Y, C1.X - CircleCenter.X);
-	float SweepAngle = FMath::FindDeltaAngleRadians(StartAngle, EndAngle);
+		// Calculate coordinates of the circle center by the addition of angular vectors
+		const FVector2D C = P1 * 2 - C0 - C1;
+		const float R = FMath::Sqrt(SegmentLen * SegmentLen + Radius * Radius);
+		const FVector2D CircleCenter = P1 - (R / C.Size()) * C;
 
-	// Output points of the resulting arc
-	const int32 NumDivisions = FMath::CeilToInt(FMath::Abs(SweepAngle) / AngleStep);
-	AngleStep = SweepAngle / NumDivisions;
+		// Rotate the start of the arc by even divisions towards the end, then end exactly on the second intersection
+		const int32 NumDivisions = FMath::CeilToInt(Sweep / Step);
+		const float Direction = FVector2D::CrossProduct(C0 - CircleCenter, C1 - CircleCenter) >= 0.f ? 1.f : -1.f;
+		float DivisionSin, DivisionCos;
+		FMath::SinCos(&DivisionSin, &DivisionCos, Direction * Sweep / NumDivisions);
 
-	const int32 NumPoints = NumDivisions + 1;
-	Points.Reserve(Points.Num() + NumPoints);
+		Points.Reserve(Points.Num() + NumDivisions + 1);
+		FVector2D Offset = C0 - CircleCenter;
+		for (int32 PointIdx = 0; PointIdx < NumDivisions; PointIdx++)
+		{
+			Points.Emplace(CircleCenter + Offset);
+			Offset = FVector2D(Offset.X * DivisionCos - Offset.Y * DivisionSin, Offset.X * DivisionSin + Offset.Y * DivisionCos);
+		}
+		Points.Emplace(C1);
+	}
 
-	for (int32 PointIdx = 0; PointIdx < NumPoints; PointIdx++)
+	void ChamferPolyline(const TArray<FVector2D>& InPoints, float Radius, float Step, TArray<FVector2D>& OutPoints)
 	{
-		float Sin, Cos;
-		FMath::SinCos(&Sin, &Cos, StartAngle + AngleStep * PointIdx);
-		Points.Emplace(CircleCenter + FVector2D(Cos * Radius, Sin * Radius));
+		OutPoints.Reset(InPoints.Num() * 2);  // Wild guess
+
+		// Endpoints are untouched, chamfer every corner vertex
+		OutPoints.Add(InPoints[0]);
+		const int32 LastCornerIdx = InPoints.Num() - 1;
+		for (int32 PointIdx = 1; PointIdx < LastCornerIdx; PointIdx++)
+		{
+			ChamferCorner(OutPoints, InPoints[PointIdx - 1], InPoints[PointIdx], InPoints[PointIdx + 1], Radius, Step);
+		}
+		OutPoints.Add(InPoints.Last());
 	}
 }
 
-void UGameplayStaticsEx::DrawChamferedPolyline(UCanvas* InCanvas, UMaterialInterface* RenderMaterial, const TArray<FVector2D>& InPoints, float Thickness, float UTiling, float Radius, float Step)
+const TArray<FVector2D>& UGameplayStaticsEx::GetChamferedPolyline(const TArray<FVector2D>& Points, float Radius, float Step)
 {
-	if (InCanvas && RenderMaterial && InPoints.Num() > 1)
+	check(IsInGameThread());
+
+	if (Radius <= 0.f || Points.Num() < 3 || Step <= 0.f)
 	{
-		if (Radius > 0.f && InPoints.Num() >= 3 && Step > 0.f)
-		{
-			Step = FMath::DegreesToRadians(Step);
+		return Points;
+	}
 
-			// Endpoints are untouched, chamfer every corner vertex
-			TArray<FVector2D> Points;
-			Points.Reserve(InPoints.Num() * 2);  // Wild guess
+	static TMap<uint32, ChamferTessellation::FCacheEntry> Cache;
 
-			Points.Add(InPoints[0]);
-			const int32 LastCornerIdx = InPoints.Num() - 1;
-			for (int32 PointIdx = 1; PointIdx < LastCornerIdx; PointIdx++)
-			{
-				ChamferCorner(Points, InPoints[PointIdx - 1], InPoints[PointIdx], InPoints[PointIdx + 1], Radius, Step);
-			}
-			Points.Add(InPoints.Last());
+	const uint32 Key = ChamferTessellation::GetCacheKey(Points, Radius, Step);
+	ChamferTessellation::FCacheEntry* Entry = Cache.Find(Key);
+	if (Entry && Entry->Radius == Radius && Entry->Step == Step && Entry->InPoints == Points)
+	{
+		Entry->LastUsedFrame = GFrameCounter;
+		return Entry->OutPoints;
+	}
 
-			DrawPolyline(InCanvas, RenderMaterial, Points, Thickness, UTiling);
+	// Release entries that stopped being drawn
+	for (TMap<uint32, ChamferTessellation::FCacheEntry>::TIterator It = Cache.CreateIterator(); It; ++It)
+	{
+		if (It.Key() != Key && GFrameCounter - It.Value().LastUsedFrame > ChamferTessellation::MaxCacheEntryAge)
+		{
+			It.RemoveCurrent();
 		}
-		else
+	}
+
+	// Evict the least recently used entry, unless the key collided with an entry that is about to be replaced
+	Entry = Cache.Find(Key);
+	if (Entry == nullptr && Cache.Num() >= ChamferTessellation::MaxCacheEntries)
+	{
+		const uint32* OldestKey = nullptr;
+		uint64 OldestFrame = MAX_uint64;
+		for (const TPair<uint32, ChamferTessellation::FCacheEntry>& Pair : Cache)
 		{
-			DrawPolyline(InCanvas, RenderMaterial, InPoints, Thickness, UTiling);
+			if (Pair.Value.LastUsedFrame < OldestFrame)
+			{
+				OldestKey = &Pair.Key;
+				OldestFrame = Pair.Value.LastUsedFrame;
+			}
 		}
+		Cache.Remove(*OldestKey);
+	}
+
+	if (Entry == nullptr)
+	{
+		Entry = &Cache.Add(Key);
+	}
+
+	Entry->InPoints = Points;
+	Entry->Radius = Radius;
+	Entry->Step = Step;
+	Entry->LastUsedFrame = GFrameCounter;
+	ChamferTessellation::ChamferPolyline(Points, Radius, FMath::DegreesToRadians(Step), Entry->OutPoints);
+	return Entry->OutPoints;
+}
+
+void UGameplayStaticsEx::DrawChamferedPolyline(UCanvas* InCanvas, UMaterialInterface* RenderMaterial, const TArray<FVector2D>& InPoints, float Thickness, float UTiling, float Radius, float Step)
+{
+	if (InCanvas && RenderMaterial && InPoints.Num() > 1)
+	{
+		DrawPolyline(InCanvas, RenderMaterial, GetChamferedPolyline(InPoints, Radius, Step), Thickness, UTiling);
 	}
 }
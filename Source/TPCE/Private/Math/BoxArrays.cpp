@@ -0,0 +1,298 @@
+// This source code is licensed under the MIT license found in the LICENSE file in the root directory of this source tree.
+
+#include "Math/BoxArrays.h"
+#include "Math/VectorRegister.h"
+
+namespace BoxArrays
+{
+	const int32 NumLanes = 4;
+
+	/** Write the lanes of a comparison mask into a bit mask, dropping the padding lanes past Num. */
+	FORCEINLINE int32 StoreMaskBits(VectorRegisterInt Mask, int32 Index, int32 Num, TBitArray<>& OutMask)
+	{
+		uint32 Bits = (uint32)VectorMaskBits(VectorCastIntToFloat(Mask));
+		if (Num - Index < NumLanes)
+		{
+			Bits &= (1u << (Num - Index)) - 1;
+		}
+
+		// Groups of lanes never straddle words as indices are multiples of the number of lanes
+		OutMask.GetData()[Index / NumBitsPerDWORD] |= Bits << (Index % NumBitsPerDWORD);
+		return FMath::CountBits(Bits);
+	}
+
+	FORCEINLINE int32 StoreMaskBits(VectorRegister Mask, int32 Index, int32 Num, TBitArray<>& OutMask)
+	{
+		return StoreMaskBits(VectorCastFloatToInt(Mask), Index, Num, OutMask);
+	}
+}
+
+FIntBoxArray::FIntBoxArray()
+	: NumBoxes(0)
+{
+}
+
+void FIntBoxArray::Reset()
+{
+	for (TArray<int32>& Component : Components)
+	{
+		Component.Reset();
+	}
+	NumBoxes = 0;
+}
+
+void FIntBoxArray::Reserve(int32 Number)
+{
+	for (TArray<int32>& Component : Components)
+	{
+		Component.Reserve(Align(Number, BoxArrays::NumLanes));
+	}
+}
+
+int32 FIntBoxArray::Add(const FIntBox& Box)
+{
+	if (NumBoxes % BoxArrays::NumLanes == 0)
+	{
+		for (int32 Component = 0; Component < NumComponents; ++Component)
+		{
+			const int32 EmptyValue = Component < MaxX ? MAX_int32 : MIN_int32;
+			for (int32 Lane = 0; Lane < BoxArrays::NumLanes; ++Lane)
+			{
+				Components[Component].Add(EmptyValue);
+			}
+		}
+	}
+
+	const int32 Index = NumBoxes++;
+	Set(Index, Box);
+	return Index;
+}
+
+void FIntBoxArray::Set(int32 Index, const FIntBox& Box)
+{
+	check(Index >= 0 && Index < NumBoxes);
+
+	const FIntVector Min = Box.IsValid ? Box.Min : FIntVector(MAX_int32);
+	const FIntVector Max = Box.IsValid ? Box.Max : FIntVector(MIN_int32);
+	Components[MinX][Index] = Min.X;
+	Components[MinY][Index] = Min.Y;
+	Components[MinZ][Index] = Min.Z;
+	Components[MaxX][Index] = Max.X;
+	Components[MaxY][Index] = Max.Y;
+	Components[MaxZ][Index] = Max.Z;
+}
+
+FIntBox FIntBoxArray::Get(int32 Index) const
+{
+	check(Index >= 0 && Index < NumBoxes);
+
+	if (Components[MinX][Index] > Components[MaxX][Index])
+	{
+		return FIntBox(ForceInit);
+	}
+
+	return FIntBox(
+		FIntVector(Components[MinX][Index], Components[MinY][Index], Components[MinZ][Index]),
+		FIntVector(Components[MaxX][Index], Components[MaxY][Index], Components[MaxZ][Index]));
+}
+
+int32 FIntBoxArray::Intersect(const FIntBox& Box, TBitArray<>& OutMask) const
+{
+	OutMask.Init(false, NumBoxes);
+
+	const VectorRegisterInt BoxMinX = VectorIntSet1(Box.Min.X);
+	const VectorRegisterInt BoxMinY = VectorIntSet1(Box.Min.Y);
+	const VectorRegisterInt BoxMinZ = VectorIntSet1(Box.Min.Z);
+	const VectorRegisterInt BoxMaxX = VectorIntSet1(Box.Max.X);
+	const VectorRegisterInt BoxMaxY = VectorIntSet1(Box.Max.Y);
+	const VectorRegisterInt BoxMaxZ = VectorIntSet1(Box.Max.Z);
+
+	int32 NumFound = 0;
+	for (int32 Index = 0; Index < NumBoxes; Index += BoxArrays::NumLanes)
+	{
+		// Boxes are separated if they are apart along any axis
+		VectorRegisterInt Separated = VectorIntOr(VectorIntCompareGT(VectorIntLoad(&Components[MinX][Index]), BoxMaxX), VectorIntCompareGT(BoxMinX, VectorIntLoad(&Components[MaxX][Index])));
+		Separated = VectorIntOr(Separated, VectorIntOr(VectorIntCompareGT(VectorIntLoad(&Components[MinY][Index]), BoxMaxY), VectorIntCompareGT(BoxMinY, VectorIntLoad(&Components[MaxY][Index]))));
+		Separated = VectorIntOr(Separated, VectorIntOr(VectorIntCompareGT(VectorIntLoad(&Components[MinZ][Index]), BoxMaxZ), VectorIntCompareGT(BoxMinZ, VectorIntLoad(&Components[MaxZ][Index]))));
+
+		NumFound += BoxArrays::StoreMaskBits(VectorIntNot(Separated), Index, NumBoxes, OutMask);
+	}
+
+	return NumFound;
+}
+
+int32 FIntBoxArray::IsInside(const FIntBox& Box, TBitArray<>& OutMask) const
+{
+	OutMask.Init(false, NumBoxes);
+
+	const VectorRegisterInt BoxMin[3] = { VectorIntSet1(Box.Min.X), VectorIntSet1(Box.Min.Y), VectorIntSet1(Box.Min.Z) };
+	const VectorRegisterInt BoxMax[3] = { VectorIntSet1(Box.Max.X), VectorIntSet1(Box.Max.Y), VectorIntSet1(Box.Max.Z) };
+
+	int32 NumFound = 0;
+	for (int32 Index = 0; Index < NumBoxes; Index += BoxArrays::NumLanes)
+	{
+		// Both corners strictly inside, which also rejects the empty boxes
+		VectorRegisterInt Inside = GlobalVectorConstants::IntMinusOne;
+		for (int32 Axis = 0; Axis < 3; ++Axis)
+		{
+			const VectorRegisterInt Min = VectorIntLoad(&Components[MinX + Axis][Index]);
+			const VectorRegisterInt Max = VectorIntLoad(&Components[MaxX + Axis][Index]);
+			Inside = VectorIntAnd(Inside, VectorIntAnd(VectorIntCompareGT(Min, BoxMin[Axis]), VectorIntCompareLT(Min, BoxMax[Axis])));
+			Inside = VectorIntAnd(Inside, VectorIntAnd(VectorIntCompareGT(Max, BoxMin[Axis]), VectorIntCompareLT(Max, BoxMax[Axis])));
+		}
+
+		NumFound += BoxArrays::StoreMaskBits(Inside, Index, NumBoxes, OutMask);
+	}
+
+	return NumFound;
+}
+
+FIntBox FIntBoxArray::GetBounds() const
+{
+	VectorRegisterInt Min[3] = { VectorIntSet1(MAX_int32), VectorIntSet1(MAX_int32), VectorIntSet1(MAX_int32) };
+	VectorRegisterInt Max[3] = { VectorIntSet1(MIN_int32), VectorIntSet1(MIN_int32), VectorIntSet1(MIN_int32) };
+
+	// Empty boxes and padding leave the bounds unchanged
+	for (int32 Index = 0; Index < NumBoxes; Index += BoxArrays::NumLanes)
+	{
+		for (int32 Axis = 0; Axis < 3; ++Axis)
+		{
+			Min[Axis] = VectorIntMin(Min[Axis], VectorIntLoad(&Components[MinX + Axis][Index]));
+			Max[Axis] = VectorIntMax(Max[Axis], VectorIntLoad(&Components[MaxX + Axis][Index]));
+		}
+	}
+
+	FIntVector BoundsMin, BoundsMax;
+	for (int32 Axis = 0; Axis < 3; ++Axis)
+	{
+		int32 MinLanes[BoxArrays::NumLanes], MaxLanes[BoxArrays::NumLanes];
+		VectorIntStore(Min[Axis], MinLanes);
+		VectorIntStore(Max[Axis], MaxLanes);
+
+		BoundsMin[Axis] = FMath::Min(FMath::Min(MinLanes[0], MinLanes[1]), FMath::Min(MinLanes[2], MinLanes[3]));
+		BoundsMax[Axis] = FMath::Max(FMath::Max(MaxLanes[0], MaxLanes[1]), FMath::Max(MaxLanes[2], MaxLanes[3]));
+	}
+
+	if (BoundsMin.X > BoundsMax.X)
+	{
+		return FIntBox(ForceInit);
+	}
+
+	return FIntBox(BoundsMin, BoundsMax);
+}
+
+FBoundsArray::FBoundsArray()
+	: NumBounds(0)
+{
+}
+
+void FBoundsArray::Reset()
+{
+	LowerBounds.Reset();
+	UpperBounds.Reset();
+	NumBounds = 0;
+}
+
+void FBoundsArray::Reserve(int32 Number)
+{
+	LowerBounds.Reserve(Align(Number, BoxArrays::NumLanes));
+	UpperBounds.Reserve(Align(Number, BoxArrays::NumLanes));
+}
+
+int32 FBoundsArray::Add(const FBounds& Bounds)
+{
+	if (NumBounds % BoxArrays::NumLanes == 0)
+	{
+		LowerBounds.AddZeroed(BoxArrays::NumLanes);
+		UpperBounds.AddZeroed(BoxArrays::NumLanes);
+	}
+
+	const int32 Index = NumBounds++;
+	Set(Index, Bounds);
+	return Index;
+}
+
+void FBoundsArray::Set(int32 Index, const FBounds& Bounds)
+{
+	check(Index >= 0 && Index < NumBounds);
+
+	LowerBounds[Index] = Bounds.LowerBound;
+	UpperBounds[Index] = Bounds.UpperBound;
+}
+
+FBounds FBoundsArray::Get(int32 Index) const
+{
+	check(Index >= 0 && Index < NumBounds);
+
+	return FBounds(LowerBounds[Index], UpperBounds[Index]);
+}
+
+int32 FBoundsArray::Contains(float Value, TBitArray<>& OutMask) const
+{
+	OutMask.Init(false, NumBounds);
+
+	const VectorRegister ValueVec = VectorSetFloat1(Value);
+
+	int32 NumFound = 0;
+	for (int32 Index = 0; Index < NumBounds; Index += BoxArrays::NumLanes)
+	{
+		// Either order of the ends, so reversed bounds work the same
+		const VectorRegister Lower = VectorLoad(&LowerBounds[Index]);
+		const VectorRegister Upper = VectorLoad(&UpperBounds[Index]);
+		const VectorRegister Inside = VectorBitwiseAnd(VectorCompareGE(ValueVec, VectorMin(Lower, Upper)), VectorCompareLE(ValueVec, VectorMax(Lower, Upper)));
+
+		NumFound += BoxArrays::StoreMaskBits(Inside, Index, NumBounds, OutMask);
+	}
+
+	return NumFound;
+}
+
+void FBoundsArray::Clamp(const FBounds& Range)
+{
+	const VectorRegister RangeMin = VectorSetFloat1(FMath::Min(Range.LowerBound, Range.UpperBound));
+	const VectorRegister RangeMax = VectorSetFloat1(FMath::Max(Range.LowerBound, Range.UpperBound));
+
+	for (int32 Index = 0; Index < NumBounds; Index += BoxArrays::NumLanes)
+	{
+		VectorStore(VectorMin(VectorMax(VectorLoad(&LowerBounds[Index]), RangeMin), RangeMax), &LowerBounds[Index]);
+		VectorStore(VectorMin(VectorMax(VectorLoad(&UpperBounds[Index]), RangeMin), RangeMax), &UpperBounds[Index]);
+	}
+}
+
+void FBoundsArray::Expand(float ExpandAmount)
+{
+	const VectorRegister Amount = VectorSetFloat1(ExpandAmount);
+
+	for (int32 Index = 0; Index < NumBounds; Index += BoxArrays::NumLanes)
+	{
+		// Reversed bounds expand the other way so that they keep covering a wider range
+		const VectorRegister Lower = VectorLoad(&LowerBounds[Index]);
+		const VectorRegister Upper = VectorLoad(&UpperBounds[Index]);
+		const VectorRegister SignedAmount = VectorSelect(VectorCompareGT(Lower, Upper), VectorNegate(Amount), Amount);
+
+		VectorStore(VectorSubtract(Lower, SignedAmount), &LowerBounds[Index]);
+		VectorStore(VectorAdd(Upper, SignedAmount), &UpperBounds[Index]);
+	}
+}
+
+void FBoundsArray::Offset(float Value)
+{
+	const VectorRegister ValueVec = VectorSetFloat1(Value);
+
+	for (int32 Index = 0; Index < NumBounds; Index += BoxArrays::NumLanes)
+	{
+		VectorStore(VectorAdd(VectorLoad(&LowerBounds[Index]), ValueVec), &LowerBounds[Index]);
+		VectorStore(VectorAdd(VectorLoad(&UpperBounds[Index]), ValueVec), &UpperBounds[Index]);
+	}
+}
+
+void FBoundsArray::Scale(float Value)
+{
+	const VectorRegister ValueVec = VectorSetFloat1(Value);
+
+	for (int32 Index = 0; Index < NumBounds; Index += BoxArrays::NumLanes)
+	{
+		VectorStore(VectorMultiply(VectorLoad(&LowerBounds[Index]), ValueVec), &LowerBounds[Index]);
+		VectorStore(VectorMultiply(VectorLoad(&UpperBounds[Index]), ValueVec), &UpperBounds[Index]);
+	}
+}
@@ -2,6 +2,7 @@
 
 #include "TPCE.h"
 #include "Modules/ModuleManager.h"
+#include "Application/InputLatencyTracker.h"
 
 #if WITH_GAMEPLAY_DEBUGGER
 #include "GameplayDebugger.h"
@@ -37,6 +38,8 @@ void FTPCE::ShutdownModule()
 {
 	UE_LOG(LogTPCE, Log, TEXT("Third Person Character Extensions (TPCE) Module Shutdown"));
 
+	FInputLatencyTracker::Get().Shutdown();
+
 #if WITH_GAMEPLAY_DEBUGGER
 	if (IGameplayDebugger::IsAvailable())
 	{
@@ -0,0 +1,86 @@
+// This source code is licensed under the MIT license found in the LICENSE file in the root directory of this source tree.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/ObjectMacros.h"
+#include "AnimNodes/AnimNode_DrivenSequenceEvaluator.h"
+
+#include "AnimNode_DistanceMatching.generated.h"
+
+class UCurveFloat;
+struct FRichCurve;
+
+/**
+ * Distance to time lookup sampled at even distance steps, so that finding the time of a distance is constant time.
+ * Times are made monotonic so that a distance always matches a single time even if the source curve wobbles.
+ */
+struct TPCE_API FDistanceMatchingTable
+{
+	FDistanceMatchingTable();
+
+	/** Sample a curve mapping distances to times. */
+	void Build(const FRichCurve& DistanceCurve, int32 NumEntries);
+
+	void Reset() { Times.Reset(); }
+
+	bool IsValid() const { return Times.Num() >= 2; }
+
+	/** Return the time matching a distance, clamped to the range of the curve. */
+	float GetTime(float Distance) const;
+
+private:
+
+	float MinDistance;
+	float DistanceToIndex;
+	TArray<float> Times;
+};
+
+/**
+ * Sequence evaluator driven by distance instead of time, to make starts, stops and pivots hit their marks without
+ * root motion. The distance curve is one generated from the sequence by the distance curve factory.
+ */
+USTRUCT(BlueprintInternalUseOnly)
+struct TPCE_API FAnimNode_DistanceMatching : public FAnimNode_DrivenSequenceEvaluator
+{
+	GENERATED_BODY()
+
+public:
+
+	FAnimNode_DistanceMatching();
+
+	/** Curve mapping the distance to the target to the time of the sequence. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = Settings, meta = (PinHiddenByDefault))
+	UCurveFloat* DistanceCurve;
+
+	/** Distance left to the stop or pivot target, or traveled since the start. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = Settings, meta = (PinShownByDefault))
+	float Distance;
+
+	/** Number of distances sampled from the curve. Higher values follow the curve more closely. */
+	UPROPERTY(EditAnywhere, Category = Settings, meta = (ClampMin = "2", UIMin = "2"))
+	int32 LookupTableSize;
+
+public:
+
+	virtual void GatherDebugData(FNodeDebugData& DebugData) override;
+
+protected:
+
+	// Begin FAnimNode_DrivenSequenceEvaluator Interface
+	virtual void UpdateExplicitTime(const FAnimationUpdateContext& Context) override;
+	// End FAnimNode_DrivenSequenceEvaluator Interface
+
+private:
+
+	FDistanceMatchingTable LookupTable;
+
+	// Curve and size the lookup table was built from
+	const UCurveFloat* LookupTableCurve;
+	int32 LookupTableCurveSize;
+
+#if WITH_EDITOR
+	// Keys of the curve the lookup table was built from, curves can only be edited in the editor
+	uint32 LookupTableCurveHash;
+#endif // WITH_EDITOR
+};
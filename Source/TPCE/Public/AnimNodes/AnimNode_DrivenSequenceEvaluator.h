@@ -0,0 +1,41 @@
+// This source code is licensed under the MIT license found in the LICENSE file in the root directory of this source tree.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/ObjectMacros.h"
+#include "AnimNodes/AnimNode_SequenceEvaluator.h"
+
+#include "AnimNode_DrivenSequenceEvaluator.generated.h"
+
+/**
+ * Sequence evaluator whose explicit time is derived from other inputs. The exposed inputs are executed once, before
+ * the time is derived, instead of after it as the sequence evaluator's update would.
+ */
+USTRUCT(BlueprintInternalUseOnly)
+struct TPCE_API FAnimNode_DrivenSequenceEvaluator : public FAnimNode_SequenceEvaluator
+{
+	GENERATED_BODY()
+
+public:
+
+	FAnimNode_DrivenSequenceEvaluator();
+
+	// Begin FAnimNode_Base Interface
+	virtual void Initialize_AnyThread(const FAnimationInitializeContext& Context) override;
+	// End FAnimNode_Base Interface
+
+	// Begin FAnimNode_AssetPlayerBase Interface
+	virtual void UpdateAssetPlayer(const FAnimationUpdateContext& Context) override;
+	// End FAnimNode_AssetPlayerBase Interface
+
+protected:
+
+	/** Set the sequence and explicit time from the inputs, which are up to date. */
+	virtual void UpdateExplicitTime(const FAnimationUpdateContext& Context) {}
+
+private:
+
+	// Whether the next update starts the accumulated time over
+	bool bResetTime;
+};
@@ -6,6 +6,7 @@
 #include "UObject/ObjectMacros.h"
 #include "BoneContainer.h"
 #include "BonePose.h"
+#include "Animation/SmartName.h"
 #include "BoneControllers/AnimNode_SkeletalControlBase.h"
 
 #include "AnimNode_FootPlacement.generated.h"
@@ -50,8 +51,30 @@ struct FFootPlacementBone
 	UPROPERTY(EditAnywhere, Category = Skeleton)
 	FBoneReference IKFootBone;
 
+	/** Curve that is one while the foot is planted, e.g. created by the Footstep Notifies modifier. The ground is only traced once while the foot stays locked, the offset keeps blending towards it. */
+	UPROPERTY(EditAnywhere, Category = Skeleton)
+	FName LockCurveName;
+
 	UPROPERTY()
 	FFootPlacementOffset Offset;
+
+	SmartName::UID_Type LockCurveUID;
+
+	bool bLocked;
+
+	// Result of the last ground trace, kept while the foot is locked
+	bool bGroundHit;
+	float GroundZ;
+	FVector GroundNormal;
+
+	FFootPlacementBone():
+		LockCurveName(NAME_None),
+		LockCurveUID(SmartName::MaxUID),
+		bLocked(false),
+		bGroundHit(false),
+		GroundZ(0.0f),
+		GroundNormal(FVector::UpVector)
+	{}
 };
 
 USTRUCT(BlueprintInternalUseOnly)
@@ -109,6 +132,10 @@ public:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = Settings, meta = (PinHiddenByDefault))
 	FName CollisionProfileName;
 
+	/** Lock curve value above which a foot is considered planted. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = Settings, meta = (PinHiddenByDefault, ClampMin = "0.0", UIMin = "0.0", ClampMax = "1.0", UIMax = "1.0"))
+	float LockThreshold;
+
 private:
 
 	float DeltaTime;
@@ -132,5 +159,6 @@ private:
 
 	virtual void InitializeBoneReferences(const FBoneContainer& RequiredBones) override;
 
-	void CalculateFootPlacement(const USkeletalMeshComponent* SkelComp, const FVector& BaseLocation, const FVector& FootLocation, FFootPlacementOffset& OutFootOffset);
+	void TraceGround(const USkeletalMeshComponent* SkelComp, const FVector& BaseLocation, const FVector& FootLocation, FFootPlacementBone& Foot) const;
+	void CalculateFootPlacement(const FVector& BaseLocation, FFootPlacementBone& Foot);
 };
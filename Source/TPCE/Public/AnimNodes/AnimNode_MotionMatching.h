@@ -0,0 +1,74 @@
+// This source code is licensed under the MIT license found in the LICENSE file in the root directory of this source tree.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/ObjectMacros.h"
+#include "AnimNodes/AnimNode_DrivenSequenceEvaluator.h"
+
+#include "AnimNode_MotionMatching.generated.h"
+
+class UMotionDatabase;
+
+/**
+ * Plays the poses of a motion database, periodically jumping to the pose that best continues the current one while
+ * following the desired velocity. Searches run during the animation update, on worker threads when it is parallel.
+ * Place an Inertialization node after it to blend the jumps.
+ */
+USTRUCT(BlueprintInternalUseOnly)
+struct TPCE_API FAnimNode_MotionMatching : public FAnimNode_DrivenSequenceEvaluator
+{
+	GENERATED_BODY()
+
+public:
+
+	FAnimNode_MotionMatching();
+
+	/** Poses to match. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = Settings, meta = (PinHiddenByDefault))
+	UMotionDatabase* Database;
+
+	/** Velocity to follow in component space, matched against the root velocity features of the database. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = Settings, meta = (PinShownByDefault))
+	FVector DesiredVelocity;
+
+	/** Seconds between searches. */
+	UPROPERTY(EditAnywhere, Category = Settings, meta = (ClampMin = "0"))
+	float SearchInterval;
+
+	/** Cost the best pose must improve on the current one by to jump to it, to avoid jumping between similar poses. */
+	UPROPERTY(EditAnywhere, Category = Settings, meta = (ClampMin = "0"))
+	float MinCostImprovement;
+
+	/** Milliseconds after which a search returns the best pose found so far, zero for no limit. */
+	UPROPERTY(EditAnywhere, Category = Settings, meta = (ClampMin = "0"))
+	float SearchTimeBudget;
+
+	/** Duration of the inertialization requested when jumping to another pose. */
+	UPROPERTY(EditAnywhere, Category = Settings, meta = (ClampMin = "0"))
+	float BlendTime;
+
+public:
+
+	// Begin FAnimNode_Base Interface
+	virtual void Initialize_AnyThread(const FAnimationInitializeContext& Context) override;
+	// End FAnimNode_Base Interface
+
+	virtual void GatherDebugData(FNodeDebugData& DebugData) override;
+
+protected:
+
+	// Begin FAnimNode_DrivenSequenceEvaluator Interface
+	virtual void UpdateExplicitTime(const FAnimationUpdateContext& Context) override;
+	// End FAnimNode_DrivenSequenceEvaluator Interface
+
+private:
+
+	/** Search the database and jump to the best pose if it improves enough on the current one. Return whether it jumped. */
+	bool SearchPose(const FAnimationUpdateContext& Context);
+
+	int32 CurrentSequenceIndex;
+	float CurrentTime;
+	float TimeSinceSearch;
+	float LastSearchCost;
+};
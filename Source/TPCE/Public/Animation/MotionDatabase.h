@@ -0,0 +1,201 @@
+// This source code is licensed under the MIT license found in the LICENSE file in the root directory of this source tree.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/DataAsset.h"
+
+#include "MotionDatabase.generated.h"
+
+class UAnimSequence;
+
+/** Animation curve sampled into a feature of the motion database. */
+USTRUCT(BlueprintType)
+struct FMotionDatabaseCurveFeature
+{
+	GENERATED_BODY()
+
+	/** Name of the curve, e.g. one generated by the Bone Distance or Foot Sync Markers modifiers. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = Feature)
+	FName CurveName;
+
+	/** Importance of the feature when matching poses. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = Feature, meta = (ClampMin = "0"))
+	float Weight;
+
+	FMotionDatabaseCurveFeature()
+		: CurveName(NAME_None)
+		, Weight(1.0f)
+	{}
+};
+
+/** Node of the KD-tree indexing the poses. */
+USTRUCT()
+struct FMotionDatabaseNode
+{
+	GENERATED_BODY()
+
+	/** Feature splitting the poses of the node, INDEX_NONE for leaves. */
+	UPROPERTY()
+	int32 SplitFeature;
+
+	/** Poses of the left child are at most this value, poses of the right child at least. */
+	UPROPERTY()
+	float SplitValue;
+
+	/** Index of the right child, the left child follows the node. First pose slot of leaves. */
+	UPROPERTY()
+	int32 RightChildOrFirstSlot;
+
+	/** Number of poses of leaves. */
+	UPROPERTY()
+	int32 NumSlots;
+
+	FMotionDatabaseNode()
+		: SplitFeature(INDEX_NONE)
+		, SplitValue(0.0f)
+		, RightChildOrFirstSlot(0)
+		, NumSlots(0)
+	{}
+
+	bool IsLeaf() const { return SplitFeature == INDEX_NONE; }
+};
+
+struct FMotionDatabaseSearchResult
+{
+	/** Slot of the best pose found, INDEX_NONE if none. */
+	int32 Slot = INDEX_NONE;
+
+	float Cost = MAX_flt;
+};
+
+/**
+ * Poses of a set of sequences sampled at a fixed rate into normalized, weighted features, indexed by a KD-tree.
+ *
+ * Features are stored as structure of arrays, one row per feature with a column per pose slot. Slots are in tree order
+ * so that the poses of a leaf are contiguous and their costs can be computed four at a time.
+ * Features are built in the editor from curves, root motion and sync markers of the sequences.
+ */
+UCLASS(BlueprintType)
+class TPCE_API UMotionDatabase : public UDataAsset
+{
+	GENERATED_BODY()
+
+public:
+
+	UMotionDatabase();
+
+	/** Sequences to match poses from. */
+	UPROPERTY(EditAnywhere, Category = Sources)
+	TArray<UAnimSequence*> Sequences;
+
+	/** Poses sampled per second. */
+	UPROPERTY(EditAnywhere, Category = Sources, meta = (ClampMin = "1"))
+	float SampleRate;
+
+	/** Curves to match. */
+	UPROPERTY(EditAnywhere, Category = Features)
+	TArray<FMotionDatabaseCurveFeature> CurveFeatures;
+
+	/** Importance of the root velocity along the X and Y axes, zero to ignore it. */
+	UPROPERTY(EditAnywhere, Category = Features, meta = (ClampMin = "0"))
+	float RootVelocityWeight;
+
+	/** Importance of the phase between sync markers, e.g. the ones generated by the Foot Sync Markers modifier. Zero to ignore it. */
+	UPROPERTY(EditAnywhere, Category = Features, meta = (ClampMin = "0"))
+	float SyncPhaseWeight;
+
+	/** Maximum number of poses in a leaf of the index. */
+	UPROPERTY(EditAnywhere, Category = Features, AdvancedDisplay, meta = (ClampMin = "4"))
+	int32 MaxLeafSize;
+
+	bool IsValid() const { return NumPoses > 0 && NumFeatures > 0; }
+
+	int32 GetNumFeatures() const { return NumFeatures; }
+
+	/** Return the feature of the root velocity along X, followed by the one along Y, or INDEX_NONE. */
+	int32 GetRootVelocityFeature() const { return RootVelocityFeature; }
+
+	/** Return the normalized value of a feature. */
+	float NormalizeFeature(int32 Feature, float Value) const { return (Value - FeatureOffsets[Feature]) * FeatureScales[Feature]; }
+
+	/** Return the slot of the pose of a sequence closest to a time, or INDEX_NONE. */
+	int32 FindSlot(int32 SequenceIndex, float Time) const;
+
+	int32 GetSlotSequence(int32 Slot) const { return SlotSequences[Slot]; }
+
+	float GetSlotTime(int32 Slot) const { return SlotTimes[Slot]; }
+
+	/** Copy the normalized features of a pose. */
+	void GetSlotFeatures(int32 Slot, TArrayView<float> OutFeatures) const;
+
+	/** Return the cost of a pose given normalized query features. */
+	float GetSlotCost(int32 Slot, TArrayView<const float> Query) const;
+
+	/**
+	 * Find the pose closest to normalized query features. Thread safe.
+	 * @param TimeBudget Seconds after which the best pose found so far is returned, zero for no limit.
+	 */
+	FMotionDatabaseSearchResult Search(TArrayView<const float> Query, double TimeBudget = 0.0) const;
+
+#if WITH_EDITOR
+	/** Sample the sequences and rebuild the index. */
+	UFUNCTION(CallInEditor, Category = Sources)
+	void Build();
+#endif // WITH_EDITOR
+
+private:
+
+	void SearchLeaf(const FMotionDatabaseNode& Leaf, TArrayView<const float> Query, FMotionDatabaseSearchResult& Result) const;
+
+#if WITH_EDITOR
+	int32 BuildNode(TArray<int32>& Poses, int32 Begin, int32 End, const TArray<float>& PoseFeatures);
+#endif // WITH_EDITOR
+
+	/** Sample rate the poses were built with. */
+	UPROPERTY()
+	float PoseSampleRate;
+
+	UPROPERTY()
+	int32 NumPoses;
+
+	UPROPERTY()
+	int32 NumFeatures;
+
+	/** Distance between rows of FeatureValues, padded so that the last slots can be loaded four at a time. */
+	UPROPERTY()
+	int32 SlotStride;
+
+	UPROPERTY()
+	int32 RootVelocityFeature;
+
+	UPROPERTY()
+	TArray<FName> FeatureNames;
+
+	UPROPERTY()
+	TArray<float> FeatureOffsets;
+
+	UPROPERTY()
+	TArray<float> FeatureScales;
+
+	/** Normalized features, NumFeatures rows of SlotStride values. */
+	UPROPERTY()
+	TArray<float> FeatureValues;
+
+	UPROPERTY()
+	TArray<int32> SlotSequences;
+
+	UPROPERTY()
+	TArray<float> SlotTimes;
+
+	/** First pose of each sequence, poses of a sequence are sampled in order. */
+	UPROPERTY()
+	TArray<int32> SequenceFirstPoses;
+
+	/** Slot of each pose. */
+	UPROPERTY()
+	TArray<int32> PoseSlots;
+
+	UPROPERTY()
+	TArray<FMotionDatabaseNode> Nodes;
+};
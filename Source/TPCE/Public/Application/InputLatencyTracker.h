@@ -0,0 +1,140 @@
+// This source code is licensed under the MIT license found in the LICENSE file in the root directory of this source tree.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/CriticalSection.h"
+#include "HAL/PlatformTime.h"
+
+/** Input latency tracking is compiled out of shipping builds. */
+#ifndef WITH_INPUT_LATENCY_STATS
+#define WITH_INPUT_LATENCY_STATS !UE_BUILD_SHIPPING
+#endif
+
+namespace EInputLatencyStage
+{
+	enum Type
+	{
+		EventToProcessInput,
+		ProcessInputToCameraPOV,
+		CameraPOVToPresent,
+		EventToPresent,
+		Num
+	};
+}
+
+/** Accumulated latency of a single stage. */
+struct TPCE_API FInputLatencyStatEntry
+{
+	int32 Count;
+	double TotalSeconds;
+	double MinSeconds;
+	double MaxSeconds;
+	double LastSeconds;
+
+	FInputLatencyStatEntry()
+	{
+		Reset();
+	}
+
+	void Reset()
+	{
+		Count = 0;
+		TotalSeconds = 0.0;
+		MinSeconds = 0.0;
+		MaxSeconds = 0.0;
+		LastSeconds = 0.0;
+	}
+
+	void Add(double Seconds)
+	{
+		MinSeconds = Count > 0 ? FMath::Min(MinSeconds, Seconds) : Seconds;
+		MaxSeconds = FMath::Max(MaxSeconds, Seconds);
+		TotalSeconds += Seconds;
+		LastSeconds = Seconds;
+		Count++;
+	}
+
+	double GetAverageSeconds() const { return Count > 0 ? TotalSeconds / Count : 0.0; }
+};
+
+/**
+ * Measures the latency from raw input events to the frame that shows their result.
+ *
+ * The oldest input event not yet processed is stamped by FDetectInputProcessor, then carried through
+ * AExtPlayerController::PostProcessInput (where pawns run IPawnControlInterface::ProcessInput), the camera update of
+ * AExtPlayerCameraManager (after arm components and camera modifiers resolved the POV) and finally the presentation of
+ * the back buffer on the render thread. Only one input event is in flight per frame, events arriving while one is
+ * in flight are folded into it.
+ *
+ * Tracking is enabled with input.Latency.Enable. Stages are reported to the CSV profiler (InputLatency category) and
+ * accumulated for input.Latency.DumpCSV.
+ */
+class TPCE_API FInputLatencyTracker
+{
+public:
+
+	static FInputLatencyTracker& Get();
+
+	/** Return whether tracking is enabled. */
+	static bool IsEnabled();
+
+	/** Stamp an input event. Called on the game thread by input processors. */
+	void MarkInputEvent();
+
+	/** Mark that pending input was processed by the player controller. */
+	void MarkProcessInput();
+
+	/** Mark that the camera POV was resolved for the processed input. */
+	void MarkCameraPOV();
+
+	/** Stop tracking and unbind from engine delegates. */
+	void Shutdown();
+
+	/** Drop the stamps of the input event in flight, so that it isn't measured once tracking is enabled again. */
+	void ClearPending();
+
+	/** Clear accumulated stats. */
+	void Reset();
+
+	/** Return a copy of the accumulated stats of a stage. */
+	FInputLatencyStatEntry GetStat(EInputLatencyStage::Type Stage) const;
+
+	/** Return the display name of a stage. */
+	static const TCHAR* GetStageName(EInputLatencyStage::Type Stage);
+
+	/** Return the CSV header matching the columns of AppendCSV. */
+	static FString GetCSVHeader();
+
+	/** Append a CSV row per stage to Out. */
+	void AppendCSV(FString& Out) const;
+
+private:
+
+	FInputLatencyTracker();
+
+	void BindDelegates();
+	void RenderThread_OnPresent();
+	void RecordStage(EInputLatencyStage::Type Stage, uint64 StartCycles, uint64 EndCycles);
+
+	FInputLatencyStatEntry Stats[EInputLatencyStage::Num];
+	mutable FCriticalSection StatsCritical;
+
+	// Game thread stamps, zero when not in flight
+	uint64 PendingEventCycles;
+	uint64 ProcessedEventCycles;
+	uint64 ProcessInputCycles;
+
+	// Render thread stamps of the frame waiting to be presented
+	uint64 RenderThread_EventCycles;
+	uint64 RenderThread_CameraPOVCycles;
+
+	FDelegateHandle BackBufferReadyHandle;
+	bool bDelegatesBound;
+};
+
+#if WITH_INPUT_LATENCY_STATS
+#define MARK_INPUT_LATENCY(Stage) do { if (FInputLatencyTracker::IsEnabled()) { FInputLatencyTracker::Get().Mark##Stage(); } } while (0)
+#else
+#define MARK_INPUT_LATENCY(Stage) do { } while (0)
+#endif // WITH_INPUT_LATENCY_STATS
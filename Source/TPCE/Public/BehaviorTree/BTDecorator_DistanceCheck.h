@@ -11,7 +11,13 @@
 
 struct FBTDistanceCheckDecoratorMemory
 {
+	/** Handle of the pair registered with the distance subsystem. */
+	int32 DistancePairHandle;
+
 	bool bLastRawResult;
+
+	/** Whether the proximity trigger is registered, the decorator polls the distance until it is. */
+	bool bProximityTriggerEnabled;
 };
 
 /**
@@ -36,6 +42,21 @@ class TPCE_API UBTDecorator_DistanceCheck : public UBTDecorator
 	UPROPERTY(EditAnywhere, Category="Condition")
 	FAIDistanceType GeometricDistanceType;
 
+	/**
+	 * If set, locations are read from the shared distance subsystem which samples each actor once per frame while the decorator is relevant.
+	 * Results may be up to one frame old.
+	 */
+	UPROPERTY(EditAnywhere, Category="Condition", AdvancedDisplay)
+	bool bUseDistanceCache;
+
+	/**
+	 * If set, the range is registered as a proximity trigger with the distance subsystem which notifies the decorator only when
+	 * the observed distance crosses MinDistance or MaxDistance, or the observed entry changes.
+	 * The decorator only ticks to poll the distance until the trigger can be registered, e.g. when the pawn isn't possessed yet.
+	 */
+	UPROPERTY(EditAnywhere, Category="Condition", AdvancedDisplay)
+	bool bUseProximityTrigger;
+
 	/** Blackboard key selector */
 	UPROPERTY(EditAnywhere, Category="Blackboard")
 	FBlackboardKeySelector Observed;
@@ -53,7 +74,11 @@ protected:
 
 	virtual bool CalculateRawConditionValue(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory) const override;
 	virtual void OnBecomeRelevant(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory) override;
-	void OnBlackboardChange(const UBlackboardComponent& Blackboard, FBlackboard::FKey ChangedKeyID);
+	virtual void OnCeaseRelevant(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory) override;
+	EBlackboardNotificationResult OnBlackboardKeyValueChange(const UBlackboardComponent& Blackboard, FBlackboard::FKey ChangedKeyID);
+	void OnProximityTriggerChanged(bool bInside, TWeakObjectPtr<UBehaviorTreeComponent> OwnerComp);
+	bool RegisterDistancePair(UBehaviorTreeComponent& OwnerComp, TNodeInstanceMemory& MyMemory);
+	bool EnableProximityTrigger(UBehaviorTreeComponent& OwnerComp, TNodeInstanceMemory& MyMemory);
 	virtual void TickNode(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory, float DeltaSeconds) override;
 
 private:
@@ -61,7 +86,8 @@ private:
 	float MinDistanceSqr;
 	float MaxDistanceSqr;
 
-	bool CalcConditionImpl(const UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory) const;
+	bool CalcConditionImpl(const UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory, bool bUseCachedDistance = false) const;
 	float GetGeometricDistanceSquared(const FVector& A, const FVector& B) const;
 	bool CalculateDistance(const UBehaviorTreeComponent& OwnerComp, const FBlackboardKeySelector& Target, float& Distance) const;
+	bool CalculateCachedDistance(const UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory, float& DistanceSqr) const;
 };
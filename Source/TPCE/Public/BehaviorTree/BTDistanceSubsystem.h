@@ -0,0 +1,180 @@
+// This source code is licensed under the MIT license found in the LICENSE file in the root directory of this source tree.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/ObjectMacros.h"
+#include "UObject/ObjectKey.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Tickable.h"
+#include "BehaviorTree/BehaviorTreeTypes.h"
+#include "AITypes.h"
+
+#include "BTDistanceSubsystem.generated.h"
+
+class AActor;
+class UBlackboardComponent;
+
+/** Delegate for proximity trigger state changes. */
+DECLARE_DELEGATE_OneParam(FOnProximityTriggerChanged, bool /* bInside */);
+
+/**
+ * Behavior tree distance subsystem.
+ * Shared per-frame distance cache for behavior tree nodes. Nodes register an agent/target pair and read the result
+ * instead of querying actor locations and collision cylinders on their own. Every referenced actor is sampled once per
+ * frame no matter how many pairs use it, then distances for all pairs are computed in a single vectorized pass.
+ * Results are refreshed at the end of the frame, so values read during a frame are at most one frame old.
+ *
+ * Pairs can also be turned into proximity triggers that report when the distance enters or leaves a [min, max] ring.
+ * Trigger pairs are not evaluated every frame. Actor locations are quantized into grid cells and a trigger is only
+ * re-evaluated when its agent or target moves to another cell, or when the current cells are close enough to a ring
+ * boundary that a crossing is possible without changing cells.
+ */
+UCLASS()
+class TPCE_API UBTDistanceSubsystem : public UWorldSubsystem, public FTickableGameObject
+{
+	GENERATED_BODY()
+
+public:
+
+	// Begin USubsystem Interface
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+	// End USubsystem Interface
+
+	// Begin FTickableGameObject Interface
+	virtual void Tick(float DeltaTime) override;
+	virtual ETickableTickType GetTickableTickType() const override;
+	virtual bool IsTickable() const override;
+	virtual TStatId GetStatId() const override;
+	virtual UWorld* GetTickableGameObjectWorld() const override { return GetWorld(); }
+	// End FTickableGameObject Interface
+
+	/** Return the subsystem of the world the object belongs to if available. */
+	static UBTDistanceSubsystem* Get(const UObject* WorldContextObject);
+
+	/** Register a new pair observed by Agent and return its handle. The pair has no target until one is assigned. */
+	int32 RegisterPair(AActor* Agent, bool bIncludeAgentRadius = false, bool bIncludeGoalRadius = false);
+
+	/** Release a pair handle. The handle is reset to INDEX_NONE. */
+	void UnregisterPair(int32& Handle);
+
+	/** Set the pair target to an actor. Pawn targets contribute their collision cylinder if bIncludeGoalRadius was requested. */
+	void SetPairTarget(int32 Handle, AActor* TargetActor);
+
+	/** Set the pair target to a fixed location. */
+	void SetPairTarget(int32 Handle, const FVector& TargetLocation);
+
+	/** Remove the pair target. Distance queries will fail until a new target is assigned. */
+	void ClearPairTarget(int32 Handle);
+
+	/** Set the pair target from an actor or vector blackboard entry. Return False if the entry holds no valid target. */
+	bool SetPairTargetFromBlackboard(int32 Handle, const UBlackboardComponent& Blackboard, FBlackboard::FKey KeyID);
+
+	/** Get the squared distance between agent and target ignoring collision cylinders. Return False if the pair has no valid result. */
+	bool GetDistanceSquared(int32 Handle, FAIDistanceType DistanceType, float& OutDistanceSqr) const;
+
+	/** Get the distance between agent and target minus the collision cylinders requested on registration. Return False if the pair has no valid result. */
+	bool GetDistance(int32 Handle, FAIDistanceType DistanceType, float& OutDistance) const;
+
+	/**
+	 * Turn a pair into a proximity trigger. The delegate is executed whenever the pair enters or leaves the range
+	 * [MinDistance, MaxDistance], including when the target changes. A zero distance disables that side of the range.
+	 * Trigger pairs are excluded from the regular per-frame update. Return whether the pair is currently in range.
+	 */
+	bool EnableProximityTrigger(int32 Handle, FAIDistanceType DistanceType, float MinDistance, float MaxDistance, const FOnProximityTriggerChanged& Delegate);
+
+	/** Return True if the handle refers to a registered pair. */
+	FORCEINLINE bool IsValidPair(int32 Handle) const { return Pairs.IsValidIndex(Handle); }
+
+	/** Return the number of registered pairs. */
+	FORCEINLINE int32 GetNumPairs() const { return Pairs.Num(); }
+
+private:
+
+	struct FActorEntry
+	{
+		TWeakObjectPtr<AActor> Actor;
+		TObjectKey<AActor> Key;
+		TArray<int32> TriggerHandles;
+		FIntVector Cell;
+		int32 RefCount;
+		int32 CylinderRefCount;
+		bool bIsPawn;
+		bool bValid;
+	};
+
+	struct FPairEntry
+	{
+		int32 AgentIndex;
+		int32 TargetIndex;
+		FVector TargetLocation;
+		bool bHasTarget;
+		bool bIncludeAgentRadius;
+		bool bIncludeGoalRadius;
+		bool bHasResult;
+
+		// Proximity trigger state, only used if bTrigger is set
+		FOnProximityTriggerChanged OnTriggerChanged;
+		FAIDistanceType TriggerDistanceType;
+		float TriggerMinDistanceSqr;
+		float TriggerMaxDistanceSqr;
+		bool bTrigger;
+		bool bTriggerInside;
+		bool bTriggerDirty;
+	};
+
+	/** Aligned float buffer padded to a multiple of 4 so it can be processed with vector registers. */
+	typedef TArray<float, TAlignedHeapAllocator<16>> FFloatBuffer;
+
+	TSparseArray<FActorEntry> Actors;
+	TMap<TObjectKey<AActor>, int32> ActorIndices;
+
+	TSparseArray<FPairEntry> Pairs;
+
+	/** Triggers to evaluate in the next update. */
+	TArray<int32> DirtyTriggers;
+
+	/** Triggers whose current cells straddle a ring boundary and must be evaluated every frame. */
+	TSet<int32> BoundaryTriggers;
+
+	/** Grid cell size used to quantize actor locations for proximity triggers. */
+	float CellSize;
+
+	// Actor samples indexed by actor entry
+	TArray<FVector> ActorLocations;
+	TArray<float> ActorRadii;
+	TArray<float> ActorHalfHeights;
+
+	// Pair inputs and results indexed by pair handle (SoA)
+	FFloatBuffer AgentX, AgentY, AgentZ;
+	FFloatBuffer TargetX, TargetY, TargetZ;
+	FFloatBuffer RadiusSums, HalfHeightSums;
+	FFloatBuffer DistSquared3D, DistSquared2D, DistZ;
+
+	int32 AcquireActor(AActor* Actor, bool bNeedsCylinder);
+	void ReleaseActor(int32 ActorIndex, bool bNeedsCylinder);
+	void SetPairTargetIndex(int32 Handle, int32 TargetIndex, const FVector& TargetLocation);
+
+	/** Sample location and collision cylinder of a single actor entry. Return False if the actor is gone. */
+	bool SampleActor(int32 ActorIndex);
+
+	/** Copy the cached actor samples of a pair into the pair buffers. */
+	void GatherPair(int32 Handle);
+
+	/** Sample and compute a single pair immediately so that new registrations have a valid result before the next tick. */
+	void UpdatePairImmediate(int32 Handle);
+
+	/** Grow the SoA buffers so that they can be indexed by every pair handle. */
+	void ReservePairBuffers();
+
+	void LinkTrigger(int32 ActorIndex, int32 Handle);
+	void UnlinkTrigger(int32 ActorIndex, int32 Handle);
+	void MarkTriggerDirty(int32 Handle);
+
+	/** Evaluate a trigger from the current pair results and classify its cells. Execute the delegate on state change if bNotify is set. */
+	bool EvaluateTrigger(int32 Handle, bool bNotify);
+
+	/** Compute distances for pair buffer range [StartIndex, EndIndex). Both must be multiples of 4. */
+	void ComputeDistances(int32 StartIndex, int32 EndIndex);
+};
@@ -0,0 +1,158 @@
+// This source code is licensed under the MIT license found in the LICENSE file in the root directory of this source tree.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/ObjectMacros.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Tickable.h"
+#include "Templates/SubclassOf.h"
+#include "NavFilters/NavigationQueryFilter.h"
+
+#include "BTReachablePointSubsystem.generated.h"
+
+/** Delegate for finished reachable point queries. Point is the query origin if no reachable point was found. */
+DECLARE_DELEGATE_ThreeParams(FOnReachablePointQueryFinished, uint32 /* QueryId */, bool /* bSuccess */, const FVector& /* Point */);
+
+/** Parameters of a random reachable point query. */
+struct TPCE_API FReachablePointRequest
+{
+	FVector Origin;
+	float Radius;
+	TSubclassOf<UNavigationQueryFilter> FilterClass;
+
+	/** Object used to resolve the query filter, usually the AI controller. */
+	TWeakObjectPtr<const UObject> Querier;
+
+	/** If set, the query is answered from the pre-sampled points of the origin's cell, sampling the cell first if needed. */
+	bool bUseCache;
+
+	FReachablePointRequest()
+		: Origin(FVector::ZeroVector)
+		, Radius(0.f)
+		, bUseCache(false)
+	{
+	}
+};
+
+/**
+ * Behavior tree reachable point subsystem.
+ * Spreads random reachable point queries over multiple frames so that a wave of agents requesting points at the same time
+ * doesn't stall a single frame, and keeps a cache of reachable points pre-sampled per origin cell that can be drawn from
+ * without touching the navmesh. Navmesh queries are not thread-safe, so queries are still executed on the game thread but
+ * limited to a fixed number per frame.
+ */
+UCLASS()
+class TPCE_API UBTReachablePointSubsystem : public UWorldSubsystem, public FTickableGameObject
+{
+	GENERATED_BODY()
+
+public:
+
+	// Begin USubsystem Interface
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+	// End USubsystem Interface
+
+	// Begin FTickableGameObject Interface
+	virtual void Tick(float DeltaTime) override;
+	virtual ETickableTickType GetTickableTickType() const override;
+	virtual bool IsTickable() const override;
+	virtual TStatId GetStatId() const override;
+	virtual UWorld* GetTickableGameObjectWorld() const override { return GetWorld(); }
+	// End FTickableGameObject Interface
+
+	/** Return the subsystem of the world the object belongs to if available. */
+	static UBTReachablePointSubsystem* Get(const UObject* WorldContextObject);
+
+	/** Queue a query and return its id. The delegate is executed from a later tick. An unbound delegate only fills the cache. */
+	uint32 RequestReachablePoint(const FReachablePointRequest& Request, const FOnReachablePointQueryFinished& Delegate);
+
+	/** Remove a pending query. The delegate won't be executed. */
+	void CancelQuery(uint32 QueryId);
+
+	/** Draw a random pre-sampled point within radius of the request's origin if available. Never touches the navmesh. */
+	bool GetCachedReachablePoint(const FReachablePointRequest& Request, FVector& OutPoint) const;
+
+	/**
+	 * Run a single query immediately. Without a navmesh or if the query fails, a random point in radius is returned.
+	 * @return False if the querier has no world.
+	 */
+	static bool GetRandomReachablePoint(const FReachablePointRequest& Request, FVector& OutPoint);
+
+	/**
+	 * Sample points for the request's origin cell and store them in the cache, restarting if the cell's samples expired.
+	 * Cells can be sampled over several calls, their points are only drawn once all samples have been taken.
+	 * @param MaxSamples Maximum number of navmesh queries to make.
+	 * @return The number of navmesh queries made.
+	 */
+	int32 SampleCacheEntry(const FReachablePointRequest& Request, int32 MaxSamples = MAX_int32);
+
+	/** Store a point found by a query made elsewhere as a sample of the request's origin cell, unless the cell is complete. */
+	void AddCacheSample(const FReachablePointRequest& Request, const FVector& Point);
+
+	/** Discard all pre-sampled points, e.g. after the navmesh has been rebuilt. */
+	void FlushCache();
+
+private:
+
+	struct FPendingQuery
+	{
+		uint32 QueryId;
+		FReachablePointRequest Request;
+		FOnReachablePointQueryFinished Delegate;
+	};
+
+	struct FCacheKey
+	{
+		FIntVector Cell;
+		int32 Radius;
+		const UClass* FilterClass;
+
+		FORCEINLINE bool operator==(const FCacheKey& Other) const
+		{
+			return Cell == Other.Cell && Radius == Other.Radius && FilterClass == Other.FilterClass;
+		}
+
+		friend FORCEINLINE uint32 GetTypeHash(const FCacheKey& Key)
+		{
+			return HashCombine(HashCombine(GetTypeHash(Key.Cell), GetTypeHash(Key.Radius)), GetTypeHash(Key.FilterClass));
+		}
+	};
+
+	struct FCacheEntry
+	{
+		TArray<FVector> Points;
+		float Timestamp;
+
+		/** Number of navmesh queries made to sample the points, some of which may have failed. */
+		int32 NumSamples;
+	};
+
+	/** Queries in request order from PendingQueriesHead, the ones before have been processed. Cancelled queries have a zero id. */
+	TArray<FPendingQuery> PendingQueries;
+	int32 PendingQueriesHead;
+
+	TMap<FCacheKey, FCacheEntry> Cache;
+	uint32 NextQueryId;
+
+	// Settings read from console variables on initialization
+	float CacheCellSize;
+	float CacheLifetime;
+	int32 CacheSamples;
+
+	FCacheKey MakeCacheKey(const FReachablePointRequest& Request) const;
+	bool IsCacheEntryExpired(const FCacheEntry& Entry) const;
+
+	/** Return the cache entry of the request's origin cell if all its samples have been taken and haven't expired. */
+	const FCacheEntry* FindCacheEntry(const FReachablePointRequest& Request) const;
+
+	/** Return the cache entry of the request's origin cell to add samples to, restarting it if expired or sampled without success. */
+	FCacheEntry& FindOrResetCacheEntry(const FReachablePointRequest& Request);
+
+	/** Process a single query. Return the number of navmesh queries made. */
+	int32 ProcessQuery(const FPendingQuery& Query);
+
+	/** Remove the first pending query, releasing processed ones when they take enough of the array. */
+	FPendingQuery PopPendingQuery();
+};
@@ -9,6 +9,12 @@
 
 #include "BTService_Distance.generated.h"
 
+struct FBTDistanceServiceMemory
+{
+	/** Handle of the pair registered with the distance subsystem. */
+	int32 DistancePairHandle;
+};
+
 /**
  * Distance service node.
  * Finds the distance between the controlled pawn and the observed target and assigns it to a Blackboard entry.
@@ -18,6 +24,8 @@ class TPCE_API UBTService_Distance : public UBTService_BlackboardBase
 {
 	GENERATED_UCLASS_BODY()
 
+	typedef FBTDistanceServiceMemory TNodeInstanceMemory;
+
 	UPROPERTY(EditAnywhere, Category="Node")
 	FAIDistanceType GeometricDistanceType;
 
@@ -29,11 +37,19 @@ class TPCE_API UBTService_Distance : public UBTService_BlackboardBase
 	UPROPERTY(EditAnywhere, Category="Node")
 	bool bReachTestIncludesGoalRadius;
 
+	/**
+	 * If set, locations and collision cylinders are read from the shared distance subsystem which samples each actor once per frame.
+	 * Results may be up to one frame old.
+	 */
+	UPROPERTY(EditAnywhere, Category="Node", AdvancedDisplay)
+	bool bUseDistanceCache;
+
 	/** Blackboard key selector */
 	UPROPERTY(EditAnywhere, Category="Blackboard")
 	FBlackboardKeySelector Observed;
 
 	virtual void InitializeFromAsset(UBehaviorTree& Asset) override;
+	virtual uint16 GetInstanceMemorySize() const override { return sizeof(TNodeInstanceMemory); }
 	virtual FString GetStaticDescription() const override;
 #if WITH_EDITOR
 	virtual FName GetNodeIconName() const override;
@@ -41,10 +57,15 @@ class TPCE_API UBTService_Distance : public UBTService_BlackboardBase
 
 protected:
 
+	virtual void OnBecomeRelevant(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory) override;
+	virtual void OnCeaseRelevant(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory) override;
 	virtual void TickNode(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory, float DeltaSeconds) override;
+	EBlackboardNotificationResult OnObservedKeyValueChange(const UBlackboardComponent& Blackboard, FBlackboard::FKey ChangedKeyID);
 
 private:
 
+	bool CalculateDistance(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory, float& Distance) const;
+
 	float GetGeometricDistance(const FVector& A, const FVector& B, float RadiusSum, float HalfHeightSum) const;
 	static FString GetGeometricDistanceDescription(FAIDistanceType GeometricDistanceType);
 };
@@ -9,6 +9,27 @@
 
 #include "BTService_FindReachablePoint.generated.h"
 
+class AAIController;
+struct FReachablePointRequest;
+
+/** Value assigned to the blackboard entry while a deferred reachable point query is pending. */
+UENUM()
+enum class EReachablePointPendingFallback : uint8
+{
+	/** Keep the current value. */
+	KeepValue,
+	/** Use the search origin. */
+	Origin,
+	/** Clear the value. */
+	Clear,
+};
+
+struct FBTFindReachablePointMemory
+{
+	/** Id of the pending deferred query or 0 if none. */
+	uint32 QueryId;
+};
+
 /**
  * Find Reachable Point service node.
  * A service node that finds a navigation reachable point from the initial location when it becomes active.
@@ -18,6 +39,8 @@ class TPCE_API UBTService_FindReachablePoint : public UBTService_BlackboardBase
 {
 	GENERATED_UCLASS_BODY()
 
+	typedef FBTFindReachablePointMemory TNodeInstanceMemory;
+
 	/** Initial search location. "None" will use the pawn's current location. */
 	UPROPERTY(EditAnywhere, Category="Blackboard")
 	FBlackboardKeySelector Origin;
@@ -34,8 +57,28 @@ class TPCE_API UBTService_FindReachablePoint : public UBTService_BlackboardBase
 	UPROPERTY(EditAnywhere, Category="Node")
 	TSubclassOf<UNavigationQueryFilter> FilterClass;
 
+	/**
+	 * If set, the navigation query is deferred to the reachable point subsystem which limits the number of queries per frame.
+	 * The blackboard entry is assigned when the result arrives.
+	 */
+	UPROPERTY(EditAnywhere, Category="Node")
+	bool bAsyncQuery;
+
+	/** Value assigned to the blackboard entry while the deferred query is pending. */
+	UPROPERTY(EditAnywhere, Category="Node", meta=(EditCondition="bAsyncQuery"))
+	EReachablePointPendingFallback PendingFallback;
+
+	/**
+	 * If set, the point is drawn from reachable points pre-sampled around the origin's grid cell without querying the navmesh.
+	 * Until a cell has all its samples, points come from live queries that are added to the cell, or deferred ones if bAsyncQuery is set.
+	 */
+	UPROPERTY(EditAnywhere, Category="Node")
+	bool bUseCachedPoints;
+
 	virtual void InitializeFromAsset(UBehaviorTree& Asset) override;
+	virtual uint16 GetInstanceMemorySize() const override { return sizeof(TNodeInstanceMemory); }
 	virtual void OnBecomeRelevant(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory) override;
+	virtual void OnCeaseRelevant(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory) override;
 
 	virtual FString GetStaticDescription() const override;
 
@@ -46,4 +89,6 @@ class TPCE_API UBTService_FindReachablePoint : public UBTService_BlackboardBase
 protected:
 
 	bool GetRandomReachablePoint(const UBehaviorTreeComponent& OwnerComp, const FVector& InOrigin, FVector& OutRandomPoint) const;
+	FReachablePointRequest MakeReachablePointRequest(const AAIController& Controller, const FVector& InOrigin) const;
+	void OnReachablePointQueryFinished(uint32 QueryId, bool bSuccess, const FVector& Point, TWeakObjectPtr<UBehaviorTreeComponent> OwnerComp);
 };
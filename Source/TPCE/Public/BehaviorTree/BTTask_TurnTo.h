@@ -4,10 +4,43 @@
 
 #include "CoreMinimal.h"
 #include "UObject/ObjectMacros.h"
+#include "Engine/EngineTypes.h"
 #include "BehaviorTree/Tasks/BTTask_BlackboardBase.h"
 
 #include "BTTask_TurnTo.generated.h"
 
+/** How the Turn To task applies rotation to the pawn. */
+UENUM()
+enum class ETurnToRotationMode : uint8
+{
+	/** Set the actor rotation every tick. */
+	Actor,
+	/**
+	 * Hand the desired rotation to the character movement component which applies it together with movement
+	 * at MovementRotationRate. Pawns without a character movement component fall back to Actor.
+	 */
+	MovementComponent,
+};
+
+struct FBTTurnToTaskMemory
+{
+	/** Timer checking the remaining angle while driven by the movement component, or rotating the actor in the fallback. */
+	FTimerHandle TimerHandle;
+
+	/** Movement component and pawn settings overridden while the rotation is driven by the movement component. */
+	FRotator SavedRotationRate;
+	bool bSavedUseControllerDesiredRotation;
+	bool bSavedOrientRotationToMovement;
+	bool bSavedUseControllerRotationPitch;
+	bool bSavedUseControllerRotationYaw;
+	bool bSavedUseControllerRotationRoll;
+
+	bool bDrivenByMovement;
+
+	/** Set when the actor is rotated from a timer because the task doesn't tick in movement component mode. */
+	bool bDrivenByTimer;
+};
+
 /**
  * Turn To task node.
  * Rotates the AI pawn to face the specified Actor or Location blackboard entry.
@@ -17,12 +50,22 @@ class TPCE_API UBTTask_TurnTo : public UBTTask_BlackboardBase
 {
 	GENERATED_UCLASS_BODY()
 
+	typedef FBTTurnToTaskMemory TNodeInstanceMemory;
+
+	/** How rotation is applied to the pawn. */
+	UPROPERTY(EditAnywhere, Category="Node")
+	ETurnToRotationMode RotationMode;
+
 	/** Rotation speed, higher is faster. Specified in degrees per second if bConstantSpeed is set. */
-	UPROPERTY(EditAnywhere, Category="Node", meta=(ClampMin="0", UIMin="0"))
+	UPROPERTY(EditAnywhere, Category="Node", meta=(ClampMin="0", UIMin="0", EditCondition="RotationMode == ETurnToRotationMode::Actor"))
 	float Speed;
 
+	/** Rotation rate in degrees per second applied by the character movement component. */
+	UPROPERTY(EditAnywhere, Category="Node", meta=(ClampMin="0", UIMin="0", EditCondition="RotationMode == ETurnToRotationMode::MovementComponent"))
+	float MovementRotationRate;
+
 	/** If set and the controlled pawn is a character, scale speed by the current value of a curve. */
-	UPROPERTY(EditAnywhere, Category="Node")
+	UPROPERTY(EditAnywhere, Category="Node", meta=(EditCondition="RotationMode == ETurnToRotationMode::Actor"))
 	FName SpeedCurveName;
 
 	/** Stop when the angle difference is less than Tolerance degrees. Continues indefinitely if 0. */
@@ -30,15 +73,18 @@ class TPCE_API UBTTask_TurnTo : public UBTTask_BlackboardBase
 	float Tolerance;
 
 	/** If True, rotation speed is constant instead of starting strong then easing out. */
-	UPROPERTY(EditAnywhere, Category="Node")
+	UPROPERTY(EditAnywhere, Category="Node", meta=(EditCondition="RotationMode == ETurnToRotationMode::Actor"))
 	bool bConstantSpeed;
 
 	/** Rotate only on the ground plane. */
 	UPROPERTY(EditAnywhere, Category="Node")
 	bool bYawOnly;
 
+	virtual void InitializeFromAsset(UBehaviorTree& Asset) override;
+	virtual uint16 GetInstanceMemorySize() const override { return sizeof(TNodeInstanceMemory); }
 	virtual EBTNodeResult::Type ExecuteTask(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory) override;
 	virtual void TickTask(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory, float DeltaSeconds) override;
+	virtual void OnTaskFinished(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory, EBTNodeResult::Type TaskResult) override;
 	virtual FString GetStaticDescription() const override;
 
 #if WITH_EDITOR
@@ -48,4 +94,18 @@ class TPCE_API UBTTask_TurnTo : public UBTTask_BlackboardBase
 protected:
 
 	FQuat GetLookAtRotation(const FVector& StartLocation, const FVector& TargetLocation) const;
+
+	/** Rotate the actor towards the target. Return the task result if done. */
+	EBTNodeResult::Type UpdateActorRotation(UBehaviorTreeComponent& OwnerComp, float DeltaSeconds);
+
+	/** Rotate the actor every frame from a timer, for pawns without a character movement component in movement component mode. */
+	void OnActorRotationTimer(TWeakObjectPtr<UBehaviorTreeComponent> OwnerComp);
+
+	/** Start driving the rotation through the character movement component. Return False if the pawn has none. */
+	bool BeginMovementRotation(UBehaviorTreeComponent& OwnerComp, TNodeInstanceMemory& MyMemory);
+
+	/** Schedule the next tolerance check based on the remaining angle. Return the task result if done. */
+	EBTNodeResult::Type UpdateMovementRotation(UBehaviorTreeComponent& OwnerComp, TNodeInstanceMemory& MyMemory);
+
+	void OnMovementRotationTimer(TWeakObjectPtr<UBehaviorTreeComponent> OwnerComp);
 };
@@ -38,6 +38,10 @@ public:
 	UFUNCTION(BlueprintCallable, Category = UserInterface)
 	void SetWidgetComponent(UActorWidgetComponent* NewWidgetComponentOwner);
 
+	/** Request the owning component to redraw. Needed for world space widgets that only redraw when invalidated. */
+	UFUNCTION(BlueprintCallable, Category = UserInterface)
+	void InvalidateWidgetComponent();
+
 	FORCEINLINE UActorWidgetComponent* GetActorWidgetComponent() const { return ActorWidgetComponent; }
 
 	FORCEINLINE UActorWidgetComponent* GetOwningComponent() const { return GetActorWidgetComponent(); }
@@ -0,0 +1,87 @@
+// This source code is licensed under the MIT license found in the LICENSE file in the root directory of this source tree.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/ObjectMacros.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Tickable.h"
+#include "Templates/SubclassOf.h"
+
+#include "ActorWidgetPoolSubsystem.generated.h"
+
+class UUserWidget;
+class UActorWidgetComponent;
+
+/** Free widgets of a single widget class. */
+USTRUCT()
+struct FActorWidgetPool
+{
+	GENERATED_BODY()
+
+	UPROPERTY(Transient)
+	TArray<UUserWidget*> FreeWidgets;
+};
+
+/**
+ * Actor widget pool subsystem.
+ * Keeps a pool of widgets per widget class for actor widget components that have pooling enabled. Registered components
+ * are culled every frame and only hold a widget while they pass culling, so the number of live widget trees follows the
+ * number of visible widgets instead of the number of actors. Widgets are rebound to their new component through
+ * UActorWidget::SetWidgetComponent.
+ */
+UCLASS()
+class TPCE_API UActorWidgetPoolSubsystem : public UWorldSubsystem, public FTickableGameObject
+{
+	GENERATED_BODY()
+
+public:
+
+	// Begin USubsystem Interface
+	virtual void Deinitialize() override;
+	// End USubsystem Interface
+
+	// Begin FTickableGameObject Interface
+	virtual void Tick(float DeltaTime) override;
+	virtual ETickableTickType GetTickableTickType() const override;
+	virtual bool IsTickable() const override;
+	virtual TStatId GetStatId() const override;
+	virtual UWorld* GetTickableGameObjectWorld() const override { return GetWorld(); }
+	// End FTickableGameObject Interface
+
+	/** Return the subsystem of the world the object belongs to if available. */
+	static UActorWidgetPoolSubsystem* Get(const UObject* WorldContextObject);
+
+	/** Start culling a component. It acquires a widget on the next tick it passes culling. */
+	void RegisterComponent(UActorWidgetComponent* Component);
+
+	/** Stop culling a component and return its widget to the pool. */
+	void UnregisterComponent(UActorWidgetComponent* Component);
+
+	/** Take a free widget of the given class from the pool or create one. */
+	UUserWidget* AcquireWidget(TSubclassOf<UUserWidget> WidgetClass);
+
+	/** Return a widget to the pool of its class. Widgets over the pool size limit are left to garbage collection. */
+	void ReleaseWidget(UUserWidget* Widget);
+
+	/** Create widgets of the given class until the pool holds Count free widgets. */
+	UFUNCTION(BlueprintCallable, Category=UserInterface)
+	void PrewarmPool(TSubclassOf<UUserWidget> WidgetClass, int32 Count);
+
+	/** Return the number of free widgets of the given class. */
+	UFUNCTION(BlueprintCallable, Category=UserInterface)
+	int32 GetNumFreeWidgets(TSubclassOf<UUserWidget> WidgetClass) const;
+
+private:
+
+	struct FRegisteredComponent
+	{
+		TWeakObjectPtr<UActorWidgetComponent> Component;
+		float LastRelevantTime;
+	};
+
+	TArray<FRegisteredComponent> RegisteredComponents;
+
+	UPROPERTY(Transient)
+	TMap<UClass*, FActorWidgetPool> Pools;
+};
@@ -0,0 +1,92 @@
+// This source code is licensed under the MIT license found in the LICENSE file in the root directory of this source tree.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/ObjectMacros.h"
+#include "Subsystems/WorldSubsystem.h"
+
+#include "WidgetAtlasSubsystem.generated.h"
+
+class UTextureRenderTarget2D;
+
+/** Region of a widget atlas page allocated to a single widget. */
+struct TPCE_API FWidgetAtlasSlot
+{
+	int32 PageIndex;
+	FIntRect Rect;
+
+	FWidgetAtlasSlot()
+		: PageIndex(INDEX_NONE)
+		, Rect(0, 0, 0, 0)
+	{
+	}
+
+	bool IsValid() const { return PageIndex != INDEX_NONE; }
+};
+
+/**
+ * Widget atlas subsystem.
+ * Shares a few large render targets between world space widget components so that many widgets don't need a render
+ * target each. Pages are packed in shelves, rows of slots of similar height. Released slots are kept in their shelf and
+ * handed out again to widgets that fit. Slot contents persist until the owning widget redraws, so widgets that don't
+ * redraw cost nothing but their share of the page.
+ */
+UCLASS()
+class TPCE_API UWidgetAtlasSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+
+	// Begin USubsystem Interface
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+	// End USubsystem Interface
+
+	/** Return the subsystem of the world the object belongs to if available. */
+	static UWidgetAtlasSubsystem* Get(const UObject* WorldContextObject);
+
+	/** Allocate a slot of at least the given size. Return an invalid slot if the size doesn't fit in a page or all pages are full. */
+	FWidgetAtlasSlot AllocateSlot(FIntPoint Size);
+
+	/** Return a slot to its page. The slot is reset. */
+	void ReleaseSlot(FWidgetAtlasSlot& Slot);
+
+	/** Return the render target of a page. */
+	UTextureRenderTarget2D* GetPageRenderTarget(int32 PageIndex) const { return Pages.IsValidIndex(PageIndex) ? Pages[PageIndex] : nullptr; }
+
+	/** Return the size of every page. */
+	int32 GetPageSize() const { return PageSize; }
+
+	/** Clear a slot to transparent on the render thread. */
+	void ClearSlot(const FWidgetAtlasSlot& Slot) const;
+
+private:
+
+	struct FShelf
+	{
+		int32 Y;
+		int32 Height;
+		int32 UsedWidth;
+		TArray<FIntRect> FreeRects;
+	};
+
+	struct FPageLayout
+	{
+		TArray<FShelf> Shelves;
+		int32 UsedHeight;
+	};
+
+	UPROPERTY(Transient)
+	TArray<UTextureRenderTarget2D*> Pages;
+
+	TArray<FPageLayout> PageLayouts;
+
+	// Settings read from console variables on initialization
+	int32 PageSize;
+	int32 MaxPages;
+
+	bool AllocateInPage(FPageLayout& Layout, FIntPoint Size, FIntRect& OutRect) const;
+	int32 AddPage();
+};
@@ -16,6 +16,10 @@ class TPCE_API AExtPlayerCameraManager : public APlayerCameraManager
 	GENERATED_BODY()
 
 public:
+	// Begin APlayerCameraManager Interface
+	virtual void UpdateCamera(float DeltaTime) override;
+	// End APlayerCameraManager Interface
+
 	/** Get the time remaining in viewtarget blend. */
 	UFUNCTION(BlueprintCallable, Category=PlayerCameraManager)
 	float GetBlendTimeToGo() const;
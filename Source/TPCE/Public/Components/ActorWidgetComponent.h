@@ -4,10 +4,12 @@
 
 #include "CoreMinimal.h"
 #include "Components/WidgetComponent.h"
+#include "Components/WidgetRedrawPolicy.h"
 
 #include "ActorWidgetComponent.generated.h"
 
 class UActorWidget;
+class UActorWidgetPoolSubsystem;
 
 /**
  * A specialized widget component that supports actor widgets and auto assignment to player.
@@ -26,7 +28,31 @@ protected:
 	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = UserInterface)
 	TEnumAsByte<EAutoReceiveInput::Type> AutoAssignPlayer;
 
+	/** If True, the widget is taken from a per-class pool while the component passes culling and returned to it when culled. */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = UserInterface)
+	bool bPoolWidget;
+
+	/** Distance from the player's view beyond which the pooled widget is released. Distance culling disabled if 0. */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = UserInterface, meta = (EditCondition = "bPoolWidget", ClampMin = "0", UIMin = "0"))
+	float PoolCullDistance;
+
+	/** If True, the pooled widget is released while the component is off-screen. */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = UserInterface, meta = (EditCondition = "bPoolWidget"))
+	bool bPoolCullOffScreen;
+
+	/** Fraction of the viewport size the component may be outside of the screen before it is culled. */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = UserInterface, meta = (EditCondition = "bPoolWidget && bPoolCullOffScreen", ClampMin = "0", UIMin = "0"))
+	float PoolOffScreenMargin;
+
+	/** Limits when the render target is redrawn. Only relevant in world space. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = UserInterface)
+	FWidgetRedrawPolicy RedrawPolicy;
+
+	/** Whether the component is registered with the widget pool. */
+	bool bRegisteredToPool;
+
 	virtual void OnHiddenInGameChanged() override;
+	virtual bool ShouldDrawWidget() const override;
 	virtual void OnVisibilityChanged() override;
 
 	UFUNCTION()
@@ -48,7 +74,17 @@ public:
 #endif
 
 	virtual void OnRegister() override;
+	virtual void OnUnregister() override;
 
 	virtual void InitWidget() override;
 	virtual void SetWidget(UUserWidget* InWidget) override;
+
+	/** Whether the component should hold a widget. Only used with pooled widgets. */
+	virtual bool PassesWidgetCulling() const;
+
+	/** Take a widget from the pool if the component doesn't have one yet. */
+	void AcquirePooledWidget(UActorWidgetPoolSubsystem& Pool);
+
+	/** Return the widget to the pool. */
+	void ReleasePooledWidget(UActorWidgetPoolSubsystem& Pool);
 };
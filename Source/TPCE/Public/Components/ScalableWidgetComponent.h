@@ -4,6 +4,8 @@
 
 #include "CoreMinimal.h"
 #include "Components/WidgetComponent.h"
+#include "Blueprint/WidgetAtlasSubsystem.h"
+#include "Components/WidgetRedrawPolicy.h"
 
 #include "ScalableWidgetComponent.generated.h"
 
@@ -20,10 +22,18 @@ class TPCE_API UScalableWidgetComponent : public UWidgetComponent
 public:
 	UScalableWidgetComponent();
 
+	// Begin UActorComponent Interface
+	virtual void OnUnregister() override;
+	virtual void TickComponent(float DeltaTime, enum ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
+	// End UActorComponent Interface
+
 	// Begin UWidgetComponent Interface
 	virtual void UpdateRenderTarget(FIntPoint DesiredRenderTargetSize) override;
 	// End UWidgetComponent Interface
 
+	/** Name of the material vector parameter that receives the widget's region of the atlas as (U, V, Width, Height). */
+	static const FName AtlasUVRectParameterName;
+
 	UPROPERTY(BlueprintAssignable, Category=UserInterface)
 	FDrawSizeChanged OnDrawSizeChanged;
 
@@ -31,15 +41,66 @@ public:
 	UFUNCTION(BlueprintCallable, Category=UserInterface)
 	float GetRenderScale() const { return RenderScale; }
 
-	/** Sets the render scale to use for this widget. */
+	/** Sets the render scale to use for this widget. Has no lasting effect while the render scale is automatic. */
 	UFUNCTION(BlueprintCallable, Category=UserInterface)
 	void SetRenderScale(const float NewRenderScale);
 
+	/** Enables or disables picking the render scale from the widget's size on screen. */
+	UFUNCTION(BlueprintCallable, Category=UserInterface)
+	void SetAutoRenderScale(bool bEnabled);
+
 protected:
 	/** Scale of internal render target. */
 	UPROPERTY(EditAnywhere, Category=UserInterface, meta=(ClampMin=0))
 	float RenderScale;
 
+	/**
+	 * If True, a world space widget picks its render scale every frame from the tiers below based on its projected size
+	 * on screen, so that the render target resolution follows what is actually visible.
+	 */
+	UPROPERTY(EditAnywhere, Category=UserInterface)
+	bool bAutoRenderScale;
+
+	/** Render scales to pick from when the render scale is automatic. The smallest tier that covers the projected size is used. */
+	UPROPERTY(EditAnywhere, Category=UserInterface, meta=(EditCondition="bAutoRenderScale"))
+	TArray<float> RenderScaleTiers;
+
+	/**
+	 * Fraction by which the projected scale has to drop below a lower tier before switching to it.
+	 * Keeps the render target from being reallocated back and forth around a tier boundary.
+	 */
+	UPROPERTY(EditAnywhere, Category=UserInterface, meta=(EditCondition="bAutoRenderScale", ClampMin="0", UIMin="0", UIMax="1"))
+	float RenderScaleHysteresis;
+
+	/**
+	 * If True, a world space widget renders into a region of a render target shared with other widgets instead of its own.
+	 * The material must sample the widget texture through the AtlasUVRect parameter. Falls back to a dedicated render
+	 * target if the atlas is full.
+	 */
+	UPROPERTY(EditAnywhere, Category=UserInterface)
+	bool bUseRenderTargetAtlas;
+
+	/** Limits when the render target is redrawn. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category=UserInterface)
+	FWidgetRedrawPolicy RedrawPolicy;
+
+	/** Region of the atlas owned by this widget, if any. */
+	FWidgetAtlasSlot AtlasSlot;
+
+	/** Size of the region of the atlas slot that is drawn to. */
+	FIntPoint AtlasDrawSize;
+
+	virtual bool ShouldDrawWidget() const override;
 	virtual void DrawWidgetToRenderTarget(float DeltaTime) override;
 	bool UpdateDrawSize();
+
+	/** Make sure an atlas slot of the given size is allocated. Return False if the widget should use its own render target. */
+	bool UpdateAtlasSlot(FIntPoint DesiredSize);
+	void ReleaseAtlasSlot();
+
+	/** Return the render scale at which one render target pixel covers one screen pixel, or a negative value if unknown. */
+	float GetProjectedRenderScale() const;
+
+	/** Pick a tier for the projected render scale. */
+	void UpdateAutoRenderScale();
 };
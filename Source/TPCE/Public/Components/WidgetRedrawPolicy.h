@@ -0,0 +1,74 @@
+// This source code is licensed under the MIT license found in the LICENSE file in the root directory of this source tree.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/ObjectMacros.h"
+
+#include "WidgetRedrawPolicy.generated.h"
+
+class UWidgetComponent;
+
+/** Maximum redraw rate of a widget up to a distance from the view. */
+USTRUCT(BlueprintType)
+struct TPCE_API FWidgetRedrawRate
+{
+	GENERATED_BODY()
+
+	/** Distance from the view up to which this rate applies. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category=UserInterface, meta=(ClampMin="0", UIMin="0"))
+	float MaxDistance;
+
+	/** Maximum number of redraws per second. The widget is frozen after its first draw if 0. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category=UserInterface, meta=(ClampMin="0", UIMin="0"))
+	float MaxRedrawRate;
+
+	FWidgetRedrawRate()
+		: MaxDistance(0.f)
+		, MaxRedrawRate(0.f)
+	{
+	}
+
+	FWidgetRedrawRate(float InMaxDistance, float InMaxRedrawRate)
+		: MaxDistance(InMaxDistance)
+		, MaxRedrawRate(InMaxRedrawRate)
+	{
+	}
+};
+
+/**
+ * Limits when a widget component redraws its render target.
+ * Applied on top of the component's own redraw time, and only relevant to widgets that draw to a render target.
+ */
+USTRUCT(BlueprintType)
+struct TPCE_API FWidgetRedrawPolicy
+{
+	GENERATED_BODY()
+
+	/**
+	 * If True, the widget only redraws when invalidated: on its first draw, when a redraw is requested (see RequestRedraw)
+	 * or while a widget animation is playing. Widgets that change their content should request a redraw.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category=UserInterface)
+	bool bRedrawOnInvalidationOnly;
+
+	/**
+	 * Maximum redraw rates by distance from the view, e.g. 60 Hz up to 10m, 10 Hz up to 30m.
+	 * Widgets beyond the last distance are frozen after their first draw. Redraw rate is not limited if empty.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category=UserInterface)
+	TArray<FWidgetRedrawRate> DistanceRedrawRates;
+
+	FWidgetRedrawPolicy()
+		: bRedrawOnInvalidationOnly(false)
+	{
+	}
+
+	/** Return whether the component may redraw now. Assumes the component's own redraw conditions are met. */
+	bool CanRedraw(const UWidgetComponent& Component, bool bRedrawRequested, double LastRedrawTime, double CurrentTime) const;
+
+private:
+
+	/** Return the maximum redraw rate for the distance of the component to the view, or a negative value if unlimited. */
+	float GetMaxRedrawRate(const UWidgetComponent& Component) const;
+};
@@ -124,6 +124,20 @@ public:
 	UFUNCTION(BlueprintCallable, Category="Input")
 	void GetInputBindingDescriptions(TArray<FInputBindingDescription>& OutInputBindingDescriptions);
 
+	/** Get the description of the key mappings of an action. Return false if the action has no description or no key for InputDevices. */
+	UFUNCTION(BlueprintCallable, Category="Input")
+	bool GetInputBindingDescriptionForAction(FName ActionName, FInputBindingDescription& OutInputBindingDescription);
+
+	/**
+	 * Rebuild input binding descriptions on next request. Needed after remapping keys or changing binding descriptions,
+	 * changes to the input stack, the pawn input component and InputDevices are detected automatically.
+	 */
+	UFUNCTION(BlueprintCallable, Category="Input")
+	void InvalidateInputBindingDescriptions();
+
+	/** Return the cached input binding descriptions, rebuilt if outdated. */
+	const TArray<FInputBindingDescription>& GetCachedInputBindingDescriptions();
+
 	/** Occurs when the input stack is changed. */
 	UPROPERTY(BlueprintAssignable, Category="Input")
 	FInputStackChangedSignature OnInputStackChanged;
@@ -184,6 +198,7 @@ protected:
 
 	EPlayerControllerInputDevices GetKeyInputDevices(FKey Key);
 	void UpdateViewExtents();
+	void UpdateInputBindingDescriptions();
 
 	UPROPERTY(Transient)
 	AActor* OldViewTarget;
@@ -196,4 +211,11 @@ protected:
 	FVector ViewExtentsMax;
 	bool bViewExtentsValid;
 	FMatrix OverlayTransform;
+
+	// Input binding descriptions of the current input stack, indexed by action
+	TArray<FInputBindingDescription> InputBindingDescriptions;
+	TMap<FName, int32> InputBindingDescriptionIndices;
+	TWeakObjectPtr<UInputComponent> DescribedPawnInputComponent;
+	int32 DescribedInputDevices;
+	bool bInputBindingDescriptionsDirty;
 };
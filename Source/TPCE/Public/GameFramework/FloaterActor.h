@@ -4,7 +4,6 @@
 
 #include "CoreMinimal.h"
 #include "GameFramework/Actor.h"
-#include "Components/TimelineComponent.h"
 
 #include "FloaterActor.generated.h"
 
@@ -31,7 +30,7 @@ public:
 
 	// Begin AActor Interface
 	virtual void BeginPlay() override;
-	virtual void Tick(float DeltaTime) override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 	virtual void SetActorHiddenInGame(bool bNewHidden) override;
 	// End AActor Interface
 
@@ -70,9 +69,15 @@ protected:
 	/** Name of the movement component. */
 	static FName PushToTargetName;
 
-	void OnTimelineProgress(FLinearColor Value);
-	void OnTimelineFinished();
+	/** Play a curve through the floater animation subsystem. Finishes immediately if it can't be played. */
+	void PlayAnimation(class UCurveLinearColor* Curve, bool bReverse);
 
-	FTimeline PopUpTimeline;
-	FTimeline PopInTimeline;
+	/** Stop any animation in progress. */
+	void StopAnimation();
+
+	void ApplyAnimationValue(const FLinearColor& Value);
+	void OnAnimationFinished();
+
+	// Animations are played by the subsystem
+	friend class UFloaterAnimationSubsystem;
 };
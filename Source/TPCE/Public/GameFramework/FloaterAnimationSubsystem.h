@@ -0,0 +1,91 @@
+// This source code is licensed under the MIT license found in the LICENSE file in the root directory of this source tree.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/ObjectMacros.h"
+#include "UObject/ObjectKey.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Tickable.h"
+
+#include "FloaterAnimationSubsystem.generated.h"
+
+class AFloaterActor;
+class UCurveLinearColor;
+
+/**
+ * Floater animation subsystem.
+ * Plays the show and hide animations of all floaters so that floaters don't need to tick. Curves are baked into samples
+ * the first time they're used, then all playing animations are advanced and sampled in a single pass over flat arrays
+ * before the results are applied to their floaters. Floaters that aren't animating are not touched at all.
+ */
+UCLASS()
+class TPCE_API UFloaterAnimationSubsystem : public UWorldSubsystem, public FTickableGameObject
+{
+	GENERATED_BODY()
+
+public:
+
+	// Begin USubsystem Interface
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+	// End USubsystem Interface
+
+	// Begin FTickableGameObject Interface
+	virtual void Tick(float DeltaTime) override;
+	virtual ETickableTickType GetTickableTickType() const override;
+	virtual bool IsTickable() const override;
+	virtual TStatId GetStatId() const override;
+	virtual UWorld* GetTickableGameObjectWorld() const override { return GetWorld(); }
+	// End FTickableGameObject Interface
+
+	/** Return the subsystem of the world the object belongs to if available. */
+	static UFloaterAnimationSubsystem* Get(const UObject* WorldContextObject);
+
+	/**
+	 * Play a curve on a floater, replacing any animation it was playing.
+	 * If bReverse is True and the floater is already playing the same curve, it is played back from the current position,
+	 * otherwise it is played back from the end. Return False if the curve can't be played.
+	 */
+	bool Play(AFloaterActor* Floater, const UCurveLinearColor* Curve, float PlayRate, bool bReverse = false);
+
+	/** Stop the animation of a floater without notifying it. */
+	void Stop(AFloaterActor* Floater);
+
+	/** Return whether a floater is animating. */
+	bool IsPlaying(const AFloaterActor* Floater) const { return AnimationLookup.Contains(Floater); }
+
+	/** Return the number of floaters animating. */
+	int32 GetNumAnimations() const { return Floaters.Num(); }
+
+private:
+
+	struct FBakedCurve
+	{
+		TArray<FLinearColor> Samples;
+		float Duration;
+	};
+
+	/** Return the index of the baked curve, baking it first if needed. */
+	int32 FindOrBakeCurve(const UCurveLinearColor* Curve);
+
+	/** Sample a baked curve at the given time with linear interpolation between samples. */
+	FLinearColor SampleCurve(const FBakedCurve& BakedCurve, float Time) const;
+
+	void RemoveAnimation(int32 Index);
+
+	TArray<FBakedCurve> BakedCurves;
+	TMap<TObjectKey<UCurveLinearColor>, int32> BakedCurveLookup;
+
+	// Playing animations, one entry per floater
+	TArray<TWeakObjectPtr<AFloaterActor>> Floaters;
+	TArray<TObjectKey<AFloaterActor>> FloaterKeys;
+	TArray<int32> CurveIndices;
+	TArray<float> Times;
+	TArray<float> PlayRates;
+	TArray<FLinearColor> Values;
+	TMap<TObjectKey<AFloaterActor>, int32> AnimationLookup;
+
+	// Settings read from console variables on initialization
+	float SampleRate;
+};
@@ -7,6 +7,7 @@
 #include "UObject/UObjectGlobals.h"
 #include "UObject/Object.h"
 #include "Jobs/AIJobsComponent.h"
+#include "Jobs/AIJobStats.h"
 
 #include "AIJob.generated.h"
 
@@ -71,6 +72,14 @@ public:
 	UFUNCTION(BlueprintCallable, Category="AI|Jobs", meta=(DisplayName="Get AI Owner", KeyWords="controller aicontroller"))
 	AAIController* GetAIOwner() const { return JobsComponent ? JobsComponent->GetAIOwner() : nullptr; }
 
+#if WITH_AIJOB_STATS
+	/** Get the accumulated timing of the job's native and blueprint functions. */
+	const FAIJobStats& GetJobStats() const { return JobStats; }
+
+	/** Clear the accumulated timing. */
+	void ResetJobStats() { JobStats.Reset(); }
+#endif // WITH_AIJOB_STATS
+
 #if WITH_GAMEPLAY_DEBUGGER
 	virtual void DescribeSelfToGameplayDebugger(FGameplayDebuggerCategory* DebuggerCategory) const;
 #endif // WITH_GAMEPLAY_DEBUGGER
@@ -115,6 +124,11 @@ protected:
 	float TimeBecameInactive;
 	mutable FString CachedJobName;
 
+#if WITH_AIJOB_STATS
+	// Mutable since scoring is const
+	mutable FAIJobStats JobStats;
+#endif // WITH_AIJOB_STATS
+
 	// AIJobsComponent sets TimeBecameInactive to the current time on registering
 	friend class UAIJobsComponent;
 };
@@ -0,0 +1,110 @@
+// This source code is licensed under the MIT license found in the LICENSE file in the root directory of this source tree.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/PlatformTime.h"
+
+/** Per-job profiling is compiled out of shipping builds. */
+#ifndef WITH_AIJOB_STATS
+#define WITH_AIJOB_STATS !UE_BUILD_SHIPPING
+#endif
+
+namespace EAIJobStat
+{
+	enum Type
+	{
+		Score,
+		Tick,
+		BeginJob,
+		EndJob,
+		Num
+	};
+}
+
+/** Accumulated timing of a single job function. Blueprint time is included in the total. */
+struct TPCE_API FAIJobStatEntry
+{
+	int32 Count;
+	double TotalSeconds;
+	double BlueprintSeconds;
+	double MaxSeconds;
+
+	FAIJobStatEntry()
+	{
+		Reset();
+	}
+
+	void Reset()
+	{
+		Count = 0;
+		TotalSeconds = 0.0;
+		BlueprintSeconds = 0.0;
+		MaxSeconds = 0.0;
+	}
+
+	double GetAverageSeconds() const { return Count > 0 ? TotalSeconds / Count : 0.0; }
+	double GetNativeSeconds() const { return FMath::Max(0.0, TotalSeconds - BlueprintSeconds); }
+};
+
+/** Timing of all profiled functions of a job. */
+struct TPCE_API FAIJobStats
+{
+	FAIJobStatEntry Entries[EAIJobStat::Num];
+
+	void Reset();
+
+	FAIJobStatEntry& operator[](EAIJobStat::Type Stat) { return Entries[Stat]; }
+	const FAIJobStatEntry& operator[](EAIJobStat::Type Stat) const { return Entries[Stat]; }
+
+	/** Return the display name of a stat. */
+	static const TCHAR* GetStatName(EAIJobStat::Type Stat);
+
+	/** Return the CSV header matching the columns of AppendCSV. */
+	static FString GetCSVHeader();
+
+	/** Append a CSV row per stat to Out. */
+	void AppendCSV(const FString& OwnerName, const FString& JobName, FString& Out) const;
+};
+
+/** Scoped timer that accumulates into a job stat entry. */
+class FAIJobScopedStat
+{
+public:
+
+	FAIJobScopedStat(FAIJobStatEntry& InEntry, bool bInBlueprint)
+		: Entry(InEntry)
+		, StartCycles(FPlatformTime::Cycles64())
+		, bBlueprint(bInBlueprint)
+	{
+	}
+
+	~FAIJobScopedStat()
+	{
+		const double Seconds = FPlatformTime::ToSeconds64(FPlatformTime::Cycles64() - StartCycles);
+		if (bBlueprint)
+		{
+			Entry.BlueprintSeconds += Seconds;
+		}
+		else
+		{
+			Entry.Count++;
+			Entry.TotalSeconds += Seconds;
+			Entry.MaxSeconds = FMath::Max(Entry.MaxSeconds, Seconds);
+		}
+	}
+
+private:
+
+	FAIJobStatEntry& Entry;
+	uint64 StartCycles;
+	bool bBlueprint;
+};
+
+#if WITH_AIJOB_STATS
+#define SCOPE_AIJOB_STAT(Stats, Stat) FAIJobScopedStat PREPROCESSOR_JOIN(AIJobScopedStat_, __LINE__)((Stats)[Stat], false)
+#define SCOPE_AIJOB_BLUEPRINT_STAT(Stats, Stat) FAIJobScopedStat PREPROCESSOR_JOIN(AIJobScopedStat_, __LINE__)((Stats)[Stat], true)
+#else
+#define SCOPE_AIJOB_STAT(Stats, Stat)
+#define SCOPE_AIJOB_BLUEPRINT_STAT(Stats, Stat)
+#endif // WITH_AIJOB_STATS
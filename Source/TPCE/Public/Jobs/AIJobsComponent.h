@@ -5,6 +5,7 @@
 #include "CoreMinimal.h"
 #include "Components/ActorComponent.h"
 #include "Templates/SubclassOf.h"
+#include "Jobs/AIJobStats.h"
 
 #include "AIJobsComponent.generated.h"
 
@@ -83,6 +84,17 @@ public:
 	UFUNCTION(BlueprintCallable, Category="AI|Jobs")
 	virtual void AbandonCurrentJob();
 
+#if WITH_AIJOB_STATS
+	/** Get the accumulated timing of job evaluations, including scoring and job changes. */
+	const FAIJobStatEntry& GetEvaluationStats() const { return EvaluationStats; }
+
+	/** Clear the accumulated timing of the component and all of its jobs. */
+	void ResetJobStats();
+
+	/** Append a CSV row per job stat to Out. See FAIJobStats::GetCSVHeader. */
+	void AppendJobStatsCSV(FString& Out) const;
+#endif // WITH_AIJOB_STATS
+
 #if WITH_GAMEPLAY_DEBUGGER
 	virtual void DescribeSelfToGameplayDebugger(FGameplayDebuggerCategory* DebuggerCategory) const;
 #endif // WITH_GAMEPLAY_DEBUGGER
@@ -97,4 +109,8 @@ protected:
 
 	/** Timer handle for EvaluateJobs function. */
 	FTimerHandle TimerHandle_EvaluateJobs;
+
+#if WITH_AIJOB_STATS
+	FAIJobStatEntry EvaluationStats;
+#endif // WITH_AIJOB_STATS
 };
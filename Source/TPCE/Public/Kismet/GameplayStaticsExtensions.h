@@ -4,9 +4,53 @@
 
 #include "Kismet/GameplayStatics.h"
 #include "GenericTeamAgentInterface.h"
+#include "Engine/Canvas.h"
+#include "CanvasItem.h"
 
 #include "GameplayStaticsExtensions.generated.h"
 
+/**
+ * Retained polyline geometry for drawing the same polyline on a canvas every frame.
+ * Triangles are only rebuilt when the points, thickness or tiling change.
+ */
+USTRUCT(BlueprintType)
+struct TPCE_API FPolylineMesh
+{
+	GENERATED_BODY()
+
+	FPolylineMesh()
+		: Thickness(0.f)
+		, UTiling(0.f)
+		, TriangleItem(FVector2D::ZeroVector, FVector2D::ZeroVector, FVector2D::ZeroVector, nullptr)
+	{
+		TriangleItem.bFreezeTime = false;
+	}
+
+	/** Rebuild the triangles if any input changed. Return True if rebuilt. */
+	bool Update(const TArray<FVector2D>& InPoints, float InThickness, float InUTiling);
+
+	/** Discard the geometry. */
+	void Reset();
+
+	/** Draw the triangles on a canvas. */
+	void Draw(UCanvas* Canvas, class UMaterialInterface* RenderMaterial) const;
+
+	const TArray<FCanvasUVTri>& GetTriangles() const { return TriangleItem.TriangleList; }
+	bool IsEmpty() const { return TriangleItem.TriangleList.Num() == 0; }
+
+	/** Triangulate a miter joined polyline. */
+	static void BuildTriangles(const TArray<FVector2D>& Points, float Thickness, float UTiling, TArray<FCanvasUVTri>& OutTriangles);
+
+private:
+
+	TArray<FVector2D> Points;
+	float Thickness;
+	float UTiling;
+
+	// Holds the triangles so that drawing doesn't copy them, only the material changes between draws
+	mutable FCanvasTriangleItem TriangleItem;
+};
+
 
 UCLASS()
 class TPCE_API UGameplayStaticsEx : public UGameplayStatics
@@ -59,6 +103,25 @@ public:
 	UFUNCTION(BlueprintCallable, Category="Canvas")
 	static void DrawPolyline(class UCanvas* InCanvas, class UMaterialInterface* RenderMaterial, const TArray<FVector2D>& Points, float Thickness = 1.f, float UTiling = 100.f);
 
+	/**
+	 * Updates retained polyline geometry. The geometry is only rebuilt if an input changed since the last update.
+	 *
+	 * @param Points					Array of vertices.
+	 * @param Thickness					Screen space width of the line.
+	 * @param UTiling					Scale of the U coordinates generated along the line.
+	 * @return							True if the geometry was rebuilt.
+	 */
+	UFUNCTION(BlueprintCallable, Category="Canvas")
+	static bool UpdatePolylineMesh(UPARAM(ref) FPolylineMesh& PolylineMesh, const TArray<FVector2D>& Points, float Thickness = 1.f, float UTiling = 100.f);
+
+	/**
+	 * Draws retained polyline geometry on the Canvas.
+	 *
+	 * @param RenderMaterial			Material to use when rendering. Material should be Masked Unlit with Opacity Mask Clip 0.001f and flagged for Editor Compositing usage.
+	 */
+	UFUNCTION(BlueprintCallable, Category="Canvas")
+	static void DrawPolylineMesh(class UCanvas* InCanvas, class UMaterialInterface* RenderMaterial, const FPolylineMesh& PolylineMesh);
+
 	/**
 	 * Draws a connected sequence of chamfer joined line segments.
 	 *
@@ -71,4 +134,14 @@ public:
 	 */
 	UFUNCTION(BlueprintCallable, Category="Canvas")
 	static void DrawChamferedPolyline(class UCanvas* InCanvas, class UMaterialInterface* RenderMaterial, const TArray<FVector2D>& Points, float Thickness = 1.f, float UTiling = 100.f, float Radius = 0.f, float Step = 10.f);
+
+	/**
+	 * Returns the chamfered points of a polyline as drawn by DrawChamferedPolyline.
+	 * Results are memoized by input, so tessellating the same polyline again is a lookup. Results that go unused for
+	 * a few frames are released. Game thread only. The returned array is valid until the next call.
+	 *
+	 * @param Radius					Chamfer radius.
+	 * @param Step						Chamfer resolution in degrees.
+	 */
+	static const TArray<FVector2D>& GetChamferedPolyline(const TArray<FVector2D>& Points, float Radius, float Step);
 };
@@ -0,0 +1,112 @@
+// This source code is licensed under the MIT license found in the LICENSE file in the root directory of this source tree.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/BitArray.h"
+#include "Math/Bounds.h"
+#include "Math/IntBox.h"
+
+/**
+ * Array of integer boxes stored as structure of arrays, to test a box against many boxes four at a time.
+ * Tests fill a bit mask with a bit per box, for broadphase-like filtering before exact tests.
+ * Invalid boxes are stored empty so that they never pass tests and don't contribute to merged bounds.
+ */
+class TPCE_API FIntBoxArray
+{
+public:
+
+	FIntBoxArray();
+
+	int32 Num() const { return NumBoxes; }
+
+	void Reset();
+	void Reserve(int32 Number);
+
+	/** Add a box and return its index. */
+	int32 Add(const FIntBox& Box);
+
+	void Set(int32 Index, const FIntBox& Box);
+	FIntBox Get(int32 Index) const;
+
+	/**
+	 * Find the boxes intersecting a box, as FIntBox::Intersect.
+	 * @return The number of boxes found.
+	 */
+	int32 Intersect(const FIntBox& Box, TBitArray<>& OutMask) const;
+
+	/**
+	 * Find the boxes fully encapsulated by a box, as FIntBox::IsInside.
+	 * @return The number of boxes found.
+	 */
+	int32 IsInside(const FIntBox& Box, TBitArray<>& OutMask) const;
+
+	/** Return the bounds of all valid boxes, as adding them to an invalid box. */
+	FIntBox GetBounds() const;
+
+private:
+
+	enum EComponent
+	{
+		MinX,
+		MinY,
+		MinZ,
+		MaxX,
+		MaxY,
+		MaxZ,
+		NumComponents
+	};
+
+	/** Components of the boxes, padded to a multiple of four with empty boxes. */
+	TArray<int32> Components[NumComponents];
+
+	int32 NumBoxes;
+};
+
+/**
+ * Array of float bounds stored as structure of arrays, to clamp, expand or test many bounds four at a time.
+ * Reversed bounds are handled like FBounds does.
+ */
+class TPCE_API FBoundsArray
+{
+public:
+
+	FBoundsArray();
+
+	int32 Num() const { return NumBounds; }
+
+	void Reset();
+	void Reserve(int32 Number);
+
+	/** Add bounds and return their index. */
+	int32 Add(const FBounds& Bounds);
+
+	void Set(int32 Index, const FBounds& Bounds);
+	FBounds Get(int32 Index) const;
+
+	/**
+	 * Find the bounds containing a value, as FBounds::Contains.
+	 * @return The number of bounds found.
+	 */
+	int32 Contains(float Value, TBitArray<>& OutMask) const;
+
+	/** Clamp both ends of all bounds to a range. */
+	void Clamp(const FBounds& Range);
+
+	/** Expand all bounds to both sides, as FBounds::Expand. */
+	void Expand(float ExpandAmount);
+
+	/** Add a value to both ends of all bounds. */
+	void Offset(float Value);
+
+	/** Multiply both ends of all bounds by a value. */
+	void Scale(float Value);
+
+private:
+
+	/** Ends of the bounds, padded to a multiple of four with zeros. */
+	TArray<float> LowerBounds;
+	TArray<float> UpperBounds;
+
+	int32 NumBounds;
+};
@@ -0,0 +1,466 @@
+// This source code is licensed under the MIT license found in the LICENSE file in the root directory of this source tree.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Algo/Find.h"
+#include "Containers/SparseArray.h"
+#include "Math/IntBox.h"
+
+/**
+ * Sparse grid indexing elements bounded by integer boxes, for cheap spatial queries that don't go through physics.
+ *
+ * Cells are hashed by their coordinates so only occupied cells use memory. Each cell lists its elements in fixed
+ * size chunks taken from a pool shared by all cells, so inserting and removing doesn't allocate once the pool is warm.
+ * Elements are referenced by ids that stay valid until they are removed.
+ *
+ * Queries are const and don't modify the grid, so they can run on several threads as long as nothing is updated.
+ * Elements spanning many cells are listed in each of them, pick a cell size close to the size of typical elements.
+ */
+template<typename ElementType>
+class TIntBoxGrid
+{
+public:
+
+	/**
+	 * @param InCellSize Size of the cells along each axis, in the units of the boxes.
+	 */
+	explicit TIntBoxGrid(int32 InCellSize = 1000)
+		: CellSize(FMath::Max(InCellSize, 1))
+		, FreeChunk(INDEX_NONE)
+	{ }
+
+	int32 GetCellSize() const { return CellSize; }
+
+	/** Return the number of elements. */
+	int32 Num() const { return Elements.Num(); }
+
+	/** Return the number of occupied cells. */
+	int32 NumCells() const { return Cells.Num(); }
+
+	bool IsValidId(int32 Id) const { return Elements.IsValidIndex(Id); }
+
+	ElementType& GetElement(int32 Id) { return Elements[Id].Value; }
+	const ElementType& GetElement(int32 Id) const { return Elements[Id].Value; }
+
+	const FIntBox& GetBox(int32 Id) const { return Elements[Id].Box; }
+
+	/** Add an element and return its id. */
+	int32 Add(const FIntBox& Box, const ElementType& Value)
+	{
+		const int32 Id = Elements.Add(FElement{ Value, Box });
+		LinkElement(Id, GetCellRange(Box));
+		return Id;
+	}
+
+	/** Move an element, only the cells it enters or leaves are updated. */
+	void Update(int32 Id, const FIntBox& Box)
+	{
+		FElement& Element = Elements[Id];
+		const FIntBox OldRange = GetCellRange(Element.Box);
+		const FIntBox NewRange = GetCellRange(Box);
+		Element.Box = Box;
+
+		if (OldRange != NewRange)
+		{
+			ForEachCell(OldRange, [this, Id, &NewRange](const FIntVector& Cell)
+			{
+				if (!IsInsideCellRange(NewRange, Cell))
+				{
+					RemoveFromCell(Cell, Id);
+				}
+			});
+
+			ForEachCell(NewRange, [this, Id, &OldRange](const FIntVector& Cell)
+			{
+				if (!IsInsideCellRange(OldRange, Cell))
+				{
+					AddToCell(Cell, Id);
+				}
+			});
+		}
+	}
+
+	/** Remove an element, its id may be reused by elements added later. */
+	void Remove(int32 Id)
+	{
+		ForEachCell(GetCellRange(Elements[Id].Box), [this, Id](const FIntVector& Cell)
+		{
+			RemoveFromCell(Cell, Id);
+		});
+
+		Elements.RemoveAt(Id);
+	}
+
+	/** Remove all elements. Keeps the pool of cell chunks unless bShrink is set. */
+	void Reset(bool bShrink = false)
+	{
+		Elements.Empty();
+		Cells.Empty();
+
+		if (bShrink)
+		{
+			Chunks.Empty();
+			FreeChunk = INDEX_NONE;
+		}
+		else
+		{
+			for (int32 Chunk = 0; Chunk < Chunks.Num(); ++Chunk)
+			{
+				Chunks[Chunk].Next = Chunk + 1 < Chunks.Num() ? Chunk + 1 : INDEX_NONE;
+			}
+			FreeChunk = Chunks.Num() > 0 ? 0 : INDEX_NONE;
+		}
+	}
+
+	/** Find the elements whose box intersects a box, each element is listed once. */
+	void QueryBox(const FIntBox& Box, TArray<int32>& OutIds) const
+	{
+		const FIntBox QueryRange = GetCellRange(Box);
+
+		VisitCells(QueryRange, [this, &Box, &QueryRange, &OutIds](const FIntVector& Cell, const FCell& CellEntry)
+		{
+			ForEachCellElement(CellEntry, [this, &Box, &QueryRange, &Cell, &OutIds](int32 Id)
+			{
+				const FElement& Element = Elements[Id];
+				if (IsFirstSharedCell(Cell, QueryRange, GetCellRange(Element.Box)) && Element.Box.Intersect(Box))
+				{
+					OutIds.Add(Id);
+				}
+			});
+		});
+	}
+
+	/** Find the elements whose box is within a distance of a point, each element is listed once. */
+	void QueryRadius(const FVector& Center, float Radius, TArray<int32>& OutIds) const
+	{
+		const FIntBox Box(
+			FIntVector(FMath::FloorToInt(Center.X - Radius), FMath::FloorToInt(Center.Y - Radius), FMath::FloorToInt(Center.Z - Radius)),
+			FIntVector(FMath::CeilToInt(Center.X + Radius), FMath::CeilToInt(Center.Y + Radius), FMath::CeilToInt(Center.Z + Radius)));
+		const FIntBox QueryRange = GetCellRange(Box);
+		const float RadiusSquared = FMath::Square(Radius);
+
+		VisitCells(QueryRange, [this, &Center, RadiusSquared, &QueryRange, &OutIds](const FIntVector& Cell, const FCell& CellEntry)
+		{
+			ForEachCellElement(CellEntry, [this, &Center, RadiusSquared, &QueryRange, &Cell, &OutIds](int32 Id)
+			{
+				const FElement& Element = Elements[Id];
+				if (IsFirstSharedCell(Cell, QueryRange, GetCellRange(Element.Box)) && Element.Box.ComputeSquaredDistanceToPoint(Center) <= RadiusSquared)
+				{
+					OutIds.Add(Id);
+				}
+			});
+		});
+	}
+
+	/** Find the elements whose box is hit by a segment, ordered from Start to End. */
+	void QueryRay(const FVector& Start, const FVector& End, TArray<int32>& OutIds) const
+	{
+		const FVector Direction = End - Start;
+		const FIntVector StartCell = GetCell(Start);
+		const FIntVector EndCell = GetCell(End);
+
+		// Walk the cells crossed by the segment
+		FIntVector Cell = StartCell;
+		FIntVector Step;
+		FVector NextCrossing;
+		FVector CrossingDelta;
+		for (int32 Axis = 0; Axis < 3; ++Axis)
+		{
+			Step[Axis] = Direction[Axis] > 0.f ? 1 : Direction[Axis] < 0.f ? -1 : 0;
+			if (Step[Axis] != 0)
+			{
+				const float Boundary = (float)(Cell[Axis] + (Step[Axis] > 0 ? 1 : 0)) * CellSize;
+				NextCrossing[Axis] = (Boundary - Start[Axis]) / Direction[Axis];
+				CrossingDelta[Axis] = CellSize / FMath::Abs(Direction[Axis]);
+			}
+			else
+			{
+				NextCrossing[Axis] = MAX_flt;
+				CrossingDelta[Axis] = MAX_flt;
+			}
+		}
+
+		// Elements spanning several crossed cells are tested once, a set rather than stamps keeps queries const
+		TSet<int32, DefaultKeyFuncs<int32>, TInlineSetAllocator<16>> TestedIds;
+		TArray<TPair<float, int32>, TInlineAllocator<16>> Hits;
+		const int32 NumSteps = FMath::Abs(EndCell.X - StartCell.X) + FMath::Abs(EndCell.Y - StartCell.Y) + FMath::Abs(EndCell.Z - StartCell.Z);
+		for (int32 StepIndex = 0; StepIndex <= NumSteps; ++StepIndex)
+		{
+			if (const FCell* CellEntry = Cells.Find(Cell))
+			{
+				ForEachCellElement(*CellEntry, [this, &Start, &Direction, &TestedIds, &Hits](int32 Id)
+				{
+					bool bAlreadyTested;
+					TestedIds.Add(Id, &bAlreadyTested);
+
+					float HitTime;
+					if (!bAlreadyTested && IntersectSegment(Elements[Id].Box, Start, Direction, HitTime))
+					{
+						Hits.Emplace(HitTime, Id);
+					}
+				});
+			}
+
+			const int32 Axis = NextCrossing.X < NextCrossing.Y ? (NextCrossing.X < NextCrossing.Z ? 0 : 2) : (NextCrossing.Y < NextCrossing.Z ? 1 : 2);
+			if (NextCrossing[Axis] > 1.f)
+			{
+				break;
+			}
+
+			Cell[Axis] += Step[Axis];
+			NextCrossing[Axis] += CrossingDelta[Axis];
+		}
+
+		Hits.Sort([](const TPair<float, int32>& A, const TPair<float, int32>& B) { return A.Key < B.Key; });
+		for (const TPair<float, int32>& Hit : Hits)
+		{
+			OutIds.Add(Hit.Value);
+		}
+	}
+
+private:
+
+	struct FElement
+	{
+		ElementType Value;
+		FIntBox Box;
+	};
+
+	/** Ids of the elements of a cell. */
+	enum { ChunkSize = 14 };
+	struct FChunk
+	{
+		int32 Ids[ChunkSize];
+		int32 Next;
+	};
+
+	/** Elements of a cell, the first chunk is the only partially filled one. */
+	struct FCell
+	{
+		int32 FirstChunk;
+		int32 Num;
+	};
+
+	static int32 FloorDivide(int32 Value, int32 Divisor)
+	{
+		return Value >= 0 ? Value / Divisor : (Value - Divisor + 1) / Divisor;
+	}
+
+	FIntVector GetCell(const FIntVector& Point) const
+	{
+		return FIntVector(FloorDivide(Point.X, CellSize), FloorDivide(Point.Y, CellSize), FloorDivide(Point.Z, CellSize));
+	}
+
+	FIntVector GetCell(const FVector& Point) const
+	{
+		return FIntVector(FMath::FloorToInt(Point.X / CellSize), FMath::FloorToInt(Point.Y / CellSize), FMath::FloorToInt(Point.Z / CellSize));
+	}
+
+	/** Return the first and last cells overlapped by a box. */
+	FIntBox GetCellRange(const FIntBox& Box) const
+	{
+		return FIntBox(GetCell(Box.Min), GetCell(Box.Max));
+	}
+
+	static bool IsInsideCellRange(const FIntBox& Range, const FIntVector& Cell)
+	{
+		return Range.IsInsideOrOn(Cell);
+	}
+
+	/** Whether a cell is the lowest one of both ranges, so that elements spanning several cells are only reported once. */
+	static bool IsFirstSharedCell(const FIntVector& Cell, const FIntBox& QueryRange, const FIntBox& ElementRange)
+	{
+		return Cell.X == FMath::Max(QueryRange.Min.X, ElementRange.Min.X)
+			&& Cell.Y == FMath::Max(QueryRange.Min.Y, ElementRange.Min.Y)
+			&& Cell.Z == FMath::Max(QueryRange.Min.Z, ElementRange.Min.Z);
+	}
+
+	template<typename FunctionType>
+	static void ForEachCell(const FIntBox& Range, FunctionType Function)
+	{
+		for (int32 Z = Range.Min.Z; Z <= Range.Max.Z; ++Z)
+		{
+			for (int32 Y = Range.Min.Y; Y <= Range.Max.Y; ++Y)
+			{
+				for (int32 X = Range.Min.X; X <= Range.Max.X; ++X)
+				{
+					Function(FIntVector(X, Y, Z));
+				}
+			}
+		}
+	}
+
+	/** Call a function for each occupied cell of a range, iterating the smallest of the range and the occupied cells. */
+	template<typename FunctionType>
+	void VisitCells(const FIntBox& Range, FunctionType Function) const
+	{
+		const int64 NumRangeCells = int64(Range.Max.X - Range.Min.X + 1) * (Range.Max.Y - Range.Min.Y + 1) * (Range.Max.Z - Range.Min.Z + 1);
+		if (NumRangeCells <= Cells.Num())
+		{
+			ForEachCell(Range, [this, &Function](const FIntVector& Cell)
+			{
+				if (const FCell* CellEntry = Cells.Find(Cell))
+				{
+					Function(Cell, *CellEntry);
+				}
+			});
+		}
+		else
+		{
+			for (const TPair<FIntVector, FCell>& Pair : Cells)
+			{
+				if (IsInsideCellRange(Range, Pair.Key))
+				{
+					Function(Pair.Key, Pair.Value);
+				}
+			}
+		}
+	}
+
+	template<typename FunctionType>
+	void ForEachCellElement(const FCell& CellEntry, FunctionType Function) const
+	{
+		// The first chunk holds the remainder, the following ones are full
+		int32 NumInChunk = (CellEntry.Num - 1) % ChunkSize + 1;
+		for (int32 Chunk = CellEntry.FirstChunk; Chunk != INDEX_NONE; Chunk = Chunks[Chunk].Next)
+		{
+			for (int32 Index = 0; Index < NumInChunk; ++Index)
+			{
+				Function(Chunks[Chunk].Ids[Index]);
+			}
+			NumInChunk = ChunkSize;
+		}
+	}
+
+	void LinkElement(int32 Id, const FIntBox& Range)
+	{
+		ForEachCell(Range, [this, Id](const FIntVector& Cell)
+		{
+			AddToCell(Cell, Id);
+		});
+	}
+
+	int32 AllocateChunk(int32 Next)
+	{
+		int32 Chunk = FreeChunk;
+		if (Chunk != INDEX_NONE)
+		{
+			FreeChunk = Chunks[Chunk].Next;
+		}
+		else
+		{
+			Chunk = Chunks.AddUninitialized();
+		}
+
+		Chunks[Chunk].Next = Next;
+		return Chunk;
+	}
+
+	void FreeChunkAt(int32 Chunk)
+	{
+		Chunks[Chunk].Next = FreeChunk;
+		FreeChunk = Chunk;
+	}
+
+	void AddToCell(const FIntVector& Cell, int32 Id)
+	{
+		FCell* CellEntry = Cells.Find(Cell);
+		if (CellEntry == nullptr)
+		{
+			CellEntry = &Cells.Add(Cell, FCell{ INDEX_NONE, 0 });
+		}
+
+		const int32 IndexInChunk = CellEntry->Num % ChunkSize;
+		if (IndexInChunk == 0)
+		{
+			CellEntry->FirstChunk = AllocateChunk(CellEntry->FirstChunk);
+		}
+
+		Chunks[CellEntry->FirstChunk].Ids[IndexInChunk] = Id;
+		CellEntry->Num++;
+	}
+
+	void RemoveFromCell(const FIntVector& Cell, int32 Id)
+	{
+		FCell* CellEntry = Cells.Find(Cell);
+		check(CellEntry);
+
+		// Replace the element with the last one added to the cell
+		const int32 LastIndex = (CellEntry->Num - 1) % ChunkSize;
+		int32& LastId = Chunks[CellEntry->FirstChunk].Ids[LastIndex];
+
+		int32* Found = nullptr;
+		int32 NumInChunk = LastIndex + 1;
+		for (int32 Chunk = CellEntry->FirstChunk; Chunk != INDEX_NONE && Found == nullptr; Chunk = Chunks[Chunk].Next)
+		{
+			Found = Algo::Find(MakeArrayView(Chunks[Chunk].Ids, NumInChunk), Id);
+			NumInChunk = ChunkSize;
+		}
+
+		// Removing an id that isn't listed would drop another element from the cell
+		check(Found);
+		*Found = LastId;
+
+		CellEntry->Num--;
+		if (LastIndex == 0)
+		{
+			const int32 EmptyChunk = CellEntry->FirstChunk;
+			CellEntry->FirstChunk = Chunks[EmptyChunk].Next;
+			FreeChunkAt(EmptyChunk);
+		}
+
+		if (CellEntry->Num == 0)
+		{
+			Cells.Remove(Cell);
+		}
+	}
+
+	/** Whether a segment hits a box and when it enters it, from 0 at the start to 1 at the end. */
+	static bool IntersectSegment(const FIntBox& Box, const FVector& Start, const FVector& Direction, float& OutTime)
+	{
+		float Enter = 0.f;
+		float Exit = 1.f;
+		for (int32 Axis = 0; Axis < 3; ++Axis)
+		{
+			if (FMath::Abs(Direction[Axis]) < SMALL_NUMBER)
+			{
+				if (Start[Axis] < Box.Min[Axis] || Start[Axis] > Box.Max[Axis])
+				{
+					return false;
+				}
+				continue;
+			}
+
+			const float InvDirection = 1.f / Direction[Axis];
+			float Near = (Box.Min[Axis] - Start[Axis]) * InvDirection;
+			float Far = (Box.Max[Axis] - Start[Axis]) * InvDirection;
+			if (Near > Far)
+			{
+				Swap(Near, Far);
+			}
+
+			Enter = FMath::Max(Enter, Near);
+			Exit = FMath::Min(Exit, Far);
+			if (Enter > Exit)
+			{
+				return false;
+			}
+		}
+
+		OutTime = Enter;
+		return true;
+	}
+
+	int32 CellSize;
+
+	TSparseArray<FElement> Elements;
+
+	TMap<FIntVector, FCell> Cells;
+
+	/** Pool of chunks shared by all cells. */
+	TArray<FChunk> Chunks;
+
+	/** First chunk of the free list, linked through FChunk::Next. */
+	int32 FreeChunk;
+};
@@ -38,6 +38,7 @@ public TPCE(ReadOnlyTargetRules Target) : base(Target)
 				"Slate",
 				"SlateCore",
 				"UMG",
+				"RenderCore",
 				"RHI",  // Needed for GetMax2DTextureDimension
 			}
 		);
@@ -0,0 +1,119 @@
+// This source code is licensed under the MIT license found in the LICENSE file in the root directory of this source tree.
+
+#include "AnimationModifiers/AnimSequencePoseCache.h"
+#include "AnimationModifiers/RecentlyUsedList.h"
+
+#include "Animation/AnimSequence.h"
+#include "Animation/Skeleton.h"
+#include "AnimationBlueprintLibrary.h"
+#include "ReferenceSkeleton.h"
+
+namespace AnimSequencePoseCache
+{
+	// Offset of the last sample so that it stays inside the sequence
+	const float LastFrameTimeOffset = 0.001f;
+
+	// Enough to share a cache between the modifiers applied to a sequence without holding many sequences in memory
+	static TRecentlyUsedList<TSharedRef<FAnimSequencePoseCache>, 4> SharedCaches;
+}
+
+TSharedRef<FAnimSequencePoseCache> FAnimSequencePoseCache::Get(const UAnimSequence* AnimationSequence)
+{
+	using namespace AnimSequencePoseCache;
+
+	if (const TSharedRef<FAnimSequencePoseCache>* Cache = SharedCaches.Find([AnimationSequence](const TSharedRef<FAnimSequencePoseCache>& SharedCache) { return SharedCache->IsValidFor(AnimationSequence); }))
+	{
+		return *Cache;
+	}
+
+	// Remove stale caches of the same sequence before adding the new one
+	return SharedCaches.Add(MakeShared<FAnimSequencePoseCache>(AnimationSequence),
+		[AnimationSequence](const TSharedRef<FAnimSequencePoseCache>& SharedCache) { return !SharedCache->Sequence.IsValid() || SharedCache->Sequence.Get() == AnimationSequence; });
+}
+
+void FAnimSequencePoseCache::Flush()
+{
+	AnimSequencePoseCache::SharedCaches.Empty();
+}
+
+FAnimSequencePoseCache::FAnimSequencePoseCache(const UAnimSequence* AnimationSequence)
+	: Sequence(AnimationSequence)
+	, RefSkeleton(nullptr)
+	, NumBones(0)
+{
+	const USkeleton* Skeleton = AnimationSequence ? AnimationSequence->GetSkeleton() : nullptr;
+	if (Skeleton == nullptr)
+	{
+		return;
+	}
+
+	RawDataGuid = AnimationSequence->GetRawDataGuid();
+	RefSkeleton = &Skeleton->GetReferenceSkeleton();
+	NumBones = RefSkeleton->GetNum();
+
+	TArray<FName> BoneNames;
+	BoneNames.Reserve(NumBones);
+	for (int32 BoneIndex = 0; BoneIndex < NumBones; ++BoneIndex)
+	{
+		BoneNames.Add(RefSkeleton->GetBoneName(BoneIndex));
+	}
+
+	const int32 NumSequenceFrames = AnimationSequence->GetNumberOfFrames();
+	FrameTimes.SetNumUninitialized(NumSequenceFrames + 1);
+	ComponentTransforms.SetNumUninitialized(FrameTimes.Num() * NumBones);
+
+	TArray<FTransform> LocalTransforms;
+	for (int32 Frame = 0; Frame <= NumSequenceFrames; ++Frame)
+	{
+		float Time = AnimationSequence->GetTimeAtFrame(Frame);
+		if (Frame == NumSequenceFrames)
+		{
+			Time -= AnimSequencePoseCache::LastFrameTimeOffset;
+		}
+		FrameTimes[Frame] = Time;
+
+		// Decode all bones at once, then compose parents first as bones are sorted in the reference skeleton
+		UAnimationBlueprintLibrary::GetBonePosesForTime(AnimationSequence, BoneNames, Time, false, LocalTransforms);
+		check(LocalTransforms.Num() == NumBones);
+
+		FTransform* Pose = ComponentTransforms.GetData() + Frame * NumBones;
+		for (int32 BoneIndex = 0; BoneIndex < NumBones; ++BoneIndex)
+		{
+			const int32 ParentIndex = RefSkeleton->GetParentIndex(BoneIndex);
+			Pose[BoneIndex] = ParentIndex != INDEX_NONE ? LocalTransforms[BoneIndex] * Pose[ParentIndex] : LocalTransforms[BoneIndex];
+		}
+	}
+}
+
+int32 FAnimSequencePoseCache::FindBoneIndex(FName BoneName) const
+{
+	return RefSkeleton ? RefSkeleton->FindBoneIndex(BoneName) : INDEX_NONE;
+}
+
+const FTransform& FAnimSequencePoseCache::GetComponentTransform(int32 Frame, int32 BoneIndex) const
+{
+	return BoneIndex != INDEX_NONE ? ComponentTransforms[Frame * NumBones + BoneIndex] : FTransform::Identity;
+}
+
+FTransform FAnimSequencePoseCache::GetRelativeTransform(int32 Frame, int32 BoneIndex, int32 AncestorBoneIndex) const
+{
+	if (BoneIndex == INDEX_NONE || BoneIndex == AncestorBoneIndex)
+	{
+		return FTransform::Identity;
+	}
+
+	if (AncestorBoneIndex != INDEX_NONE && RefSkeleton->BoneIsChildOf(BoneIndex, AncestorBoneIndex))
+	{
+		return GetComponentTransform(Frame, BoneIndex).GetRelativeTransform(GetComponentTransform(Frame, AncestorBoneIndex));
+	}
+
+	return GetComponentTransform(Frame, BoneIndex);
+}
+
+bool FAnimSequencePoseCache::IsValidFor(const UAnimSequence* AnimationSequence) const
+{
+	return AnimationSequence && Sequence.Get() == AnimationSequence
+		&& RawDataGuid == AnimationSequence->GetRawDataGuid()
+		&& FrameTimes.Num() == AnimationSequence->GetNumberOfFrames() + 1
+		&& RefSkeleton == (AnimationSequence->GetSkeleton() ? &AnimationSequence->GetSkeleton()->GetReferenceSkeleton() : nullptr);
+}
@@ -0,0 +1,71 @@
+// This source code is licensed under the MIT license found in the LICENSE file in the root directory of this source tree.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/WeakObjectPtr.h"
+
+class UAnimSequence;
+struct FReferenceSkeleton;
+
+/**
+ * Component space poses of an animation sequence, sampled once per frame for all bones of its skeleton.
+ *
+ * Frames match the sampling of the animation modifiers: frame N is sampled at GetTimeAtFrame(N), and the frame past the
+ * last key is sampled slightly earlier to stay inside the sequence. Bones are stored in reference skeleton order so that
+ * every pose is a flat array indexed by bone.
+ */
+class FAnimSequencePoseCache
+{
+public:
+
+	/**
+	 * Return the cache of a sequence. Recently used caches are shared, so modifiers applied to the same sequence in a row
+	 * only sample it once. The sequence is sampled again if its animation data changed. Game thread only.
+	 */
+	static TSharedRef<FAnimSequencePoseCache> Get(const UAnimSequence* AnimationSequence);
+
+	/** Release all shared caches. */
+	static void Flush();
+
+	explicit FAnimSequencePoseCache(const UAnimSequence* AnimationSequence);
+
+	/** Return the number of sampled frames, one more than the number of frames of the sequence. */
+	int32 GetNumFrames() const { return FrameTimes.Num(); }
+
+	/** Return the time a frame was sampled at. */
+	float GetFrameTime(int32 Frame) const { return FrameTimes[Frame]; }
+
+	/** Return the index of a bone in the cached poses or INDEX_NONE if the skeleton doesn't have it. */
+	int32 FindBoneIndex(FName BoneName) const;
+
+	/** Return the component space transform of a bone, identity if the bone is INDEX_NONE. */
+	const FTransform& GetComponentTransform(int32 Frame, int32 BoneIndex) const;
+
+	/**
+	 * Return the transform of a bone relative to one of its ancestors. The component space transform is returned if the
+	 * other bone is not an ancestor, and identity if both are the same bone.
+	 */
+	FTransform GetRelativeTransform(int32 Frame, int32 BoneIndex, int32 AncestorBoneIndex) const;
+
+	/** Return the component space pose of a frame. */
+	TArrayView<const FTransform> GetComponentPose(int32 Frame) const
+	{
+		return TArrayView<const FTransform>(ComponentTransforms.GetData() + Frame * NumBones, NumBones);
+	}
+
+private:
+
+	bool IsValidFor(const UAnimSequence* AnimationSequence) const;
+
+	TWeakObjectPtr<const UAnimSequence> Sequence;
+	FGuid RawDataGuid;
+
+	const FReferenceSkeleton* RefSkeleton;
+	int32 NumBones;
+
+	TArray<float> FrameTimes;
+
+	// Component space transforms, NumBones per frame
+	TArray<FTransform> ComponentTransforms;
+};
@@ -1,6 +1,7 @@
 // This source code is licensed under the MIT license found in the LICENSE file in the root directory of this source tree.
 
 #include "AnimationModifiers/AnimationModifier_BoneDistance.h"
+#include "AnimationModifiers/AnimSequencePoseCache.h"
 
 #include "Animation/AnimSequence.h"
 #include "UObject/UObjectBaseUtility.h"
@@ -26,60 +27,73 @@ UAnimationModifier_BoneDistance::UAnimationModifier_BoneDistance()
 	BonePairs.Add(FBonePair(NAME_Thigh_R, NAME_Hand_R));
 }
 
-FVector UAnimationModifier_BoneDistance::GetWorldBoneLocationAtTime(UAnimSequence* AnimationSequence, FName TargetBoneName, float Time)
+namespace BoneDistance
 {
-	FTransform Transform;
-	TArray<FName> BonePath;
-	UAnimationBlueprintLibrary::FindBonePathToRoot(AnimationSequence, TargetBoneName, BonePath);
-	for (auto& BoneName : BonePath)
+	struct FCurveAnalysis
 	{
-		FTransform BonePose;
-		UAnimationBlueprintLibrary::GetBonePoseForTime(AnimationSequence, BoneName, Time, false, BonePose);
-		Transform *= BonePose;
+		FName CurveName;
+		FCurveKeyReductionResult Keys;
+	};
+
+	struct FAnalysis : public FAnimationModifierAnalysis
+	{
+		TArray<FCurveAnalysis> Curves;
+	};
+}
+
+TSharedPtr<FAnimationModifierAnalysis> UAnimationModifier_BoneDistance::AnalyzeSequence(const UAnimSequence* AnimationSequence, const FAnimSequencePoseCache& PoseCache) const
+{
+	FString Path = GetPathNameSafe(AnimationSequence);
+	if (PathFilter != NAME_None && !Path.Contains(PathFilter.ToString()))
+	{
+		return nullptr;
+	}
+
+	TSharedRef<BoneDistance::FAnalysis> Analysis = MakeShared<BoneDistance::FAnalysis>();
+	for (const FBonePair& BonePair : BonePairs)
+	{
+		BoneDistance::FCurveAnalysis& Curve = Analysis->Curves.AddDefaulted_GetRef();
+		Curve.CurveName = *FString::Printf(TEXT("%s_to_%s"), *BonePair.BoneName1.ToString(), *BonePair.BoneName2.ToString());
+
+		const int32 BoneIndex1 = PoseCache.FindBoneIndex(BonePair.BoneName1);
+		const int32 BoneIndex2 = PoseCache.FindBoneIndex(BonePair.BoneName2);
+
+		TArray<float> Times;
+		TArray<float> Values;
+		for (int32 Frame = 0; Frame < PoseCache.GetNumFrames(); ++Frame)
+		{
+			const FVector Bone1Location = PoseCache.GetComponentTransform(Frame, BoneIndex1).GetLocation();
+			const FVector Bone2Location = PoseCache.GetComponentTransform(Frame, BoneIndex2).GetLocation();
+			Times.Add(PoseCache.GetFrameTime(Frame));
+			Values.Add((Bone1Location - Bone2Location).Size() + BonePair.Offset);
+		}
+
+		Curve.Keys = CurveKeyReduction::ReduceKeys(Times, Values, KeyReduction);
 	}
 
-	return Transform.GetLocation();
+	return Analysis;
 }
 
-void UAnimationModifier_BoneDistance::OnApply_Implementation(UAnimSequence* AnimationSequence)
+void UAnimationModifier_BoneDistance::CommitAnalysis(UAnimSequence* AnimationSequence, const FAnimationModifierAnalysis& InAnalysis)
 {
-	Super::OnApply_Implementation(AnimationSequence);
+	const BoneDistance::FAnalysis& Analysis = static_cast<const BoneDistance::FAnalysis&>(InAnalysis);
 
-	FString Path = GetPathNameSafe(AnimationSequence);
-	if (PathFilter == NAME_None || Path.Contains(PathFilter.ToString()))
+	for (const BoneDistance::FCurveAnalysis& Curve : Analysis.Curves)
 	{
-		for (const FBonePair& BonePair : BonePairs)
+		if (UAnimationBlueprintLibrary::DoesCurveExist(AnimationSequence, Curve.CurveName, ERawCurveTrackTypes::RCT_Float))
 		{
-			const FName& CurveName = *FString::Printf(TEXT("%s_to_%s"), *BonePair.BoneName1.ToString(), *BonePair.BoneName2.ToString());
-			if (UAnimationBlueprintLibrary::DoesCurveExist(AnimationSequence, CurveName, ERawCurveTrackTypes::RCT_Float))
-			{
-				UAnimationBlueprintLibrary::RemoveCurve(AnimationSequence, CurveName);
-			}
-			UAnimationBlueprintLibrary::AddCurve(AnimationSequence, CurveName, ERawCurveTrackTypes::RCT_Float, false);
-
-			const float TotalTime = AnimationSequence->GetPlayLength();
-			const int32 NumFrames = AnimationSequence->GetNumberOfFrames();
-			const float TimePerFrame = TotalTime / NumFrames;
-
-			for (int32 Frame = 0; Frame <= NumFrames; ++Frame)
-			{
-				float Time = AnimationSequence->GetTimeAtFrame(Frame);
-				if (Frame == NumFrames)
-				{
-					// Subtract a little time from the last frame to avoid errors
-					Time -= 0.001f;
-				}
-
-				const FVector Bone1Location = GetWorldBoneLocationAtTime(AnimationSequence, BonePair.BoneName1, Time);
-				const FVector Bone2Location = GetWorldBoneLocationAtTime(AnimationSequence, BonePair.BoneName2, Time);
-				const float BoneDistance = (Bone1Location - Bone2Location).Size() + BonePair.Offset;
-
-				UAnimationBlueprintLibrary::AddFloatCurveKey(AnimationSequence, CurveName, Time, BoneDistance);
-			}
+			UAnimationBlueprintLibrary::RemoveCurve(AnimationSequence, Curve.CurveName);
 		}
+		UAnimationBlueprintLibrary::AddCurve(AnimationSequence, Curve.CurveName, ERawCurveTrackTypes::RCT_Float, false);
+		CurveKeyReduction::SetFloatCurveKeys(AnimationSequence, Curve.CurveName, Curve.Keys.Keys);
 
-		UAnimationBlueprintLibrary::FinalizeBoneAnimation(AnimationSequence);
+		if (KeyReduction.bReduceKeys)
+		{
+			CurveKeyReduction::LogResult(AnimationSequence, Curve.CurveName, Curve.Keys);
+		}
 	}
+
+	UAnimationBlueprintLibrary::FinalizeBoneAnimation(AnimationSequence);
 }
 
 void UAnimationModifier_BoneDistance::OnRevert_Implementation(UAnimSequence* AnimationSequence)
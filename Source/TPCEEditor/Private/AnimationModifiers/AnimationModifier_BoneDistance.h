@@ -3,8 +3,9 @@
 #pragma once
 
 #include "CoreMinimal.h"
-#include "AnimationModifier.h"
+#include "AnimationModifiers/BatchAnimationModifier.h"
 #include "Animation/AnimTypes.h"
+#include "Curves/CurveKeyReduction.h"
 
 #include "AnimationModifier_BoneDistance.generated.h"
 
@@ -35,17 +36,13 @@ struct FBonePair
  * Animation Modifier to generate curves from the distance between two bones.
  */
 UCLASS(meta = (DisplayName = "Bone Distance"))
-class UAnimationModifier_BoneDistance : public UAnimationModifier
+class UAnimationModifier_BoneDistance : public UBatchAnimationModifier
 {
 	GENERATED_BODY()
 
 public:
 	UAnimationModifier_BoneDistance();
 
-protected:
-	virtual FVector GetWorldBoneLocationAtTime(UAnimSequence* AnimationSequence, FName TargetBoneName, float Time);
-
-public:
 	/** Only animations with a path containing this filter as a case insensitive substring will be affected. Empty value matches all. */
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category=Settings)
 	FName PathFilter;
@@ -54,6 +51,14 @@ public:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category=Settings)
 	TArray<FBonePair> BonePairs;
 
-	virtual void OnApply_Implementation(UAnimSequence* AnimationSequence) override;
+	/** Reduction of the keys added to the curves, one per frame otherwise. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category=Settings, AdvancedDisplay)
+	FCurveKeyReductionSettings KeyReduction;
+
 	virtual void OnRevert_Implementation(UAnimSequence* AnimationSequence) override;
+
+	// Begin UBatchAnimationModifier Interface
+	virtual TSharedPtr<FAnimationModifierAnalysis> AnalyzeSequence(const UAnimSequence* AnimationSequence, const FAnimSequencePoseCache& PoseCache) const override;
+	virtual void CommitAnalysis(UAnimSequence* AnimationSequence, const FAnimationModifierAnalysis& Analysis) override;
+	// End UBatchAnimationModifier Interface
 };
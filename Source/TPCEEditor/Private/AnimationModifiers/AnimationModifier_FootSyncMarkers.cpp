@@ -1,7 +1,9 @@
 // This source code is licensed under the MIT license found in the LICENSE file in the root directory of this source tree.
 
 #include "AnimationModifiers/AnimationModifier_FootSyncMarkers.h"
+#include "AnimationModifiers/AnimSequencePoseCache.h"
 #include "Animation/AnimSequence.h"
+#include "ReferenceSkeleton.h"
 #include "UObject/UObjectBaseUtility.h"
 #include "TPCETypes.h"
 #include "Internationalization/Regex.h"
@@ -33,6 +35,7 @@ UAnimationModifier_FootSyncMarkers::UAnimationModifier_FootSyncMarkers()
 	bAxisFromName = true;
 	MovementAxis = EAxisOption::Y;
 	bMarkFootPlantOnly = true;
+	bMarkFootContacts = false;
 
 	FootBones.Add(FBoneModifier(NAME_Foot_L));
 	FootBones.Add(FBoneModifier(NAME_Foot_R));
@@ -65,133 +68,189 @@ void UAnimationModifier_FootSyncMarkers::RemoveSyncTrack(UAnimSequence* Animatio
 	}
 }
 
-FVector UAnimationModifier_FootSyncMarkers::GetRelativeBoneLocationAtTime(UAnimSequence* AnimationSequence, FName TargetBoneName, FName RelativeBoneName, float Time)
+namespace FootSyncMarkers
 {
-	FTransform Transform;
-	TArray<FName> BonePath;
-	UAnimationBlueprintLibrary::FindBonePathToRoot(AnimationSequence, TargetBoneName, BonePath);
-	for (auto& BoneName : BonePath)
+	struct FFootAnalysis
 	{
-		if (BoneName == RelativeBoneName)
-			break;
+		FName CurveName;
+		FCurveKeyReductionResult CurveKeys;
+		TArray<TPair<FName, float>> Markers;
+	};
 
-		FTransform BonePose;
-		UAnimationBlueprintLibrary::GetBonePoseForTime(AnimationSequence, BoneName, Time, false, BonePose);
-		Transform *= BonePose;
-	}
-
-	return Transform.GetLocation();
+	struct FAnalysis : public FAnimationModifierAnalysis
+	{
+		TArray<FFootAnalysis> Feet;
+	};
 }
 
-void UAnimationModifier_FootSyncMarkers::OnApply_Implementation(UAnimSequence* AnimationSequence)
+TSharedPtr<FAnimationModifierAnalysis> UAnimationModifier_FootSyncMarkers::AnalyzeSequence(const UAnimSequence* AnimationSequence, const FAnimSequencePoseCache& PoseCache) const
 {
-	Super::OnApply_Implementation(AnimationSequence);
-
 	FString Path = GetPathNameSafe(AnimationSequence);
-	if (PathFilter == NAME_None || Path.Contains(PathFilter.ToString()))
+	if (PathFilter != NAME_None && !Path.Contains(PathFilter.ToString()))
 	{
-		RemoveSyncTrack(AnimationSequence);
-		UAnimationBlueprintLibrary::AddAnimationNotifyTrack(AnimationSequence, NotifyTrackName, FLinearColor::Green);
+		return nullptr;
+	}
 
-		FVector Axis = FVector::ZeroVector;
-		if (bAxisFromName)
+	FVector Axis = FVector::ZeroVector;
+	if (bAxisFromName)
+	{
+		static const FRegexPattern AxisPattern(
+			R"((Fwd)"				// Forward
+			R"(|Bwd)"				// Backward
+			R"(|[LR][A-Z\d][a-z])"	// Left/Right before another word (e.g A_RunLStart)
+			R"(|[LR]\d*$)"			// Left/Right at end of sentence (e.g A_RunL2)
+			R"(|\d{2,3}[LR]))"		// Angle and Left/Right (e.g A_Walk45R)
+		);
+
+		FRegexMatcher AxisMatcher(AxisPattern, AnimationSequence->GetName());
+		if (AxisMatcher.FindNext())
 		{
-			static const FRegexPattern AxisPattern(
-				R"((Fwd)"				// Forward
-				R"(|Bwd)"				// Backward
-				R"(|[LR][A-Z\d][a-z])"	// Left/Right before another word (e.g A_RunLStart)
-				R"(|[LR]\d*$)"			// Left/Right at end of sentence (e.g A_RunL2)
-				R"(|\d{2,3}[LR]))"		// Angle and Left/Right (e.g A_Walk45R)
-			);
-
-			FRegexMatcher AxisMatcher(AxisPattern, AnimationSequence->GetName());
-			if (AxisMatcher.FindNext())
+			FString Capture = AxisMatcher.GetCaptureGroup(1);
+			if (Capture == TEXT("Fwd"))
 			{
-				FString Capture = AxisMatcher.GetCaptureGroup(1);
-				if (Capture == TEXT("Fwd"))
-				{
-					Axis = FVector::RightVector;
-				}
-				else if (Capture == TEXT("Bwd"))
-				{
-					Axis = -FVector::RightVector;
-				}
-				else if (Capture.StartsWith(TEXT("L")))
-				{
-					Axis = FVector::ForwardVector;
-				}
-				else if (Capture.StartsWith(TEXT("R")))
-				{
-					Axis = -FVector::ForwardVector;
-				}
-				else if (Capture.EndsWith(TEXT("L")))
-				{
-					const int32 Degrees = FCString::Atoi(*Capture.LeftChop(1));
-					Axis = FRotator(0.0f, Degrees, 0.0f).Vector();
-				}
-				else if (Capture.EndsWith(TEXT("R")))
+				Axis = FVector::RightVector;
+			}
+			else if (Capture == TEXT("Bwd"))
+			{
+				Axis = -FVector::RightVector;
+			}
+			else if (Capture.StartsWith(TEXT("L")))
+			{
+				Axis = FVector::ForwardVector;
+			}
+			else if (Capture.StartsWith(TEXT("R")))
+			{
+				Axis = -FVector::ForwardVector;
+			}
+			else if (Capture.EndsWith(TEXT("L")))
+			{
+				const int32 Degrees = FCString::Atoi(*Capture.LeftChop(1));
+				Axis = FRotator(0.0f, Degrees, 0.0f).Vector();
+			}
+			else if (Capture.EndsWith(TEXT("R")))
+			{
+				const int32 Degrees = FCString::Atoi(*Capture.LeftChop(1));
+				Axis = FRotator(0.0f, -Degrees, 0.0f).Vector();
+			}
+		}
+	}
+
+	if (Axis.IsZero())
+	{
+		Axis = FAxisOption::GetAxisVector(MovementAxis, CustomMovementAxis.GetSafeNormal());
+	}
+
+	TSharedRef<FootSyncMarkers::FAnalysis> Analysis = MakeShared<FootSyncMarkers::FAnalysis>();
+	const int32 PelvisBoneIndex = PoseCache.FindBoneIndex(PelvisBoneName);
+	const float TimePerFrame = AnimationSequence->GetPlayLength() / AnimationSequence->GetNumberOfFrames();
+
+	for (auto& FootBone : FootBones)
+	{
+		const FName& CurrentBoneName = FootBone.BoneName;
+		const int32 CurrentBoneIndex = PoseCache.FindBoneIndex(CurrentBoneName);
+		const float CurrentBoneOffset = FootBone.Offset;
+
+		FootSyncMarkers::FFootAnalysis& Foot = Analysis->Feet.AddDefaulted_GetRef();
+		Foot.CurveName = CurrentBoneName;
+
+		TArray<float> CurveTimes;
+		TArray<float> CurveValues;
+		float LastBoneDistance = 0.0f;
+		for (int32 Frame = 0; Frame < PoseCache.GetNumFrames(); ++Frame)
+		{
+			const float Time = PoseCache.GetFrameTime(Frame);
+			const FVector BoneRelativeLocation = PoseCache.GetRelativeTransform(Frame, CurrentBoneIndex, PelvisBoneIndex).GetLocation();
+			const float BoneDistance = (BoneRelativeLocation * Axis).Size() * FMath::Sign(BoneRelativeLocation | Axis) + CurrentBoneOffset;
+
+			if (bCreateCurve)
+			{
+				CurveTimes.Add(Time);
+				CurveValues.Add(BoneDistance);
+			}
+
+			if (!bMarkFootContacts && Frame > 0 && FMath::Sign(BoneDistance) != FMath::Sign(LastBoneDistance))
+			{
+				if (!bMarkFootPlantOnly || BoneDistance < 0.0f)
 				{
-					const int32 Degrees = FCString::Atoi(*Capture.LeftChop(1));
-					Axis = FRotator(0.0f, -Degrees, 0.0f).Vector();
+					const FName MarkerName = *(CurrentBoneName.ToString().Append((BoneDistance >= 0.0f ? TEXT("_step_fwd") : bMarkFootPlantOnly ? TEXT("_plant") : TEXT("_step_bwd"))));
+					const float MarkerTime = (BoneDistance == 0.0f) ? Time : (Time - (TimePerFrame * FMath::Abs(BoneDistance / (BoneDistance - LastBoneDistance))));
+					Foot.Markers.Emplace(MarkerName, MarkerTime);
 				}
 			}
+
+			LastBoneDistance = BoneDistance;
 		}
 
-		if (Axis.IsZero())
+		if (bCreateCurve)
 		{
-			Axis = FAxisOption::GetAxisVector(MovementAxis, CustomMovementAxis.GetSafeNormal());
+			Foot.CurveKeys = CurveKeyReduction::ReduceKeys(CurveTimes, CurveValues, KeyReduction);
 		}
+	}
 
-		for (auto& FootBone : FootBones)
+	if (bMarkFootContacts)
+	{
+		const FReferenceSkeleton& RefSkel = AnimationSequence->GetSkeleton()->GetReferenceSkeleton();
+
+		TArray<TPair<FName, float>> ContactBones;
+		for (const FBoneModifier& FootBone : FootBones)
 		{
-			const FName& CurrentBoneName = FootBone.BoneName;
-			const float CurrentBoneOffset = FootBone.Offset;
+			ContactBones.Emplace(FootBone.BoneName, FFootContactAnalysis::GetRefBoneComponentLocation(RefSkel, FootBone.BoneName).Z + KINDA_SMALL_NUMBER);
+		}
 
-			const FName& CurveName = CurrentBoneName;
+		const FFootContactAnalysis ContactAnalysis(PoseCache, ContactBones, FootContact);
+		for (int32 FootIndex = 0; FootIndex < ContactAnalysis.GetFeet().Num(); ++FootIndex)
+		{
+			const FFootContactTrack& ContactFoot = ContactAnalysis.GetFeet()[FootIndex];
+			FootSyncMarkers::FFootAnalysis& Foot = Analysis->Feet[FootIndex];
 
-			if (bCreateCurve)
+			for (const FFootContact& Contact : ContactFoot.Contacts)
 			{
-				if (UAnimationBlueprintLibrary::DoesCurveExist(AnimationSequence, CurveName, ERawCurveTrackTypes::RCT_Float))
+				if (!FFootContactAnalysis::StartsAtBeginning(Contact))
 				{
-					UAnimationBlueprintLibrary::RemoveCurve(AnimationSequence, CurveName);
+					Foot.Markers.Emplace(*(ContactFoot.BoneName.ToString() + TEXT("_plant")), Contact.StartTime);
+				}
+				if (!bMarkFootPlantOnly && !ContactAnalysis.LastsUntilEnd(Contact))
+				{
+					Foot.Markers.Emplace(*(ContactFoot.BoneName.ToString() + TEXT("_lift")), Contact.EndTime);
 				}
-				UAnimationBlueprintLibrary::AddCurve(AnimationSequence, CurveName, ERawCurveTrackTypes::RCT_Float, false);
 			}
+		}
+	}
 
-			float LastBoneDistance = 0.0f;
-			const float TotalTime = AnimationSequence->GetPlayLength();
-			const int32 NumFrames = AnimationSequence->GetNumberOfFrames();
-			const float TimePerFrame = TotalTime / NumFrames;
-			for (int32 Frame = 0; Frame <= NumFrames; ++Frame)
-			{
-				// Subtract a little time from the last frame to avoid errors
-				float Time = AnimationSequence->GetTimeAtFrame(Frame);
-				if (Frame == NumFrames)
-					Time -= 0.001f;
+	return Analysis;
+}
 
-				const FVector BoneRelativeLocation = GetRelativeBoneLocationAtTime(AnimationSequence, CurrentBoneName, PelvisBoneName, Time);
-				const float BoneDistance = (BoneRelativeLocation * Axis).Size() * FMath::Sign(BoneRelativeLocation | Axis) + CurrentBoneOffset;
+void UAnimationModifier_FootSyncMarkers::CommitAnalysis(UAnimSequence* AnimationSequence, const FAnimationModifierAnalysis& InAnalysis)
+{
+	const FootSyncMarkers::FAnalysis& Analysis = static_cast<const FootSyncMarkers::FAnalysis&>(InAnalysis);
 
-				if (bCreateCurve)
-					UAnimationBlueprintLibrary::AddFloatCurveKey(AnimationSequence, CurveName, Time, BoneDistance);
+	RemoveSyncTrack(AnimationSequence);
+	UAnimationBlueprintLibrary::AddAnimationNotifyTrack(AnimationSequence, NotifyTrackName, FLinearColor::Green);
 
-				if (Frame > 0 && FMath::Sign(BoneDistance) != FMath::Sign(LastBoneDistance))
-				{
-					if (!bMarkFootPlantOnly || BoneDistance < 0.0f)
-					{
-						const FName MarkerName = *(CurrentBoneName.ToString().Append((BoneDistance >= 0.0f ? TEXT("_step_fwd") : bMarkFootPlantOnly ? TEXT("_plant") : TEXT("_step_bwd"))));
-						const float MarkerTime = (BoneDistance == 0.0f) ? Time : (Time - (TimePerFrame * FMath::Abs(BoneDistance / (BoneDistance - LastBoneDistance))));
-						UAnimationBlueprintLibrary::AddAnimationSyncMarker(AnimationSequence, MarkerName, MarkerTime, NotifyTrackName);
-					}
-				}
+	for (const FootSyncMarkers::FFootAnalysis& Foot : Analysis.Feet)
+	{
+		if (bCreateCurve)
+		{
+			if (UAnimationBlueprintLibrary::DoesCurveExist(AnimationSequence, Foot.CurveName, ERawCurveTrackTypes::RCT_Float))
+			{
+				UAnimationBlueprintLibrary::RemoveCurve(AnimationSequence, Foot.CurveName);
+			}
+			UAnimationBlueprintLibrary::AddCurve(AnimationSequence, Foot.CurveName, ERawCurveTrackTypes::RCT_Float, false);
+			CurveKeyReduction::SetFloatCurveKeys(AnimationSequence, Foot.CurveName, Foot.CurveKeys.Keys);
 
-				LastBoneDistance = BoneDistance;
+			if (KeyReduction.bReduceKeys)
+			{
+				CurveKeyReduction::LogResult(AnimationSequence, Foot.CurveName, Foot.CurveKeys);
 			}
 		}
 
-		UAnimationBlueprintLibrary::FinalizeBoneAnimation(AnimationSequence);
+		for (const TPair<FName, float>& Marker : Foot.Markers)
+		{
+			UAnimationBlueprintLibrary::AddAnimationSyncMarker(AnimationSequence, Marker.Key, Marker.Value, NotifyTrackName);
+		}
 	}
 
+	UAnimationBlueprintLibrary::FinalizeBoneAnimation(AnimationSequence);
 }
 
 void UAnimationModifier_FootSyncMarkers::OnRevert_Implementation(UAnimSequence* AnimationSequence)
@@ -3,8 +3,10 @@
 #pragma once
 
 #include "CoreMinimal.h"
-#include "AnimationModifier.h"
+#include "AnimationModifiers/BatchAnimationModifier.h"
 #include "Animation/AnimTypes.h"
+#include "AnimationModifiers/FootContactAnalysis.h"
+#include "Curves/CurveKeyReduction.h"
 
 #include "AnimationModifier_FootSyncMarkers.generated.h"
 
@@ -34,7 +36,7 @@ struct FBoneModifier
  * C++ implementation based on the work of Giuseppe Portelli <https://github.com/gportelli/FootSyncMarkers>
  */
 UCLASS(meta=(DisplayName="Foot Sync Markers"))
-class UAnimationModifier_FootSyncMarkers : public UAnimationModifier
+class UAnimationModifier_FootSyncMarkers : public UBatchAnimationModifier
 {
 	GENERATED_BODY()
 
@@ -48,8 +50,6 @@ protected:
 
 	virtual void RemoveSyncTrack(UAnimSequence* AnimationSequence);
 
-	virtual FVector GetRelativeBoneLocationAtTime(UAnimSequence* AnimationSequence, FName TargetBoneName, FName RelativeBoneName, float Time);
-
 public:
 
 	/** Only animations with a path containing this filter as a case insensitive substring will be affected. Empty value matches all. */
@@ -89,14 +89,30 @@ public:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = Settings, AdvancedDisplay)
 	uint32 bMarkFootPlantOnly: 1;
 
+	/** Place markers where feet are put down and lifted instead of where they cross the pelvis along the movement axis. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = Settings, AdvancedDisplay)
+	uint32 bMarkFootContacts : 1;
+
+	/** Thresholds detecting foot contacts. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = Settings, AdvancedDisplay, meta = (EditCondition = "bMarkFootContacts"))
+	FFootContactSettings FootContact;
+
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = Settings, AdvancedDisplay)
 	uint32 bCreateCurve : 1;
 
+	/** Reduction of the keys added to the curves, one per frame otherwise. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = Settings, AdvancedDisplay, meta = (EditCondition = "bCreateCurve"))
+	FCurveKeyReductionSettings KeyReduction;
+
 	virtual bool CanEditChange(const FProperty* InProperty) const override;
 
-	virtual void OnApply_Implementation(UAnimSequence* AnimationSequence) override;
 	virtual void OnRevert_Implementation(UAnimSequence* AnimationSequence) override;
 
+	// Begin UBatchAnimationModifier Interface
+	virtual TSharedPtr<FAnimationModifierAnalysis> AnalyzeSequence(const UAnimSequence* AnimationSequence, const FAnimSequencePoseCache& PoseCache) const override;
+	virtual void CommitAnalysis(UAnimSequence* AnimationSequence, const FAnimationModifierAnalysis& Analysis) override;
+	// End UBatchAnimationModifier Interface
+
 	UFUNCTION(BlueprintCallable, BlueprintPure, meta = (DisplayName = "SyncTrackName"))
 	FName GetSyncTrackName() const;
 };
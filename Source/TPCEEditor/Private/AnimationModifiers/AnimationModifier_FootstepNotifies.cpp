@@ -1,6 +1,9 @@
 // This source code is licensed under the MIT license found in the LICENSE file in the root directory of this source tree.
 
 #include "AnimationModifiers/AnimationModifier_FootstepNotifies.h"
+#include "AnimationModifiers/AnimSequencePoseCache.h"
+#include "AnimationModifiers/FootContactAnalysis.h"
+#include "Curves/CurveKeyReduction.h"
 
 #include "Animation/AnimSequence.h"
 #include "Animation/AnimNotifies/AnimNotify.h"
@@ -15,119 +18,90 @@ UAnimationModifier_FootstepNotifies::UAnimationModifier_FootstepNotifies()
 	FootDownThreshold = 1.0f;
 	FootLiftThreshold = 2.0f;
 	NudgeEvenThreshold = 0.06f;
+	bCreateLockCurves = false;
+	LockCurveSuffix = TEXT("_lock");
+	LockBlendTime = 0.1f;
 
 	FootBoneNames.Add(NAME_Foot_L);
 	FootBoneNames.Add(NAME_Foot_R);
 }
 
-FVector UAnimationModifier_FootstepNotifies::GetBoneWorldLocationAtTime(UAnimSequence* AnimationSequence, FName TargetBoneName, float Time)
+FVector UAnimationModifier_FootstepNotifies::GetRefBoneWorldLocation(const FReferenceSkeleton& RefSkel, FName TargetBoneName) const
 {
-	FTransform Transform;
-	TArray<FName> BonePath;
-	UAnimationBlueprintLibrary::FindBonePathToRoot(AnimationSequence, TargetBoneName, BonePath);
-
-	for (auto& BoneName : BonePath)
-	{
-		FTransform BonePose;
-		UAnimationBlueprintLibrary::GetBonePoseForTime(AnimationSequence, BoneName, Time, false, BonePose);
-		Transform *= BonePose;
-	}
-
-	return Transform.GetLocation();
+	return FFootContactAnalysis::GetRefBoneComponentLocation(RefSkel, TargetBoneName);
 }
 
-FVector UAnimationModifier_FootstepNotifies::GetRefBoneWorldLocation(const FReferenceSkeleton& RefSkel, FName TargetBoneName)
+FName UAnimationModifier_FootstepNotifies::GetLockCurveName(FName FootBoneName) const
 {
-	FTransform Transform;
-	const int32 BoneIndex = RefSkel.FindBoneIndex(TargetBoneName);
+	return *(FootBoneName.ToString() + LockCurveSuffix);
+}
 
-	if (BoneIndex != INDEX_NONE)
+namespace FootstepNotifies
+{
+	struct FAnalysis : public FAnimationModifierAnalysis
 	{
-		Transform = RefSkel.GetRefBonePose()[BoneIndex];
-		int32 ParentBoneIndex = RefSkel.GetRefBoneInfo()[BoneIndex].ParentIndex;
+		// Foot bone and time of each foot contact
+		TArray<TPair<FName, float>> Notifies;
 
-		while (ParentBoneIndex != INDEX_NONE)
-		{
-			Transform *= RefSkel.GetRefBonePose()[ParentBoneIndex];
-			ParentBoneIndex = RefSkel.GetRefBoneInfo()[ParentBoneIndex].ParentIndex;
-		}
-	}
-
-	return Transform.GetLocation();
+		// Lock curve name and keys of each foot
+		TArray<TPair<FName, TArray<FRichCurveKey>>> LockCurves;
+	};
 }
 
-void UAnimationModifier_FootstepNotifies::OnApply_Implementation(UAnimSequence* AnimationSequence)
+TSharedPtr<FAnimationModifierAnalysis> UAnimationModifier_FootstepNotifies::AnalyzeSequence(const UAnimSequence* AnimationSequence, const FAnimSequencePoseCache& PoseCache) const
 {
-	Super::OnApply_Implementation(AnimationSequence);
-
 	FString Path = GetPathNameSafe(AnimationSequence);
 	if (PathFilter != NAME_None && !Path.Contains(PathFilter.ToString()))
 	{
 		// Animation filtered, don't apply
-		return;
+		return nullptr;
 	}
 
 	const FReferenceSkeleton& RefSkel = AnimationSequence->GetSkeleton()->GetReferenceSkeleton();
 	const float TotalTime = AnimationSequence->GetPlayLength();
-	const int32 NumFrames = AnimationSequence->GetNumberOfFrames();
-	const float TimePerFrame = TotalTime / NumFrames;
 
-	UAnimationBlueprintLibrary::RemoveAnimationNotifyTrack(AnimationSequence, NotifyTrackName);
-	UAnimationBlueprintLibrary::AddAnimationNotifyTrack(AnimationSequence, NotifyTrackName, FLinearColor::Green);
-	const int32 NotifyTrackIndex = UAnimationBlueprintLibrary::GetTrackIndexForAnimationNotifyTrackName(AnimationSequence, NotifyTrackName);
-	TArray<FAnimNotifyEvent*> Notifies;
+	TSharedRef<FootstepNotifies::FAnalysis> Analysis = MakeShared<FootstepNotifies::FAnalysis>();
+	TArray<TPair<FName, float>>& Notifies = Analysis->Notifies;
 
+	TArray<TPair<FName, float>> FootBones;
 	for (const FName& FootBoneName : FootBoneNames)
 	{
-		// Starting foot position
-		const float FootHeight = GetRefBoneWorldLocation(RefSkel, FootBoneName).Z + KINDA_SMALL_NUMBER;
-		const float StartTime = AnimationSequence->GetTimeAtFrame(0);
-		const FVector StartBoneLocation = GetBoneWorldLocationAtTime(AnimationSequence, FootBoneName, StartTime);
-		FVector PrevBoneDelta = FVector::ZeroVector;
-		bool bPrevFootDown = StartBoneLocation.Z <= FootHeight + FootDownThreshold;
-
-		for (int32 Frame = 1; Frame <= NumFrames; ++Frame)
-		{
-			const float PrevTime = AnimationSequence->GetTimeAtFrame(Frame - 1);
-			float Time = AnimationSequence->GetTimeAtFrame(Frame);
-			if (Frame == NumFrames)
-			{
-				// Subtract a little time from the last frame to avoid errors
-				Time -= 0.001f;
-			}
+		FootBones.Emplace(FootBoneName, GetRefBoneWorldLocation(RefSkel, FootBoneName).Z + KINDA_SMALL_NUMBER);
+	}
 
-			const FVector PrevBoneLocation = GetBoneWorldLocationAtTime(AnimationSequence, FootBoneName, PrevTime);
-			const FVector BoneLocation = GetBoneWorldLocationAtTime(AnimationSequence, FootBoneName, Time);
-			const FVector BoneDelta = BoneLocation - PrevBoneLocation;
-			bool bFootDown = BoneLocation.Z <= (bPrevFootDown ? FootHeight + FootLiftThreshold : FootHeight + FootDownThreshold);
+	FFootContactSettings ContactSettings;
+	ContactSettings.FootDownThreshold = FootDownThreshold;
+	ContactSettings.FootLiftThreshold = FootLiftThreshold;
+	const FFootContactAnalysis ContactAnalysis(PoseCache, FootBones, ContactSettings);
 
-			if (!bPrevFootDown && bFootDown)
+	for (const FFootContactTrack& Foot : ContactAnalysis.GetFeet())
+	{
+		// A footstep is the foot being put down, not already down when the sequence starts
+		for (const FFootContact& Contact : Foot.Contacts)
+		{
+			if (!FFootContactAnalysis::StartsAtBeginning(Contact))
 			{
-				FAnimNotifyEvent& NewEvent = AnimationSequence->Notifies.AddDefaulted_GetRef();
-				NewEvent.NotifyName = FootBoneName;
-				NewEvent.Link(AnimationSequence, Time);
-				NewEvent.TriggerTimeOffset = GetTriggerTimeOffsetForType(AnimationSequence->CalculateOffsetForNotify(Time));
-				NewEvent.TrackIndex = NotifyTrackIndex;
-				NewEvent.NotifyStateClass = nullptr;
-				Notifies.Add(&NewEvent);
+				Notifies.Emplace(Foot.BoneName, Contact.StartTime);
 			}
+		}
 
-			bPrevFootDown = bFootDown;
-			PrevBoneDelta = BoneDelta;
+		if (bCreateLockCurves)
+		{
+			Analysis->LockCurves.Emplace(GetLockCurveName(Foot.BoneName), ContactAnalysis.MakeLockCurveKeys(Foot, LockBlendTime));
 		}
 	}
 
-	if (NudgeEvenThreshold > 0.0f)
+	if (NudgeEvenThreshold > 0.0f && Notifies.Num() > 0)
 	{
 		// Sort notifies by time
-		Notifies.Sort([](FAnimNotifyEvent& A, FAnimNotifyEvent& B) { return A.GetTime() < B.GetTime(); });
+		Notifies.Sort([](const TPair<FName, float>& A, const TPair<FName, float>& B) { return A.Value < B.Value; });
 
 		// Calculate the notify times as if they were evenly spaced. If the actual timing is close, nudge them towards the target values
 		const int32 NumNotifies = Notifies.Num();
 		float AverageTime = 0.0f;
-		for (FAnimNotifyEvent* Event : Notifies)
+		for (const TPair<FName, float>& Notify : Notifies)
 		{
-			AverageTime += Event->GetTime();
+			AverageTime += Notify.Value;
 		}
 		AverageTime /= NumNotifies;
 
@@ -137,10 +111,9 @@ void UAnimationModifier_FootstepNotifies::OnApply_Implementation(UAnimSequence*
 		bool bEvenlySpaced = true;
 		for (int32 NotifyIndex = 0; NotifyIndex < NumNotifies; NotifyIndex++)
 		{
-			FAnimNotifyEvent* Event = Notifies[NotifyIndex];
 			const float TargetTime = StartTime + TimeBetweenNotifies * NotifyIndex;
 
-			if (FMath::Abs(TargetTime - Event->GetTime()) > NudgeEvenThreshold)
+			if (FMath::Abs(TargetTime - Notifies[NotifyIndex].Value) > NudgeEvenThreshold)
 			{
 				bEvenlySpaced = false;
 				break;
@@ -152,19 +125,49 @@ void UAnimationModifier_FootstepNotifies::OnApply_Implementation(UAnimSequence*
 			// Determined that the intent is for the notifies to be evenly spaced, so go over them again
 			for (int32 NotifyIndex = 0; NotifyIndex < NumNotifies; NotifyIndex++)
 			{
-				FAnimNotifyEvent* Event = Notifies[NotifyIndex];
 				float TargetTime = StartTime + TimeBetweenNotifies * NotifyIndex;
 				if (TargetTime < 0.0f)
 				{
 					TargetTime += TotalTime;
 				}
 
-				Event->SetTime(TargetTime);
-				Event->TriggerTimeOffset = GetTriggerTimeOffsetForType(AnimationSequence->CalculateOffsetForNotify(TargetTime));
+				Notifies[NotifyIndex].Value = TargetTime;
 			}
 		}
 	}
 
+	return Analysis;
+}
+
+void UAnimationModifier_FootstepNotifies::CommitAnalysis(UAnimSequence* AnimationSequence, const FAnimationModifierAnalysis& InAnalysis)
+{
+	const FootstepNotifies::FAnalysis& Analysis = static_cast<const FootstepNotifies::FAnalysis&>(InAnalysis);
+
+	UAnimationBlueprintLibrary::RemoveAnimationNotifyTrack(AnimationSequence, NotifyTrackName);
+	UAnimationBlueprintLibrary::AddAnimationNotifyTrack(AnimationSequence, NotifyTrackName, FLinearColor::Green);
+	const int32 NotifyTrackIndex = UAnimationBlueprintLibrary::GetTrackIndexForAnimationNotifyTrackName(AnimationSequence, NotifyTrackName);
+
+	AnimationSequence->Notifies.Reserve(AnimationSequence->Notifies.Num() + Analysis.Notifies.Num());
+	for (const TPair<FName, float>& Notify : Analysis.Notifies)
+	{
+		FAnimNotifyEvent& NewEvent = AnimationSequence->Notifies.AddDefaulted_GetRef();
+		NewEvent.NotifyName = Notify.Key;
+		NewEvent.Link(AnimationSequence, Notify.Value);
+		NewEvent.TriggerTimeOffset = GetTriggerTimeOffsetForType(AnimationSequence->CalculateOffsetForNotify(Notify.Value));
+		NewEvent.TrackIndex = NotifyTrackIndex;
+		NewEvent.NotifyStateClass = nullptr;
+	}
+
+	for (const TPair<FName, TArray<FRichCurveKey>>& LockCurve : Analysis.LockCurves)
+	{
+		if (UAnimationBlueprintLibrary::DoesCurveExist(AnimationSequence, LockCurve.Key, ERawCurveTrackTypes::RCT_Float))
+		{
+			UAnimationBlueprintLibrary::RemoveCurve(AnimationSequence, LockCurve.Key);
+		}
+		UAnimationBlueprintLibrary::AddCurve(AnimationSequence, LockCurve.Key, ERawCurveTrackTypes::RCT_Float, false);
+		CurveKeyReduction::SetFloatCurveKeys(AnimationSequence, LockCurve.Key, LockCurve.Value);
+	}
+
 	UAnimationBlueprintLibrary::FinalizeBoneAnimation(AnimationSequence);
 }
 
@@ -173,4 +176,16 @@ void UAnimationModifier_FootstepNotifies::OnRevert_Implementation(UAnimSequence*
 	Super::OnRevert_Implementation(AnimationSequence);
 
 	UAnimationBlueprintLibrary::RemoveAnimationNotifyTrack(AnimationSequence, NotifyTrackName);
+
+	if (bCreateLockCurves)
+	{
+		for (const FName& FootBoneName : FootBoneNames)
+		{
+			const FName CurveName = GetLockCurveName(FootBoneName);
+			if (UAnimationBlueprintLibrary::DoesCurveExist(AnimationSequence, CurveName, ERawCurveTrackTypes::RCT_Float))
+			{
+				UAnimationBlueprintLibrary::RemoveCurve(AnimationSequence, CurveName);
+			}
+		}
+	}
 }
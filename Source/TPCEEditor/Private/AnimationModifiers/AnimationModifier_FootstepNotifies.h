@@ -3,7 +3,7 @@
 #pragma once
 
 #include "CoreMinimal.h"
-#include "AnimationModifier.h"
+#include "AnimationModifiers/BatchAnimationModifier.h"
 #include "Animation/AnimTypes.h"
 
 #include "AnimationModifier_FootstepNotifies.generated.h"
@@ -14,7 +14,7 @@ class UAnimSequence;
  * Animation Modifier to generate notifies on foot contacts.
  */
 UCLASS(meta = (DisplayName = "Footstep Notifies"))
-class UAnimationModifier_FootstepNotifies : public UAnimationModifier
+class UAnimationModifier_FootstepNotifies : public UBatchAnimationModifier
 {
 	GENERATED_BODY()
 
@@ -24,8 +24,7 @@ public:
 	UAnimationModifier_FootstepNotifies();
 
 protected:
-	virtual FVector GetBoneWorldLocationAtTime(UAnimSequence* AnimationSequence, FName TargetBoneName, float Time);
-	virtual FVector GetRefBoneWorldLocation(const struct FReferenceSkeleton& RefSkel, FName TargetBoneName);
+	virtual FVector GetRefBoneWorldLocation(const struct FReferenceSkeleton& RefSkel, FName TargetBoneName) const;
 
 public:
 	/** Only animations with a path containing this filter as a case insensitive substring will be affected. Empty value matches all. */
@@ -48,6 +47,25 @@ public:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = Settings)
 	TArray<FName> FootBoneNames;
 
-	virtual void OnApply_Implementation(UAnimSequence* AnimationSequence) override;
+	/** Create a curve per foot that is one while the foot is planted, read by foot placement to skip ground traces. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = Settings, AdvancedDisplay)
+	uint32 bCreateLockCurves : 1;
+
+	/** Appended to the foot bone name to name its lock curve. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = Settings, AdvancedDisplay, meta = (EditCondition = "bCreateLockCurves"))
+	FString LockCurveSuffix;
+
+	/** Time for lock curves to blend in after a foot is planted and out before it's lifted. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = Settings, AdvancedDisplay, meta = (EditCondition = "bCreateLockCurves", ClampMin = "0"))
+	float LockBlendTime;
+
 	virtual void OnRevert_Implementation(UAnimSequence* AnimationSequence) override;
+
+	// Begin UBatchAnimationModifier Interface
+	virtual TSharedPtr<FAnimationModifierAnalysis> AnalyzeSequence(const UAnimSequence* AnimationSequence, const FAnimSequencePoseCache& PoseCache) const override;
+	virtual void CommitAnalysis(UAnimSequence* AnimationSequence, const FAnimationModifierAnalysis& Analysis) override;
+	// End UBatchAnimationModifier Interface
+
+	UFUNCTION(BlueprintCallable, BlueprintPure)
+	FName GetLockCurveName(FName FootBoneName) const;
 };
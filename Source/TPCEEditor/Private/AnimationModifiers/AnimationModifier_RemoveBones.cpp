@@ -1,6 +1,7 @@
 // This source code is licensed under the MIT license found in the LICENSE file in the root directory of this source tree.
 
 #include "AnimationModifiers/AnimationModifier_RemoveBones.h"
+#include "AnimationModifiers/BoneFilterMatcher.h"
 
 #include "Animation/AnimSequence.h"
 #include "UObject/UObjectBaseUtility.h"
@@ -21,87 +22,28 @@ void UAnimationModifier_RemoveBones::OnApply_Implementation(UAnimSequence* Anima
 		return;
 	}
 
-	// Copy bone filters with or without case and remove the '+' prefix
-	TArray<FWildcardString> BoneWildcards;
-	const int32 NumFilters = BoneFilters.Num();
-	BoneWildcards.Reserve(NumFilters);
-	for (const FString& BoneFilter : BoneFilters)
+	if (!BoneFilterMatcher.IsValid() || !BoneFilterMatcher->IsCompiledFrom(BoneFilters, bCaseInsensitive))
 	{
-		const FString NoPrefix = BoneFilter.StartsWith(TEXT("+")) || BoneFilter.StartsWith(TEXT("-")) ? BoneFilter.RightChop(1) : BoneFilter;
-		BoneWildcards.Add(bCaseInsensitive ? NoPrefix.ToLower() : NoPrefix);
+		BoneFilterMatcher = MakeShared<FBoneFilterMatcher>(BoneFilters, bCaseInsensitive);
 	}
 
-	// Find indices of all the bones that match the filters
-	TMap<int32, bool> MatchingBones;
 	USkeleton* Skeleton = AnimationSequence->GetSkeleton();
 	if (Skeleton)
 	{
-		const FReferenceSkeleton& RefSkeleton = Skeleton->GetReferenceSkeleton();
-
-		// Bones are in strictly increasing order
-		// Adding a bone to MatchingBones with True will knock out the entire branch
-		const int32 NumBones = RefSkeleton.GetNum();
-
-		for (int32 BoneIndex = 0; BoneIndex < NumBones; BoneIndex++)
-		{
-			FString BoneName = RefSkeleton.GetBoneName(BoneIndex).ToString();
-			if (bCaseInsensitive)
-			{
-				BoneName.ToLowerInline();
-			}
-
-			const int32 ParentBoneIndex = RefSkeleton.GetParentIndex(BoneIndex);
-			if (bool* bWithChildren = MatchingBones.Find(ParentBoneIndex))
-			{
-				if (*bWithChildren)
-				{
-					bool bExcludeChildren = false;
-					for (int32 FilterIndex = 0; FilterIndex < NumFilters; FilterIndex++)
-					{
-						if (BoneWildcards[FilterIndex].IsMatch(BoneName))
-						{
-							bExcludeChildren = BoneFilters[FilterIndex].StartsWith(TEXT("-"));
-							if (bExcludeChildren)
-							{
-								// No need to keep matching
-								break;
-							}
-						}
-					}
-
-					if (!bExcludeChildren)
-					{
-						// Parent bone matched and included children, so add this and include subsequent children
-						MatchingBones.Add(BoneIndex, true);
-						continue;
-					}
-				}
-			}
-
-			for (int32 FilterIndex = 0; FilterIndex < NumFilters; FilterIndex++)
-			{
-				if (BoneWildcards[FilterIndex].IsMatch(BoneName) && !BoneFilters[FilterIndex].StartsWith(TEXT("-")))
-				{
-					bool bIncludeChildren = BoneFilters[FilterIndex].StartsWith(TEXT("+"));
-					MatchingBones.Add(BoneIndex, bIncludeChildren);
-					if (bIncludeChildren)
-					{
-						// No need to keep matching
-						break;
-					}
-				}
-			}
-		}
+		// Bones matching the filters, shared by all sequences of the skeleton
+		const TSharedRef<const TBitArray<>> BoneMask = BoneFilterMatcher->GetBoneMask(Skeleton);
 
 		// Can't call UAnimSequence::RemoveTrack directly, so unfortunately UAnimationBlueprintLibrary has to be relied on
 		// Keep in mind GetAnimationTrackNames returns the actual array, so we must iterate backwards while removing
 		const TArray<FName>& TrackNames = AnimationSequence->GetAnimationTrackNames();
+		const TArray<FTrackToSkeletonMap>& TrackToSkeletonMap = AnimationSequence->GetRawTrackToSkeletonMapTable();
 		for (int32 TrackIndex = TrackNames.Num() - 1; TrackIndex >= 0; --TrackIndex)
 		{
-			const FName TrackName = TrackNames[TrackIndex];
-			const int32 BoneIndex = RefSkeleton.FindBoneIndex(TrackName);
-			if (MatchingBones.Contains(BoneIndex) != bInvertSelection)
+			const int32 BoneIndex = TrackToSkeletonMap[TrackIndex].BoneTreeIndex;
+			const bool bMatching = BoneMask->IsValidIndex(BoneIndex) && (*BoneMask)[BoneIndex];
+			if (bMatching != bInvertSelection)
 			{
+				const FName TrackName = TrackNames[TrackIndex];
 				UAnimationBlueprintLibrary::RemoveBoneAnimation(AnimationSequence, TrackName, /*bIncludeChildren=*/false, /*bFinalize=*/false);
 			}
 		}
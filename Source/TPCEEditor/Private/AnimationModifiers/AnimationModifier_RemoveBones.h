@@ -10,6 +10,7 @@
 #include "AnimationModifier_RemoveBones.generated.h"
 
 class UAnimSequence;
+class FBoneFilterMatcher;
 
 /**
  * Animation Modifier to remove sets of bones.
@@ -52,4 +53,9 @@ public:
 	bool bInvertSelection;
 
 	virtual void OnApply_Implementation(UAnimSequence* AnimationSequence) override;
+
+private:
+
+	// Bone filters compiled on first apply, and again if they changed
+	TSharedPtr<FBoneFilterMatcher> BoneFilterMatcher;
 };
@@ -0,0 +1,120 @@
+// This source code is licensed under the MIT license found in the LICENSE file in the root directory of this source tree.
+
+#include "AnimationModifiers/BatchAnimationModifier.h"
+#include "AnimationModifiers/AnimSequencePoseCache.h"
+
+#include "Animation/AnimSequence.h"
+#include "Async/Async.h"
+#include "HAL/ThreadSafeBool.h"
+#include "Misc/QueuedThreadPool.h"
+#include "Misc/ScopedSlowTask.h"
+#include "ScopedTransaction.h"
+
+#define LOCTEXT_NAMESPACE "BatchAnimationModifier"
+
+void UBatchAnimationModifier::OnApply_Implementation(UAnimSequence* AnimationSequence)
+{
+	Super::OnApply_Implementation(AnimationSequence);
+
+	const TSharedPtr<FAnimationModifierAnalysis> Analysis = AnalyzeSequence(AnimationSequence, *FAnimSequencePoseCache::Get(AnimationSequence));
+	if (Analysis.IsValid())
+	{
+		CommitAnalysis(AnimationSequence, *Analysis);
+	}
+}
+
+int32 UBatchAnimationModifier::ApplyToSequences(TArrayView<UAnimSequence* const> Sequences, bool bShowProgress)
+{
+	check(IsInGameThread());
+
+	const int32 NumSequences = Sequences.Num();
+	FThreadSafeBool bCancelled(false);
+
+	FScopedSlowTask SlowTask(NumSequences, FText::Format(LOCTEXT("ApplyingModifier", "Applying {0}"), GetClass()->GetDisplayNameText()), bShowProgress);
+	if (bShowProgress)
+	{
+		SlowTask.MakeDialog(true);
+	}
+
+	const FScopedTransaction Transaction(FText::Format(LOCTEXT("ApplyModifierTransaction", "Apply {0}"), GetClass()->GetDisplayNameText()));
+
+	// Poses are sampled on the game thread and only the analyses run on workers. The number of sequences sampled ahead
+	// of the commits is limited so that their poses don't all stay in memory.
+	const int32 MaxPendingAnalyses = FMath::Max(GThreadPool->GetNumThreads(), 1) * 2;
+
+	TArray<TFuture<TSharedPtr<FAnimationModifierAnalysis>>> Analyses;
+	TArray<TSharedPtr<FAnimSequencePoseCache>> PoseCaches;
+	Analyses.SetNum(NumSequences);
+	PoseCaches.SetNum(NumSequences);
+
+	// Commit in order as analyses complete, keeping the dialog responsive while waiting
+	int32 NumApplied = 0;
+	int32 NumSampled = 0;
+	for (int32 Index = 0; Index < NumSequences && !bCancelled; ++Index)
+	{
+		for (; NumSampled < NumSequences && NumSampled - Index < MaxPendingAnalyses && !bCancelled; ++NumSampled)
+		{
+			const UAnimSequence* AnimationSequence = Sequences[NumSampled];
+			if (AnimationSequence == nullptr)
+			{
+				continue;
+			}
+
+			PoseCaches[NumSampled] = FAnimSequencePoseCache::Get(AnimationSequence);
+			const FAnimSequencePoseCache* PoseCache = PoseCaches[NumSampled].Get();
+			Analyses[NumSampled] = Async(EAsyncExecution::ThreadPool, [this, AnimationSequence, PoseCache, &bCancelled]() -> TSharedPtr<FAnimationModifierAnalysis>
+			{
+				return bCancelled ? nullptr : AnalyzeSequence(AnimationSequence, *PoseCache);
+			});
+
+			SlowTask.TickProgress();
+			bCancelled = SlowTask.ShouldCancel();
+		}
+
+		while (!bCancelled && Analyses[Index].IsValid() && !Analyses[Index].WaitFor(FTimespan::FromMilliseconds(50.0)))
+		{
+			SlowTask.TickProgress();
+			bCancelled = SlowTask.ShouldCancel();
+		}
+
+		if (bCancelled || SlowTask.ShouldCancel())
+		{
+			bCancelled = true;
+			break;
+		}
+
+		UAnimSequence* Sequence = Sequences[Index];
+		SlowTask.EnterProgressFrame(1.f, FText::FromString(GetNameSafe(Sequence)));
+		if (!Analyses[Index].IsValid())
+		{
+			continue;
+		}
+
+		// Commit directly, ApplyToAnimationSequence would revert and record revisions on this instance, which is shared by
+		// all sequences and owned by none of them
+		const TSharedPtr<FAnimationModifierAnalysis> Analysis = Analyses[Index].Get();
+		PoseCaches[Index].Reset();
+		if (Analysis.IsValid())
+		{
+			Sequence->Modify();
+			CommitAnalysis(Sequence, *Analysis);
+			Sequence->PostEditChange();
+			Sequence->MarkPackageDirty();
+
+			NumApplied++;
+		}
+	}
+
+	// Tasks reference this modifier, the cancel flag and the pose caches, so wait for those still running
+	for (TFuture<TSharedPtr<FAnimationModifierAnalysis>>& Analysis : Analyses)
+	{
+		if (Analysis.IsValid())
+		{
+			Analysis.Wait();
+		}
+	}
+
+	return NumApplied;
+}
+
+#undef LOCTEXT_NAMESPACE
@@ -0,0 +1,49 @@
+// This source code is licensed under the MIT license found in the LICENSE file in the root directory of this source tree.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AnimationModifier.h"
+
+#include "BatchAnimationModifier.generated.h"
+
+class UAnimSequence;
+class FAnimSequencePoseCache;
+
+/** Result of analyzing a sequence, committed to the sequence by the modifier that produced it. */
+struct FAnimationModifierAnalysis
+{
+	virtual ~FAnimationModifierAnalysis() {}
+};
+
+/**
+ * Animation Modifier split into a pure analysis of the sequence and a commit of the result.
+ * When applied to many sequences at once, poses are sampled and results committed in order on the game thread while
+ * analyses run in parallel on worker threads, so that only sampling and the mutation of notifies, curves and sync markers
+ * is serialized.
+ */
+UCLASS(Abstract)
+class UBatchAnimationModifier : public UAnimationModifier
+{
+	GENERATED_BODY()
+
+public:
+
+	virtual void OnApply_Implementation(UAnimSequence* AnimationSequence) override;
+
+	/**
+	 * Analyze a sequence. May be called from worker threads, so it must not modify the sequence or this modifier.
+	 * Return null if the sequence should not be modified.
+	 */
+	virtual TSharedPtr<FAnimationModifierAnalysis> AnalyzeSequence(const UAnimSequence* AnimationSequence, const FAnimSequencePoseCache& PoseCache) const PURE_VIRTUAL(UBatchAnimationModifier::AnalyzeSequence, return nullptr;);
+
+	/** Modify a sequence with the result of AnalyzeSequence. Called on the game thread. */
+	virtual void CommitAnalysis(UAnimSequence* AnimationSequence, const FAnimationModifierAnalysis& Analysis) PURE_VIRTUAL(UBatchAnimationModifier::CommitAnalysis, );
+
+	/**
+	 * Apply the modifier to sequences, analyzing them in parallel. Shows a cancelable progress dialog if bShowProgress.
+	 * The modifier is not added to the sequences, so it can't be reverted from the Animation Modifiers tab, only undone.
+	 * @return The number of sequences the modifier was applied to.
+	 */
+	int32 ApplyToSequences(TArrayView<UAnimSequence* const> Sequences, bool bShowProgress = true);
+};
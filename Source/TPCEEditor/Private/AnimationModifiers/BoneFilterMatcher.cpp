@@ -0,0 +1,164 @@
+// This source code is licensed under the MIT license found in the LICENSE file in the root directory of this source tree.
+
+#include "AnimationModifiers/BoneFilterMatcher.h"
+#include "AnimationModifiers/RecentlyUsedList.h"
+
+#include "Animation/Skeleton.h"
+#include "ReferenceSkeleton.h"
+
+namespace BoneFilterMatcher
+{
+	struct FSharedMask
+	{
+		TWeakObjectPtr<const USkeleton> Skeleton;
+		FGuid SkeletonGuid;
+		int32 NumBones;
+		FString Signature;
+		TSharedRef<const TBitArray<>> Mask;
+	};
+
+	// Enough for a few filter sets applied to the skeletons of a library
+	static TRecentlyUsedList<FSharedMask, 8> SharedMasks;
+}
+
+FBoneFilterMatcher::FBoneFilterMatcher(TArrayView<const FString> BoneFilters, bool bInCaseInsensitive)
+	: bCaseInsensitive(bInCaseInsensitive)
+	, bAnyWildcard(false)
+	, Signature(MakeSignature(BoneFilters, bInCaseInsensitive))
+{
+	Filters.Reserve(BoneFilters.Num());
+	for (const FString& BoneFilter : BoneFilters)
+	{
+		FFilter& Filter = Filters.AddDefaulted_GetRef();
+		Filter.Children = BoneFilter.StartsWith(TEXT("+")) ? EChildren::Include : BoneFilter.StartsWith(TEXT("-")) ? EChildren::Exclude : EChildren::None;
+
+		const FString NoPrefix = Filter.Children != EChildren::None ? BoneFilter.RightChop(1) : BoneFilter;
+		Filter.bWildcard = FWildcardString::ContainsWildcards(*NoPrefix);
+		if (Filter.bWildcard)
+		{
+			Filter.Pattern = bCaseInsensitive ? NoPrefix.ToLower() : NoPrefix;
+			bAnyWildcard = true;
+		}
+		else
+		{
+			Filter.Literal = *NoPrefix;
+		}
+	}
+}
+
+bool FBoneFilterMatcher::IsCompiledFrom(TArrayView<const FString> BoneFilters, bool bInCaseInsensitive) const
+{
+	return Signature == MakeSignature(BoneFilters, bInCaseInsensitive);
+}
+
+FString FBoneFilterMatcher::MakeSignature(TArrayView<const FString> BoneFilters, bool bInCaseInsensitive)
+{
+	FString Result = bInCaseInsensitive ? TEXT("i") : TEXT("s");
+	for (const FString& BoneFilter : BoneFilters)
+	{
+		Result += TEXT("\n") + BoneFilter;
+	}
+
+	return Result;
+}
+
+TSharedRef<const TBitArray<>> FBoneFilterMatcher::GetBoneMask(const USkeleton* Skeleton) const
+{
+	using namespace BoneFilterMatcher;
+
+	check(IsInGameThread());
+
+	if (Skeleton == nullptr)
+	{
+		return MakeShared<TBitArray<>>();
+	}
+
+	const FReferenceSkeleton& RefSkeleton = Skeleton->GetReferenceSkeleton();
+	const FGuid SkeletonGuid = Skeleton->GetGuid();
+	const int32 NumBones = RefSkeleton.GetNum();
+
+	const FSharedMask* Found = SharedMasks.Find([this, Skeleton, &SkeletonGuid, NumBones](const FSharedMask& SharedMask)
+	{
+		return SharedMask.Skeleton.Get() == Skeleton && SharedMask.SkeletonGuid == SkeletonGuid && SharedMask.NumBones == NumBones && SharedMask.Signature == Signature;
+	});
+	if (Found)
+	{
+		return Found->Mask;
+	}
+
+	// Remove masks of deleted skeletons before adding the new one
+	return SharedMasks.Add(FSharedMask{ Skeleton, SkeletonGuid, NumBones, Signature, MakeShared<TBitArray<>>(ComputeBoneMask(RefSkeleton)) },
+		[](const FSharedMask& SharedMask) { return !SharedMask.Skeleton.IsValid(); }).Mask;
+}
+
+void FBoneFilterMatcher::Flush()
+{
+	BoneFilterMatcher::SharedMasks.Empty();
+}
+
+bool FBoneFilterMatcher::IsMatch(const FFilter& Filter, FName BoneName, const FString& BoneString) const
+{
+	if (Filter.bWildcard)
+	{
+		return Filter.Pattern.IsMatch(BoneString);
+	}
+
+	return BoneName.IsEqual(Filter.Literal, bCaseInsensitive ? ENameCase::IgnoreCase : ENameCase::CaseSensitive);
+}
+
+TBitArray<> FBoneFilterMatcher::ComputeBoneMask(const FReferenceSkeleton& RefSkeleton) const
+{
+	const int32 NumBones = RefSkeleton.GetNum();
+
+	// Bones are in strictly increasing order, so parents are always resolved before their children
+	TBitArray<> Matched(false, NumBones);
+	TBitArray<> WithChildren(false, NumBones);
+
+	FString BoneString;
+	for (int32 BoneIndex = 0; BoneIndex < NumBones; BoneIndex++)
+	{
+		const FName BoneName = RefSkeleton.GetBoneName(BoneIndex);
+
+		// Only wildcards need the name as a string
+		if (bAnyWildcard)
+		{
+			BoneString = BoneName.ToString();
+			if (bCaseInsensitive)
+			{
+				BoneString.ToLowerInline();
+			}
+		}
+
+		// A parent that matched with its children knocks out the entire branch, unless excluded
+		const int32 ParentBoneIndex = RefSkeleton.GetParentIndex(BoneIndex);
+		if (ParentBoneIndex != INDEX_NONE && WithChildren[ParentBoneIndex])
+		{
+			const bool bExcludeChildren = Filters.ContainsByPredicate([&](const FFilter& Filter)
+			{
+				return Filter.Children == EChildren::Exclude && IsMatch(Filter, BoneName, BoneString);
+			});
+
+			if (!bExcludeChildren)
+			{
+				Matched[BoneIndex] = true;
+				WithChildren[BoneIndex] = true;
+				continue;
+			}
+		}
+
+		for (const FFilter& Filter : Filters)
+		{
+			if (Filter.Children != EChildren::Exclude && IsMatch(Filter, BoneName, BoneString))
+			{
+				Matched[BoneIndex] = true;
+				if (Filter.Children == EChildren::Include)
+				{
+					WithChildren[BoneIndex] = true;
+					break;
+				}
+			}
+		}
+	}
+
+	return Matched;
+}
@@ -0,0 +1,63 @@
+// This source code is licensed under the MIT license found in the LICENSE file in the root directory of this source tree.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Misc/WildcardString.h"
+
+class USkeleton;
+struct FReferenceSkeleton;
+
+/**
+ * Bone filters compiled once, see UAnimationModifier_RemoveBones::BoneFilters for the syntax.
+ * Filters without wildcards compare names directly, and the bones matched on a skeleton are cached as a mask shared by
+ * every sequence of that skeleton.
+ */
+class FBoneFilterMatcher
+{
+public:
+
+	FBoneFilterMatcher(TArrayView<const FString> BoneFilters, bool bCaseInsensitive);
+
+	/** Return whether this matcher was compiled from the same filters. */
+	bool IsCompiledFrom(TArrayView<const FString> BoneFilters, bool bCaseInsensitive) const;
+
+	/** Return the bones of a skeleton that match, indexed like its reference skeleton. Game thread only. */
+	TSharedRef<const TBitArray<>> GetBoneMask(const USkeleton* Skeleton) const;
+
+	/** Release all cached bone masks. */
+	static void Flush();
+
+private:
+
+	enum class EChildren : uint8
+	{
+		// Only the bone itself
+		None,
+		// '+' prefix, the bone and its children
+		Include,
+		// '-' prefix, children of included bones that are excluded
+		Exclude,
+	};
+
+	struct FFilter
+	{
+		EChildren Children;
+		bool bWildcard;
+		FName Literal;
+		FWildcardString Pattern;
+	};
+
+	static FString MakeSignature(TArrayView<const FString> BoneFilters, bool bCaseInsensitive);
+
+	bool IsMatch(const FFilter& Filter, FName BoneName, const FString& BoneString) const;
+
+	TBitArray<> ComputeBoneMask(const FReferenceSkeleton& RefSkeleton) const;
+
+	TArray<FFilter> Filters;
+	bool bCaseInsensitive;
+	bool bAnyWildcard;
+
+	// Identifies the filters in the shared mask cache
+	FString Signature;
+};
@@ -0,0 +1,133 @@
+// This source code is licensed under the MIT license found in the LICENSE file in the root directory of this source tree.
+
+#include "AnimationModifiers/FootContactAnalysis.h"
+#include "AnimationModifiers/AnimSequencePoseCache.h"
+
+#include "ReferenceSkeleton.h"
+
+FFootContactSettings::FFootContactSettings()
+	: FootDownThreshold(1.0f)
+	, FootLiftThreshold(2.0f)
+{
+}
+
+FFootContactAnalysis::FFootContactAnalysis(const FAnimSequencePoseCache& PoseCache, TArrayView<const TPair<FName, float>> FootBones, const FFootContactSettings& Settings)
+	: NumFrames(PoseCache.GetNumFrames())
+{
+	struct FFootState
+	{
+		int32 BoneIndex;
+		float DownHeight;
+		float LiftHeight;
+		bool bDown;
+		FVector LocationSum;
+	};
+
+	TArray<FFootState> States;
+	for (const TPair<FName, float>& FootBone : FootBones)
+	{
+		Feet.AddDefaulted_GetRef().BoneName = FootBone.Key;
+
+		FFootState& State = States.AddDefaulted_GetRef();
+		State.BoneIndex = PoseCache.FindBoneIndex(FootBone.Key);
+		State.DownHeight = FootBone.Value + Settings.FootDownThreshold;
+		State.LiftHeight = FootBone.Value + Settings.FootLiftThreshold;
+		State.bDown = false;
+		State.LocationSum = FVector::ZeroVector;
+	}
+
+	for (int32 Frame = 0; Frame < NumFrames; ++Frame)
+	{
+		for (int32 FootIndex = 0; FootIndex < States.Num(); ++FootIndex)
+		{
+			FFootState& State = States[FootIndex];
+			FFootContactTrack& Foot = Feet[FootIndex];
+
+			const FVector Location = PoseCache.GetComponentTransform(Frame, State.BoneIndex).GetLocation();
+			const bool bDown = Location.Z <= (State.bDown ? State.LiftHeight : State.DownHeight);
+
+			if (bDown && !State.bDown)
+			{
+				FFootContact& Contact = Foot.Contacts.AddDefaulted_GetRef();
+				Contact.StartFrame = Frame;
+				Contact.StartTime = PoseCache.GetFrameTime(Frame);
+				State.LocationSum = FVector::ZeroVector;
+			}
+
+			if (bDown)
+			{
+				FFootContact& Contact = Foot.Contacts.Last();
+				Contact.EndFrame = Frame;
+				Contact.EndTime = PoseCache.GetFrameTime(Frame);
+				State.LocationSum += Location;
+				Contact.PlantLocation = State.LocationSum / (Contact.EndFrame - Contact.StartFrame + 1);
+			}
+
+			State.bDown = bDown;
+		}
+	}
+}
+
+TArray<FRichCurveKey> FFootContactAnalysis::MakeLockCurveKeys(const FFootContactTrack& Foot, float BlendTime) const
+{
+	TArray<FRichCurveKey> Keys;
+
+	for (const FFootContact& Contact : Foot.Contacts)
+	{
+		// Contacts too short to blend in and out are not worth locking
+		const float HalfDuration = (Contact.EndTime - Contact.StartTime) * 0.5f;
+		if (HalfDuration <= KINDA_SMALL_NUMBER)
+		{
+			continue;
+		}
+
+		const float ContactBlendTime = FMath::Clamp(BlendTime, KINDA_SMALL_NUMBER, HalfDuration);
+
+		if (StartsAtBeginning(Contact))
+		{
+			Keys.Emplace(Contact.StartTime, 1.0f);
+		}
+		else
+		{
+			Keys.Emplace(Contact.StartTime, 0.0f);
+			Keys.Emplace(Contact.StartTime + ContactBlendTime, 1.0f);
+		}
+
+		if (LastsUntilEnd(Contact))
+		{
+			Keys.Emplace(Contact.EndTime, 1.0f);
+		}
+		else
+		{
+			Keys.Emplace(Contact.EndTime - ContactBlendTime, 1.0f);
+			Keys.Emplace(Contact.EndTime, 0.0f);
+		}
+	}
+
+	if (Keys.Num() == 0)
+	{
+		Keys.Emplace(0.0f, 0.0f);
+	}
+
+	return Keys;
+}
+
+FVector FFootContactAnalysis::GetRefBoneComponentLocation(const FReferenceSkeleton& RefSkel, FName BoneName)
+{
+	FTransform Transform;
+	const int32 BoneIndex = RefSkel.FindBoneIndex(BoneName);
+
+	if (BoneIndex != INDEX_NONE)
+	{
+		Transform = RefSkel.GetRefBonePose()[BoneIndex];
+		int32 ParentBoneIndex = RefSkel.GetRefBoneInfo()[BoneIndex].ParentIndex;
+
+		while (ParentBoneIndex != INDEX_NONE)
+		{
+			Transform *= RefSkel.GetRefBonePose()[ParentBoneIndex];
+			ParentBoneIndex = RefSkel.GetRefBoneInfo()[ParentBoneIndex].ParentIndex;
+		}
+	}
+
+	return Transform.GetLocation();
+}
@@ -0,0 +1,81 @@
+// This source code is licensed under the MIT license found in the LICENSE file in the root directory of this source tree.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Curves/RichCurve.h"
+
+#include "FootContactAnalysis.generated.h"
+
+class FAnimSequencePoseCache;
+struct FReferenceSkeleton;
+
+/** Thresholds deciding whether a foot is in contact with the ground. */
+USTRUCT(BlueprintType)
+struct FFootContactSettings
+{
+	GENERATED_BODY()
+
+	FFootContactSettings();
+
+	/** Added to reference foot height when the foot is up. Helps prevent jittery animation from triggering extra contacts. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = FootContact)
+	float FootDownThreshold;
+
+	/** Added to reference foot height when the foot is down. Helps prevent jittery animation from triggering extra contacts. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = FootContact)
+	float FootLiftThreshold;
+};
+
+/** Frames during which a foot stays on the ground. */
+struct FFootContact
+{
+	int32 StartFrame;
+	int32 EndFrame;
+	float StartTime;
+	float EndTime;
+
+	/** Average component space location of the foot during the contact. */
+	FVector PlantLocation;
+};
+
+struct FFootContactTrack
+{
+	FName BoneName;
+	TArray<FFootContact> Contacts;
+};
+
+/**
+ * Foot contacts of a sequence, found in a single pass over the cached poses for all feet.
+ * A foot is down while its height is under its reference height plus a threshold, using a higher threshold to lift it
+ * than to put it down so that jitter doesn't split contacts.
+ */
+class FFootContactAnalysis
+{
+public:
+
+	/** Analyze feet given their bone names and reference heights. */
+	FFootContactAnalysis(const FAnimSequencePoseCache& PoseCache, TArrayView<const TPair<FName, float>> FootBones, const FFootContactSettings& Settings);
+
+	const TArray<FFootContactTrack>& GetFeet() const { return Feet; }
+
+	/** Return whether a contact started before the sequence, i.e. it doesn't begin with the foot being put down. */
+	static bool StartsAtBeginning(const FFootContact& Contact) { return Contact.StartFrame == 0; }
+
+	/** Return whether a contact lasts until the end of the sequence. */
+	bool LastsUntilEnd(const FFootContact& Contact) const { return Contact.EndFrame == NumFrames - 1; }
+
+	/**
+	 * Return the keys of a curve that is one while a foot is planted and zero while it's in the air, blending in after
+	 * the foot is put down and out before it's lifted.
+	 */
+	TArray<FRichCurveKey> MakeLockCurveKeys(const FFootContactTrack& Foot, float BlendTime) const;
+
+	/** Return the component space location of a bone in the reference pose. */
+	static FVector GetRefBoneComponentLocation(const FReferenceSkeleton& RefSkel, FName BoneName);
+
+private:
+
+	int32 NumFrames;
+	TArray<FFootContactTrack> Feet;
+};
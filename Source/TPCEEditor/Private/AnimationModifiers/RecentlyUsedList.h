@@ -0,0 +1,54 @@
+// This source code is licensed under the MIT license found in the LICENSE file in the root directory of this source tree.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Small list of cache entries in most recently used order, evicting the least recently used entry when full.
+ * Meant for the few entries the animation modifiers share between sequences, lookups are linear.
+ */
+template<typename EntryType, int32 MaxEntries>
+class TRecentlyUsedList
+{
+public:
+
+	/** Return the first entry matching a predicate after moving it to the front, or null if none matches. */
+	template<typename PredicateType>
+	EntryType* Find(PredicateType Predicate)
+	{
+		const int32 Index = Entries.IndexOfByPredicate(Predicate);
+		if (Index == INDEX_NONE)
+		{
+			return nullptr;
+		}
+
+		if (Index > 0)
+		{
+			EntryType Entry = MoveTemp(Entries[Index]);
+			Entries.RemoveAt(Index, 1, false);
+			Entries.Insert(MoveTemp(Entry), 0);
+		}
+		return &Entries[0];
+	}
+
+	/** Add an entry at the front. Entries matching a predicate are removed first, then the least recently used if full. */
+	template<typename PredicateType>
+	EntryType& Add(EntryType&& Entry, PredicateType RemovePredicate)
+	{
+		Entries.RemoveAll(RemovePredicate);
+		if (Entries.Num() >= MaxEntries)
+		{
+			Entries.Pop(false);
+		}
+
+		Entries.Insert(MoveTemp(Entry), 0);
+		return Entries[0];
+	}
+
+	void Empty() { Entries.Empty(); }
+
+private:
+
+	TArray<EntryType, TInlineAllocator<MaxEntries>> Entries;
+};
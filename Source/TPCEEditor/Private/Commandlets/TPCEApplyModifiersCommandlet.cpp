@@ -0,0 +1,319 @@
+// This source code is licensed under the MIT license found in the LICENSE file in the root directory of this source tree.
+
+#include "Commandlets/TPCEApplyModifiersCommandlet.h"
+#include "AnimationModifiers/AnimSequencePoseCache.h"
+#include "AnimationModifiers/BatchAnimationModifier.h"
+#include "AnimationModifiers/BoneFilterMatcher.h"
+
+#include "Animation/AnimSequence.h"
+#include "Animation/Skeleton.h"
+#include "AnimationModifier.h"
+#include "AssetRegistryModule.h"
+#include "Misc/FileHelper.h"
+#include "Misc/PackageName.h"
+#include "Misc/Paths.h"
+#include "Misc/SecureHash.h"
+#include "UObject/Package.h"
+#include "UObject/StrongObjectPtr.h"
+#include "TPCEEditor.h"
+
+namespace TPCEApplyModifiers
+{
+	// Bump to reprocess all sequences when the way modifiers are applied changes
+	const TCHAR* ManifestVersion = TEXT("1");
+
+	UClass* FindModifierClass(const FString& Name)
+	{
+		// Soft paths reject short names, only load full paths
+		UClass* Class = nullptr;
+		if (FPackageName::IsValidObjectPath(Name))
+		{
+			Class = FSoftClassPath(Name).TryLoadClass<UAnimationModifier>();
+		}
+		else
+		{
+			Class = FindObject<UClass>(ANY_PACKAGE, *Name);
+			if (Class == nullptr)
+			{
+				Class = FindObject<UClass>(ANY_PACKAGE, *(TEXT("AnimationModifier_") + Name));
+			}
+		}
+
+		return Class && Class->IsChildOf<UAnimationModifier>() && !Class->HasAnyClassFlags(CLASS_Abstract) ? Class : nullptr;
+	}
+}
+
+UTPCEApplyModifiersCommandlet::UTPCEApplyModifiersCommandlet()
+{
+	IsClient = false;
+	IsServer = false;
+	IsEditor = true;
+	LogToConsole = true;
+
+	ManifestPath = TEXT("Saved/TPCE/ApplyModifiersManifest.csv");
+	BatchSize = 64;
+}
+
+int32 UTPCEApplyModifiersCommandlet::Main(const FString& Params)
+{
+	TArray<FString> Tokens;
+	TArray<FString> Switches;
+	TMap<FString, FString> ParamVals;
+	ParseCommandLine(*Params, Tokens, Switches, ParamVals);
+
+	const bool bForce = Switches.Contains(TEXT("Force"));
+	const bool bNoSave = Switches.Contains(TEXT("NoSave"));
+
+	TArray<FString> Paths = ContentPaths;
+	if (const FString* PathParam = ParamVals.Find(TEXT("Path")))
+	{
+		PathParam->ParseIntoArray(Paths, TEXT("+"));
+	}
+
+	TArray<FString> ModifierNames;
+	if (const FString* ModifiersParam = ParamVals.Find(TEXT("Modifiers")))
+	{
+		ModifiersParam->ParseIntoArray(ModifierNames, TEXT("+"));
+	}
+	else
+	{
+		for (const FSoftClassPath& ClassPath : ModifierClasses)
+		{
+			ModifierNames.Add(ClassPath.ToString());
+		}
+	}
+
+	const FString* ManifestParam = ParamVals.Find(TEXT("Manifest"));
+	const FString ManifestFilename = FPaths::ConvertRelativePathToFull(FPaths::ProjectDir(), ManifestParam ? *ManifestParam : ManifestPath);
+
+	// Resolve modifiers. Loaded blueprint classes are referenced by nothing else, keep them alive across batches
+	TArray<UClass*> Classes;
+	TArray<TStrongObjectPtr<UClass>> ClassReferences;
+	for (const FString& ModifierName : ModifierNames)
+	{
+		if (UClass* Class = TPCEApplyModifiers::FindModifierClass(ModifierName))
+		{
+			Classes.Add(Class);
+			ClassReferences.Emplace(Class);
+		}
+		else
+		{
+			UE_LOG(LogTPCEEditor, Error, TEXT("Unknown animation modifier class %s"), *ModifierName);
+			return 1;
+		}
+	}
+
+	if (Paths.Num() == 0 || Classes.Num() == 0)
+	{
+		UE_LOG(LogTPCEEditor, Error, TEXT("No content paths or modifiers specified. Use -Path=/Game/Path -Modifiers=ClassA+ClassB or configure [/Script/TPCEEditor.TPCEApplyModifiersCommandlet]"));
+		return 1;
+	}
+
+	const FString ModifiersHash = GetModifiersHash(Classes);
+
+	// Find sequences
+	IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>(TEXT("AssetRegistry")).Get();
+	AssetRegistry.SearchAllAssets(true);
+
+	FARFilter Filter;
+	Filter.ClassNames.Add(UAnimSequence::StaticClass()->GetFName());
+	Filter.bRecursiveClasses = true;
+	Filter.bRecursivePaths = true;
+	for (const FString& Path : Paths)
+	{
+		Filter.PackagePaths.Add(*Path);
+	}
+
+	TArray<FAssetData> Assets;
+	AssetRegistry.GetAssets(Filter, Assets);
+
+	// Skip sequences whose inputs didn't change since they were last processed
+	TMap<FString, FString> Manifest;
+	LoadManifest(ManifestFilename, Manifest);
+
+	TMap<FString, FString> SkeletonHashes;
+	TArray<FAssetData> PendingAssets;
+	for (const FAssetData& Asset : Assets)
+	{
+		const FString PackageName = Asset.PackageName.ToString();
+		const FString SkeletonPackageName = FPackageName::ObjectPathToPackageName(Asset.GetTagValueRef<FString>(TEXT("Skeleton")));
+
+		FString* SkeletonHash = SkeletonHashes.Find(SkeletonPackageName);
+		if (SkeletonHash == nullptr)
+		{
+			SkeletonHash = &SkeletonHashes.Add(SkeletonPackageName, GetPackageHash(SkeletonPackageName));
+		}
+
+		const FString InputsHash = ModifiersHash + TEXT("-") + *SkeletonHash;
+		const FString* Entry = Manifest.Find(PackageName);
+		if (!bForce && Entry && *Entry == InputsHash + TEXT("-") + GetPackageHash(PackageName))
+		{
+			continue;
+		}
+
+		PendingAssets.Add(Asset);
+	}
+
+	UE_LOG(LogTPCEEditor, Display, TEXT("%d of %d anim sequences need processing"), PendingAssets.Num(), Assets.Num());
+	if (bNoSave || PendingAssets.Num() == 0)
+	{
+		return 0;
+	}
+
+	int32 NumErrors = 0;
+	for (int32 BatchStart = 0; BatchStart < PendingAssets.Num(); BatchStart += FMath::Max(1, BatchSize))
+	{
+		const int32 BatchEnd = FMath::Min(BatchStart + FMath::Max(1, BatchSize), PendingAssets.Num());
+
+		TArray<UAnimSequence*> Sequences;
+		for (int32 AssetIndex = BatchStart; AssetIndex < BatchEnd; ++AssetIndex)
+		{
+			if (UAnimSequence* Sequence = Cast<UAnimSequence>(PendingAssets[AssetIndex].GetAsset()))
+			{
+				Sequences.Add(Sequence);
+			}
+			else
+			{
+				UE_LOG(LogTPCEEditor, Error, TEXT("Failed to load %s"), *PendingAssets[AssetIndex].ObjectPath.ToString());
+				NumErrors++;
+			}
+		}
+
+		TArray<UAnimationModifier*> Modifiers;
+		for (UClass* Class : Classes)
+		{
+			Modifiers.Add(NewObject<UAnimationModifier>(GetTransientPackage(), Class));
+		}
+
+		ApplyModifiers(Modifiers, Sequences);
+
+		for (UAnimSequence* Sequence : Sequences)
+		{
+			UPackage* Package = Sequence->GetOutermost();
+			const FString PackageName = Package->GetName();
+			const FString Filename = FPackageName::LongPackageNameToFilename(PackageName, FPackageName::GetAssetPackageExtension());
+
+			if (!UPackage::SavePackage(Package, nullptr, RF_Standalone, *Filename, GError, nullptr, false, true, SAVE_NoError))
+			{
+				UE_LOG(LogTPCEEditor, Error, TEXT("Failed to save %s"), *Filename);
+				NumErrors++;
+				continue;
+			}
+
+			// Record the saved file so that the next run sees the sequence as up to date
+			const FString SkeletonPackageName = Sequence->GetSkeleton() ? Sequence->GetSkeleton()->GetOutermost()->GetName() : FString();
+			const FString* SkeletonHash = SkeletonHashes.Find(SkeletonPackageName);
+			Manifest.Add(PackageName, ModifiersHash + TEXT("-") + (SkeletonHash ? *SkeletonHash : GetPackageHash(SkeletonPackageName)) + TEXT("-") + GetPackageHash(PackageName));
+		}
+
+		UE_LOG(LogTPCEEditor, Display, TEXT("Processed %d of %d anim sequences"), BatchEnd, PendingAssets.Num());
+
+		// Standalone sequences must go too, the modifier classes are kept alive by ClassReferences
+		FAnimSequencePoseCache::Flush();
+		FBoneFilterMatcher::Flush();
+		CollectGarbage(RF_NoFlags);
+	}
+
+	if (!SaveManifest(ManifestFilename, Manifest))
+	{
+		UE_LOG(LogTPCEEditor, Error, TEXT("Failed to save manifest %s"), *ManifestFilename);
+		NumErrors++;
+	}
+
+	return NumErrors > 0 ? 1 : 0;
+}
+
+FString UTPCEApplyModifiersCommandlet::GetModifiersHash(const TArray<UClass*>& Classes)
+{
+	FString Settings = TPCEApplyModifiers::ManifestVersion;
+
+	for (UClass* Class : Classes)
+	{
+		Settings += TEXT("|") + Class->GetPathName();
+
+		// Only the settings of the modifier, not the bookkeeping of the base class
+		const UObject* DefaultObject = Class->GetDefaultObject();
+		for (TFieldIterator<FProperty> It(Class); It; ++It)
+		{
+			const FProperty* Property = *It;
+			if (Property->HasAnyPropertyFlags(CPF_Transient) || Property->GetOwnerClass() == UAnimationModifier::StaticClass() || !Property->GetOwnerClass()->IsChildOf<UAnimationModifier>())
+			{
+				continue;
+			}
+
+			for (int32 Index = 0; Index < Property->ArrayDim; ++Index)
+			{
+				FString Value;
+				Property->ExportText_InContainer(Index, Value, DefaultObject, nullptr, nullptr, PPF_None);
+				Settings += FString::Printf(TEXT("|%s=%s"), *Property->GetName(), *Value);
+			}
+		}
+	}
+
+	return FMD5::HashAnsiString(*Settings);
+}
+
+FString UTPCEApplyModifiersCommandlet::GetPackageHash(const FString& PackageName)
+{
+	FString Filename;
+	if (PackageName.IsEmpty() || !FPackageName::DoesPackageExist(PackageName, nullptr, &Filename))
+	{
+		return FString();
+	}
+
+	return LexToString(FMD5Hash::HashFile(*Filename));
+}
+
+void UTPCEApplyModifiersCommandlet::ApplyModifiers(const TArray<UAnimationModifier*>& Modifiers, const TArray<UAnimSequence*>& Sequences)
+{
+	for (UAnimationModifier* Modifier : Modifiers)
+	{
+		if (UBatchAnimationModifier* BatchModifier = Cast<UBatchAnimationModifier>(Modifier))
+		{
+			BatchModifier->ApplyToSequences(Sequences, false);
+		}
+		else
+		{
+			// The modifier reverts what it last applied, so each sequence needs its own instance
+			for (UAnimSequence* Sequence : Sequences)
+			{
+				NewObject<UAnimationModifier>(GetTransientPackage(), Modifier->GetClass())->ApplyToAnimationSequence(Sequence);
+			}
+		}
+	}
+}
+
+bool UTPCEApplyModifiersCommandlet::LoadManifest(const FString& Filename, TMap<FString, FString>& OutManifest) const
+{
+	TArray<FString> Lines;
+	if (!FFileHelper::LoadFileToStringArray(Lines, *Filename))
+	{
+		return false;
+	}
+
+	for (const FString& Line : Lines)
+	{
+		FString PackageName, Hash;
+		if (Line.Split(TEXT(","), &PackageName, &Hash))
+		{
+			OutManifest.Add(PackageName, Hash);
+		}
+	}
+
+	return true;
+}
+
+bool UTPCEApplyModifiersCommandlet::SaveManifest(const FString& Filename, const TMap<FString, FString>& Manifest) const
+{
+	TArray<FString> PackageNames;
+	Manifest.GetKeys(PackageNames);
+	PackageNames.Sort();
+
+	FString Contents;
+	for (const FString& PackageName : PackageNames)
+	{
+		Contents += FString::Printf(TEXT("%s,%s\n"), *PackageName, *Manifest[PackageName]);
+	}
+
+	return FFileHelper::SaveStringToFile(Contents, *Filename);
+}
@@ -0,0 +1,66 @@
+// This source code is licensed under the MIT license found in the LICENSE file in the root directory of this source tree.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+
+#include "TPCEApplyModifiersCommandlet.generated.h"
+
+class UAnimationModifier;
+class UAnimSequence;
+
+/**
+ * Applies animation modifiers to every anim sequence under a set of content paths and saves the results.
+ * Modifiers are applied in order with the settings of their class defaults, use a blueprint subclass to change them.
+ *
+ * Sequences are only processed when their package, their skeleton package or the modifier settings changed since the
+ * last run, as recorded in a manifest file. Suitable to run headless, e.g.:
+ *
+ * UE4Editor-Cmd Project.uproject -run=TPCEApplyModifiers -Path=/Game/Animations -Modifiers=AnimationModifier_FootSyncMarkers+AnimationModifier_BoneDistance -nullrhi
+ *
+ * Switches: -Force to ignore the manifest, -NoSave to only report what would be processed.
+ */
+UCLASS(config=Editor)
+class UTPCEApplyModifiersCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+
+	UTPCEApplyModifiersCommandlet();
+
+	// Begin UCommandlet Interface
+	virtual int32 Main(const FString& Params) override;
+	// End UCommandlet Interface
+
+	/** Content paths searched recursively for anim sequences. Overridden by -Path=PathA+PathB. */
+	UPROPERTY(config)
+	TArray<FString> ContentPaths;
+
+	/** Modifier classes applied in order. Overridden by -Modifiers=ClassA+ClassB, taking class names or paths. */
+	UPROPERTY(config)
+	TArray<FSoftClassPath> ModifierClasses;
+
+	/** Manifest of processed sequences, relative to the project directory. Overridden by -Manifest=File. */
+	UPROPERTY(config)
+	FString ManifestPath;
+
+	/** Number of sequences loaded, modified and saved before collecting garbage. */
+	UPROPERTY(config)
+	int32 BatchSize;
+
+private:
+
+	/** Return a hash of the modifier classes and their settings. */
+	static FString GetModifiersHash(const TArray<UClass*>& Classes);
+
+	/** Return a hash of the file of a package or an empty string if it doesn't exist. */
+	static FString GetPackageHash(const FString& PackageName);
+
+	/** Apply all modifiers to a batch of sequences. */
+	static void ApplyModifiers(const TArray<UAnimationModifier*>& Modifiers, const TArray<UAnimSequence*>& Sequences);
+
+	bool LoadManifest(const FString& Filename, TMap<FString, FString>& OutManifest) const;
+	bool SaveManifest(const FString& Filename, const TMap<FString, FString>& Manifest) const;
+};
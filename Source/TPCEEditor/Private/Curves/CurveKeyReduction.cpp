@@ -0,0 +1,123 @@
+// This source code is licensed under the MIT license found in the LICENSE file in the root directory of this source tree.
+
+#include "Curves/CurveKeyReduction.h"
+
+#include "Algo/BinarySearch.h"
+#include "Animation/AnimSequence.h"
+#include "Animation/Skeleton.h"
+#include "TPCEEditor.h"
+
+FCurveKeyReductionSettings::FCurveKeyReductionSettings()
+	: bReduceKeys(false)
+	, Tolerance(0.1f)
+{
+}
+
+FCurveKeyReductionResult CurveKeyReduction::ReduceKeys(TArrayView<const float> Times, TArrayView<const float> Values, const FCurveKeyReductionSettings& Settings)
+{
+	check(Times.Num() == Values.Num());
+
+	const int32 NumSamples = Times.Num();
+
+	FCurveKeyReductionResult Result;
+	Result.NumSamples = NumSamples;
+
+	if (!Settings.bReduceKeys || NumSamples <= 2)
+	{
+		Result.Keys.Reserve(NumSamples);
+		for (int32 Index = 0; Index < NumSamples; ++Index)
+		{
+			Result.Keys.Emplace(Times[Index], Values[Index]);
+		}
+		return Result;
+	}
+
+	// Start from the end samples and key the worst fitted sample until all of them are within tolerance.
+	// An auto tangent depends on the neighbouring keys, so a new key only changes the two segments on each side of it.
+	FRichCurve Curve;
+	TArray<int32> KeySamples;
+	TArray<float> Errors;
+	Errors.SetNumZeroed(NumSamples);
+
+	auto AddKey = [&](int32 Sample) -> int32
+	{
+		const int32 Position = Algo::LowerBound(KeySamples, Sample);
+		KeySamples.Insert(Sample, Position);
+
+		const FKeyHandle Handle = Curve.AddKey(Times[Sample], Values[Sample]);
+		Curve.GetKey(Handle).InterpMode = RCIM_Cubic;
+		Curve.AutoSetTangents();
+
+		return Position;
+	};
+
+	auto UpdateErrors = [&](int32 FirstSample, int32 LastSample)
+	{
+		for (int32 Sample = FirstSample; Sample <= LastSample; ++Sample)
+		{
+			Errors[Sample] = FMath::Abs(Curve.Eval(Times[Sample]) - Values[Sample]);
+		}
+	};
+
+	AddKey(0);
+	AddKey(NumSamples - 1);
+	UpdateErrors(1, NumSamples - 2);
+
+	while (KeySamples.Num() < NumSamples)
+	{
+		int32 WorstSample = 0;
+		for (int32 Sample = 1; Sample < NumSamples; ++Sample)
+		{
+			if (Errors[Sample] > Errors[WorstSample])
+			{
+				WorstSample = Sample;
+			}
+		}
+
+		if (Errors[WorstSample] <= Settings.Tolerance)
+		{
+			break;
+		}
+
+		const int32 Position = AddKey(WorstSample);
+		UpdateErrors(KeySamples[FMath::Max(Position - 2, 0)], KeySamples[FMath::Min(Position + 2, KeySamples.Num() - 1)]);
+
+		for (int32 Sample : KeySamples)
+		{
+			Errors[Sample] = 0.0f;
+		}
+	}
+
+	Result.Keys = Curve.GetCopyOfKeys();
+	Result.MaxError = FMath::Max(Errors);
+
+	return Result;
+}
+
+bool CurveKeyReduction::SetFloatCurveKeys(UAnimSequence* AnimationSequence, FName CurveName, const TArray<FRichCurveKey>& Keys)
+{
+	const USkeleton* Skeleton = AnimationSequence ? AnimationSequence->GetSkeleton() : nullptr;
+
+	FSmartName SmartName;
+	if (Skeleton == nullptr || !Skeleton->GetSmartNameByName(USkeleton::AnimCurveMappingName, CurveName, SmartName))
+	{
+		return false;
+	}
+
+	FFloatCurve* Curve = static_cast<FFloatCurve*>(AnimationSequence->RawCurveData.GetCurveData(SmartName.UID, ERawCurveTrackTypes::RCT_Float));
+	if (Curve == nullptr)
+	{
+		return false;
+	}
+
+	Curve->FloatCurve.SetKeys(Keys);
+	AnimationSequence->MarkPackageDirty();
+
+	return true;
+}
+
+void CurveKeyReduction::LogResult(const UObject* Owner, FName CurveName, const FCurveKeyReductionResult& Result)
+{
+	UE_LOG(LogTPCEEditor, Log, TEXT("%s: curve %s reduced from %d to %d keys (%.1f:1, max error %f)"),
+		*GetNameSafe(Owner), *CurveName.ToString(), Result.NumSamples, Result.Keys.Num(), Result.GetCompressionRatio(), Result.MaxError);
+}
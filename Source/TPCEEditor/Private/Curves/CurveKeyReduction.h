@@ -0,0 +1,52 @@
+// This source code is licensed under the MIT license found in the LICENSE file in the root directory of this source tree.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Curves/RichCurve.h"
+
+#include "CurveKeyReduction.generated.h"
+
+class UAnimSequence;
+
+/** Settings to reduce a curve sampled once per frame to the fewest cubic keys reproducing it. */
+USTRUCT(BlueprintType)
+struct FCurveKeyReductionSettings
+{
+	GENERATED_BODY()
+
+	FCurveKeyReductionSettings();
+
+	/** Fit cubic keys with auto tangents to the samples instead of adding a linear key per sample. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = KeyReduction)
+	uint32 bReduceKeys : 1;
+
+	/** Maximum difference allowed between the reduced curve and any sample. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = KeyReduction, meta = (EditCondition = "bReduceKeys", ClampMin = "0"))
+	float Tolerance;
+};
+
+/** Keys reproducing a sampled curve. */
+struct FCurveKeyReductionResult
+{
+	TArray<FRichCurveKey> Keys;
+
+	int32 NumSamples = 0;
+
+	/** Largest difference between the keys and a sample. */
+	float MaxError = 0.0f;
+
+	float GetCompressionRatio() const { return Keys.Num() > 0 ? (float)NumSamples / Keys.Num() : 1.0f; }
+};
+
+namespace CurveKeyReduction
+{
+	/** Return the keys reproducing samples, one linear key per sample if reduction is disabled. Thread safe. */
+	FCurveKeyReductionResult ReduceKeys(TArrayView<const float> Times, TArrayView<const float> Values, const FCurveKeyReductionSettings& Settings);
+
+	/** Replace the keys of an existing float curve of a sequence. Return false if the sequence doesn't have the curve. */
+	bool SetFloatCurveKeys(UAnimSequence* AnimationSequence, FName CurveName, const TArray<FRichCurveKey>& Keys);
+
+	/** Log the compression ratio of a reduced curve. */
+	void LogResult(const UObject* Owner, FName CurveName, const FCurveKeyReductionResult& Result);
+}
@@ -1,6 +1,7 @@
 #include "Factories/DistanceCurveFactory.h"
 #include "Curves/CurveFloat.h"
 #include "Animation/AnimSequence.h"
+#include "Algo/StableSort.h"
 
 UDistanceCurveFactory::UDistanceCurveFactory(const FObjectInitializer& ObjectInitializer) :
 	Super(ObjectInitializer)
@@ -42,11 +43,31 @@ UObject* UDistanceCurveFactory::FactoryCreateNew(UClass* Class,UObject* InParent
 	{
 		const float MaxValue = GetValue(AnimSequence->GetPlayLength());
 		const int32 FrameCount = AnimSequence->GetNumberOfFrames();
+
+		// The curve maps the distance to the animation time, sort the samples by distance to fit keys to them
+		TArray<TPair<float, float>> Samples;
 		for (int32 i = 0; i < FrameCount; ++i)
 		{
 			const float Time = AnimSequence->GetTimeAtFrame(i);
 			const float Value = MaxValue - GetValue(Time);
-			NewCurve->FloatCurve.AddKey(Value, Time);
+			Samples.Emplace(Value, Time);
+		}
+		Algo::StableSortBy(Samples, [](const TPair<float, float>& Sample) { return Sample.Key; });
+
+		TArray<float> KeyTimes;
+		TArray<float> KeyValues;
+		for (const TPair<float, float>& Sample : Samples)
+		{
+			KeyTimes.Add(Sample.Key);
+			KeyValues.Add(Sample.Value);
+		}
+
+		const FCurveKeyReductionResult Result = CurveKeyReduction::ReduceKeys(KeyTimes, KeyValues, KeyReduction);
+		NewCurve->FloatCurve.SetKeys(Result.Keys);
+
+		if (KeyReduction.bReduceKeys)
+		{
+			CurveKeyReduction::LogResult(NewCurve, Name, Result);
 		}
 	}
 
@@ -6,6 +6,7 @@
 #include "UObject/ObjectMacros.h"
 #include "Factories/Factory.h"
 #include "TPCEEditorTypes.h"
+#include "Curves/CurveKeyReduction.h"
 
 #include "DistanceCurveFactory.generated.h"
 
@@ -36,4 +37,8 @@ public:
 	/** Distance curve type to generate. */
 	UPROPERTY(EditAnywhere, Category = DistanceCurveFactory)
 	EDistanceCurveType DistanceCurveType;
+
+	/** Reduction of the keys of the curve, one per frame otherwise. */
+	UPROPERTY(EditAnywhere, Category = DistanceCurveFactory)
+	FCurveKeyReductionSettings KeyReduction;
 };
@@ -13,6 +13,7 @@
 #include "Animation/Skeleton.h"
 #include "Animation/AnimSequence.h"
 #include "Dialogs/Dialogs.h"
+#include "Misc/ScopedSlowTask.h"
 #include "ScopedTransaction.h"
 
 #define LOCTEXT_NAMESPACE "CopyAdditiveLayerTracksWindow"
@@ -125,11 +126,28 @@ FReply SCopyAdditiveLayerTracksWindow::OnApply()
 		}
 	}
 
+	// Source curves are only read, copy their keys straight into each destination
+	TArray<const FTransformCurve*> SourceCurves;
+	if (SourceAnimSequence.IsValid())
+	{
+		for (const FTransformCurve& SourceCurve : SourceAnimSequence->RawCurveData.TransformCurves)
+		{
+			SourceCurves.Add(&SourceCurve);
+		}
+	}
+
+	// Copy all tracks first, then bake and compress the modified sequences as a batch
+	TArray<UAnimSequence*> ModifiedAnimSequences;
 	for (auto AnimSequencePtr : AnimSequences)
 	{
-		CopyAdditiveLayerTracks(AnimSequencePtr.Get());
+		if (CopyAdditiveLayerTracks(AnimSequencePtr.Get(), SourceCurves))
+		{
+			ModifiedAnimSequences.Add(AnimSequencePtr.Get());
+		}
 	}
 
+	BakeAndRecompress(ModifiedAnimSequences);
+
 	if (WidgetWindow.IsValid())
 	{
 		WidgetWindow.Pin()->RequestDestroyWindow();
@@ -175,59 +193,80 @@ bool SCopyAdditiveLayerTracksWindow::ShouldFilterAsset(const FAssetData& InAsset
 	return false;
 }
 
-void SCopyAdditiveLayerTracksWindow::CopyAdditiveLayerTracks(UAnimSequence* AnimSequence)
+bool SCopyAdditiveLayerTracksWindow::CopyAdditiveLayerTracks(UAnimSequence* AnimSequence, TArrayView<const FTransformCurve* const> SourceCurves)
 {
 	if (!AnimSequence || SourceAnimSequence == AnimSequence)
 	{
-		return;
+		return false;
+	}
+
+	if (!AnimSequence->DoesContainTransformCurves() && SourceCurves.Num() == 0)
+	{
+		return false;
 	}
 
 	USkeleton* CurrentSkeleton = AnimSequence->GetSkeleton();
 	check(CurrentSkeleton);
 
+	AnimSequence->Modify(true);
+
 	if (AnimSequence->DoesContainTransformCurves())
 	{
 		AnimSequence->RawCurveData.DeleteAllCurveData(ERawCurveTrackTypes::RCT_Transform);
-		AnimSequence->bNeedsRebake = true;
 	}
 
-	if (SourceAnimSequence.IsValid())
+	for (const FTransformCurve* SrcTransformCurve : SourceCurves)
 	{
-		for (FTransformCurve SrcTransformCurve : SourceAnimSequence->RawCurveData.TransformCurves)
+		FName CurveName = SrcTransformCurve->Name.DisplayName;
+		FSmartName NewCurveName;
+		CurrentSkeleton->AddSmartNameAndModify(USkeleton::AnimTrackCurveMappingName, CurveName, NewCurveName);
+
+		// Add curve - this won't add duplicate curve
+		AnimSequence->RawCurveData.AddCurveData(NewCurveName, AACF_DriveTrack | AACF_Editable, ERawCurveTrackTypes::RCT_Transform);
+		FTransformCurve* DstTransformCurve = static_cast<FTransformCurve*>(AnimSequence->RawCurveData.GetCurveData(NewCurveName.UID, ERawCurveTrackTypes::RCT_Transform));
+		check(DstTransformCurve);
+
+		const FVectorCurve* SrcVectorCurves[] = { &SrcTransformCurve->TranslationCurve, &SrcTransformCurve->RotationCurve, &SrcTransformCurve->ScaleCurve };
+		FVectorCurve* DstVectorCurves[] = { &DstTransformCurve->TranslationCurve, &DstTransformCurve->RotationCurve, &DstTransformCurve->ScaleCurve };
+		for (int32 VectorIndex = 0; VectorIndex < UE_ARRAY_COUNT(SrcVectorCurves); ++VectorIndex)
 		{
-			FName CurveName = SrcTransformCurve.Name.DisplayName;
-			FSmartName NewCurveName;
-			CurrentSkeleton->AddSmartNameAndModify(USkeleton::AnimTrackCurveMappingName, CurveName, NewCurveName);
-
-			// Add curve - this won't add duplicate curve
-			AnimSequence->RawCurveData.AddCurveData(NewCurveName, AACF_DriveTrack | AACF_Editable, ERawCurveTrackTypes::RCT_Transform);
-			FTransformCurve* DstTransformCurve = static_cast<FTransformCurve*>(AnimSequence->RawCurveData.GetCurveData(NewCurveName.UID, ERawCurveTrackTypes::RCT_Transform));
-			check(DstTransformCurve);
-
-			DstTransformCurve->TranslationCurve.FloatCurves[0].SetKeys(SrcTransformCurve.TranslationCurve.FloatCurves[0].GetConstRefOfKeys());
-			DstTransformCurve->TranslationCurve.FloatCurves[1].SetKeys(SrcTransformCurve.TranslationCurve.FloatCurves[1].GetConstRefOfKeys());
-			DstTransformCurve->TranslationCurve.FloatCurves[2].SetKeys(SrcTransformCurve.TranslationCurve.FloatCurves[2].GetConstRefOfKeys());
-			DstTransformCurve->RotationCurve.FloatCurves[0].SetKeys(SrcTransformCurve.RotationCurve.FloatCurves[0].GetConstRefOfKeys());
-			DstTransformCurve->RotationCurve.FloatCurves[1].SetKeys(SrcTransformCurve.RotationCurve.FloatCurves[1].GetConstRefOfKeys());
-			DstTransformCurve->RotationCurve.FloatCurves[2].SetKeys(SrcTransformCurve.RotationCurve.FloatCurves[2].GetConstRefOfKeys());
-			DstTransformCurve->ScaleCurve.FloatCurves[0].SetKeys(SrcTransformCurve.ScaleCurve.FloatCurves[0].GetConstRefOfKeys());
-			DstTransformCurve->ScaleCurve.FloatCurves[1].SetKeys(SrcTransformCurve.ScaleCurve.FloatCurves[1].GetConstRefOfKeys());
-			DstTransformCurve->ScaleCurve.FloatCurves[2].SetKeys(SrcTransformCurve.ScaleCurve.FloatCurves[2].GetConstRefOfKeys());
-
-			AnimSequence->bNeedsRebake = true;
+			for (int32 Channel = 0; Channel < 3; ++Channel)
+			{
+				DstVectorCurves[VectorIndex]->FloatCurves[Channel].SetKeys(SrcVectorCurves[VectorIndex]->FloatCurves[Channel].GetConstRefOfKeys());
+			}
 		}
 	}
 
-	if (AnimSequence->DoesNeedRebake())
-	{
-		AnimSequence->Modify(true);
-		AnimSequence->BakeTrackCurvesToRawAnimation();
-	}
+	AnimSequence->bNeedsRebake = true;
+
+	return true;
+}
+
+void SCopyAdditiveLayerTracksWindow::BakeAndRecompress(TArrayView<UAnimSequence* const> DestAnimSequences)
+{
+	FScopedSlowTask SlowTask(DestAnimSequences.Num(), LOCTEXT("CopyAdditiveLayerTracksWindow_Baking", "Baking additive layer tracks"));
+	SlowTask.MakeDialog(true);
 
-	if (AnimSequence->DoesNeedRecompress())
+	// Compression is requested async so that it runs on worker threads while the next sequences are baked, if the engine
+	// allows it. Sequences left over when canceling still need rebaking, which happens when they are saved.
+	for (UAnimSequence* AnimSequence : DestAnimSequences)
 	{
-		AnimSequence->Modify(true);
-		AnimSequence->RequestSyncAnimRecompression(false);
+		if (SlowTask.ShouldCancel())
+		{
+			break;
+		}
+
+		SlowTask.EnterProgressFrame(1.0f, FText::FromString(AnimSequence->GetName()));
+
+		if (AnimSequence->DoesNeedRebake())
+		{
+			AnimSequence->BakeTrackCurvesToRawAnimation();
+		}
+
+		if (AnimSequence->DoesNeedRecompress())
+		{
+			AnimSequence->RequestAnimCompression(FRequestAnimCompressionParams(true, false, false));
+		}
 	}
 }
 
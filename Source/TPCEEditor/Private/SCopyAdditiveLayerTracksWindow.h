@@ -12,6 +12,7 @@ class UAnimSequence;
 class USkeleton;
 class FAssetThumbnailPool;
 struct FAssetData;
+struct FTransformCurve;
 
 /** UI slate widget allowing the user to copy additive layer tracks to a selection of Animation Sequences. */
 class SCopyAdditiveLayerTracksWindow : public SCompoundWidget
@@ -50,5 +51,9 @@ private:
 	TWeakObjectPtr<USkeleton> SkeletonPtr;
 	TWeakObjectPtr<UAnimSequence> SourceAnimSequence;
 
-	void CopyAdditiveLayerTracks(UAnimSequence* DestAnimSequence);
+	/** Replace the additive layer tracks of a sequence with the source ones, deferring baking. Return false if the sequence didn't change. */
+	bool CopyAdditiveLayerTracks(UAnimSequence* DestAnimSequence, TArrayView<const FTransformCurve* const> SourceCurves);
+
+	/** Bake additive layer tracks and request compression of all modified sequences at once, showing progress. */
+	static void BakeAndRecompress(TArrayView<UAnimSequence* const> DestAnimSequences);
 };
@@ -15,6 +15,10 @@
 #include "Curves/CurveFloat.h"
 #include "Factories/DistanceCurveFactory.h"
 #include "Animation/AnimSequence.h"
+#include "AnimationModifiers/BatchAnimationModifier.h"
+#include "AnimationModifiers/AnimSequencePoseCache.h"
+#include "AnimationModifiers/BoneFilterMatcher.h"
+#include "UObject/UObjectIterator.h"
 
 #include "Editor.h"
 #include "AssetToolsModule.h"
@@ -229,6 +233,8 @@ void FTPCEEditor::CreateContentBrowserAssetMenu(FMenuBuilder& MenuBuilder, TArra
 	static const FText TEXT_CreateDistanceCurveFromZAxisTitle = LOCTEXT("CreateDistanceCurveFromZAxisTitle", "Z Axis");
 	static const FText TEXT_CopyAdditiveLayerTracksTitle = LOCTEXT("CopyAdditiveLayerTracksTitle", "Copy Additive Layer Tracks");
 	static const FText TEXT_CopyAdditiveLayerTracksTooltip = LOCTEXT("CopyAdditiveLayerTracksTooltip", "Copy additive layer tracks from the current anim sequence to all other selected anim sequences");
+	static const FText TEXT_ApplyAnimationModifierTitle = LOCTEXT("ApplyAnimationModifierTitle", "Apply Animation Modifier");
+	static const FText TEXT_ApplyAnimationModifierTooltip = LOCTEXT("ApplyAnimationModifierTooltip", "Apply an animation modifier with default settings to all selected anim sequences, analyzing them in parallel");
 
 	MenuBuilder.BeginSection("GetAssetCustomActions", TEXT_SectionHeading);
 
@@ -312,6 +318,28 @@ void FTPCEEditor::CreateContentBrowserAssetMenu(FMenuBuilder& MenuBuilder, TArra
 			FSlateIcon(),
 			FUIAction(FExecuteAction::CreateRaw(this, &FTPCEEditor::ShowCopyAdditiveLayerTracksWindow, Sequences))
 		);
+
+		MenuBuilder.AddSubMenu(
+			TEXT_ApplyAnimationModifierTitle,
+			TEXT_ApplyAnimationModifierTooltip,
+			FNewMenuDelegate::CreateLambda([Sequences, this](FMenuBuilder& SubMenuBuilder)
+			{
+				for (TObjectIterator<UClass> It; It; ++It)
+				{
+					UClass* ModifierClass = *It;
+					if (ModifierClass->IsChildOf<UBatchAnimationModifier>() && !ModifierClass->HasAnyClassFlags(CLASS_Abstract | CLASS_Deprecated | CLASS_NewerVersionExists))
+					{
+						SubMenuBuilder.AddMenuEntry(
+							ModifierClass->GetDisplayNameText(),
+							ModifierClass->GetToolTipText(),
+							FSlateIcon(),
+							FUIAction(FExecuteAction::CreateRaw(this, &FTPCEEditor::ApplyAnimationModifier, Sequences, ModifierClass))
+						);
+					}
+				}
+			}),
+			false
+		);
 	}
 }
 
@@ -390,6 +418,27 @@ void FTPCEEditor::ShowCopyAdditiveLayerTracksWindow(const TArray<TWeakObjectPtr<
 	GEditor->EditorAddModalWindow(Window);
 }
 
+void FTPCEEditor::ApplyAnimationModifier(const TArray<TWeakObjectPtr<UAnimSequence>> AnimSequences, UClass* ModifierClass)
+{
+	TArray<UAnimSequence*> Sequences;
+	for (const TWeakObjectPtr<UAnimSequence>& AnimSequence : AnimSequences)
+	{
+		if (UAnimSequence* Sequence = AnimSequence.Get())
+		{
+			Sequences.Add(Sequence);
+		}
+	}
+
+	UBatchAnimationModifier* Modifier = NewObject<UBatchAnimationModifier>(GetTransientPackage(), ModifierClass);
+	const int32 NumApplied = Modifier->ApplyToSequences(Sequences);
+
+	// Sequences aren't modified again right away, don't hold on to their poses and bone masks
+	FAnimSequencePoseCache::Flush();
+	FBoneFilterMatcher::Flush();
+
+	UE_LOG(LogTPCEEditor, Log, TEXT("Applied %s to %d of %d anim sequences"), *ModifierClass->GetName(), NumApplied, Sequences.Num());
+}
+
 void FTPCEEditor::CreateUniqueAssetName(const FString& InBasePackageName, const FString& InSuffix, FString& OutPackageName, FString& OutAssetName) const
 {
 	FAssetToolsModule& AssetToolsModule = FModuleManager::Get().LoadModuleChecked<FAssetToolsModule>("AssetTools");
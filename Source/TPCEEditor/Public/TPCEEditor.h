@@ -58,6 +58,7 @@ private:
 	void CreateContentBrowserAssetMenu(FMenuBuilder& MenuBuilder, TArray<FAssetData> SelectedAssets);
 	void CreateDistanceCurveAssets(const TArray<TWeakObjectPtr<UAnimSequence>> AnimSequences, EDistanceCurveType DistanceCurveType);
 	void ShowCopyAdditiveLayerTracksWindow(const TArray<TWeakObjectPtr<UAnimSequence>> AnimSequences);
+	void ApplyAnimationModifier(const TArray<TWeakObjectPtr<UAnimSequence>> AnimSequences, UClass* ModifierClass);
 
 	/** Creates a unique package and asset name taking the form InBasePackageName+InSuffix */
 	void CreateUniqueAssetName(const FString& InBasePackageName, const FString& InSuffix, FString& OutPackageName, FString& OutAssetName) const;
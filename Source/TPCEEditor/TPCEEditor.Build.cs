@@ -33,6 +33,7 @@ public TPCEEditor(ReadOnlyTargetRules Target) : base(Target)
 				"EditorStyle",
 				"PropertyEditor",
 				"AnimationModifiers",
+				"AssetRegistry",
 				"BlueprintGraph",
 				"TPCE",
 			});
@@ -0,0 +1,71 @@
+// This source code is licensed under the MIT license found in the LICENSE file in the root directory of this source tree.
+
+#include "AnimGraphNodes/AnimGraphNode_DistanceMatching.h"
+#include "Animation/AnimSequenceBase.h"
+#include "Animation/Skeleton.h"
+#include "Kismet2/CompilerResultsLog.h"
+
+#define LOCTEXT_NAMESPACE "TPCEAnimGraphNodes"
+
+FText UAnimGraphNode_DistanceMatching::GetTooltipText() const
+{
+	return LOCTEXT("DistanceMatching_Tooltip", "Evaluates a sequence at the time matching a distance to a target");
+}
+
+FLinearColor UAnimGraphNode_DistanceMatching::GetNodeTitleColor() const
+{
+	return FLinearColor(0.1f, 0.75f, 0.75f);
+}
+
+FText UAnimGraphNode_DistanceMatching::GetNodeTitle(ENodeTitleType::Type TitleType) const
+{
+	if (Node.Sequence && TitleType != ENodeTitleType::MenuTitle)
+	{
+		return FText::Format(LOCTEXT("DistanceMatching_Title", "Distance Matching {0}"), FText::FromName(Node.Sequence->GetFName()));
+	}
+
+	return LOCTEXT("DistanceMatching", "Distance Matching");
+}
+
+FText UAnimGraphNode_DistanceMatching::GetMenuCategory() const
+{
+	return LOCTEXT("DistanceMatching_Category", "Animation|Sequences");
+}
+
+void UAnimGraphNode_DistanceMatching::ValidateAnimNodeDuringCompilation(USkeleton* ForSkeleton, FCompilerResultsLog& MessageLog)
+{
+	Super::ValidateAnimNodeDuringCompilation(ForSkeleton, MessageLog);
+
+	if (Node.Sequence == nullptr && !IsPinExposedAndLinked(GET_MEMBER_NAME_STRING_CHECKED(FAnimNode_DistanceMatching, Sequence)))
+	{
+		MessageLog.Error(*LOCTEXT("DistanceMatching_NoSequence", "@@ references an unknown sequence").ToString(), this);
+	}
+	else if (Node.Sequence && ForSkeleton)
+	{
+		const USkeleton* SequenceSkeleton = Node.Sequence->GetSkeleton();
+		if (SequenceSkeleton && !SequenceSkeleton->IsCompatible(ForSkeleton))
+		{
+			MessageLog.Error(*LOCTEXT("DistanceMatching_IncompatibleSkeleton", "@@ references sequence that uses an incompatible skeleton @@").ToString(), this, SequenceSkeleton);
+		}
+	}
+
+	if (Node.DistanceCurve == nullptr && !IsPinExposedAndLinked(GET_MEMBER_NAME_STRING_CHECKED(FAnimNode_DistanceMatching, DistanceCurve)))
+	{
+		MessageLog.Warning(*LOCTEXT("DistanceMatching_NoCurve", "@@ has no distance curve, the sequence will play at its explicit time").ToString(), this);
+	}
+}
+
+UAnimationAsset* UAnimGraphNode_DistanceMatching::GetAnimationAsset() const
+{
+	return Node.Sequence;
+}
+
+void UAnimGraphNode_DistanceMatching::SetAnimationAsset(UAnimationAsset* Asset)
+{
+	if (UAnimSequenceBase* Sequence = Cast<UAnimSequenceBase>(Asset))
+	{
+		Node.Sequence = Sequence;
+	}
+}
+
+#undef LOCTEXT_NAMESPACE
@@ -0,0 +1,69 @@
+// This source code is licensed under the MIT license found in the LICENSE file in the root directory of this source tree.
+
+#include "AnimGraphNodes/AnimGraphNode_MotionMatching.h"
+#include "Animation/AnimSequence.h"
+#include "Animation/MotionDatabase.h"
+#include "Animation/Skeleton.h"
+#include "Kismet2/CompilerResultsLog.h"
+
+#define LOCTEXT_NAMESPACE "TPCEAnimGraphNodes"
+
+FText UAnimGraphNode_MotionMatching::GetTooltipText() const
+{
+	return LOCTEXT("MotionMatching_Tooltip", "Plays the poses of a motion database that best follow the desired velocity");
+}
+
+FLinearColor UAnimGraphNode_MotionMatching::GetNodeTitleColor() const
+{
+	return FLinearColor(0.1f, 0.75f, 0.75f);
+}
+
+FText UAnimGraphNode_MotionMatching::GetNodeTitle(ENodeTitleType::Type TitleType) const
+{
+	if (Node.Database && TitleType != ENodeTitleType::MenuTitle)
+	{
+		return FText::Format(LOCTEXT("MotionMatching_Title", "Motion Matching {0}"), FText::FromName(Node.Database->GetFName()));
+	}
+
+	return LOCTEXT("MotionMatching", "Motion Matching");
+}
+
+FText UAnimGraphNode_MotionMatching::GetMenuCategory() const
+{
+	return LOCTEXT("MotionMatching_Category", "Animation|Sequences");
+}
+
+void UAnimGraphNode_MotionMatching::ValidateAnimNodeDuringCompilation(USkeleton* ForSkeleton, FCompilerResultsLog& MessageLog)
+{
+	Super::ValidateAnimNodeDuringCompilation(ForSkeleton, MessageLog);
+
+	if (Node.Database == nullptr)
+	{
+		if (!IsPinExposedAndLinked(GET_MEMBER_NAME_STRING_CHECKED(FAnimNode_MotionMatching, Database)))
+		{
+			MessageLog.Error(*LOCTEXT("MotionMatching_NoDatabase", "@@ references an unknown motion database").ToString(), this);
+		}
+		return;
+	}
+
+	if (!Node.Database->IsValid())
+	{
+		MessageLog.Warning(*LOCTEXT("MotionMatching_NotBuilt", "@@ references motion database @@ that has not been built").ToString(), this, Node.Database);
+	}
+
+	for (const UAnimSequence* Sequence : Node.Database->Sequences)
+	{
+		const USkeleton* SequenceSkeleton = Sequence ? Sequence->GetSkeleton() : nullptr;
+		if (SequenceSkeleton && ForSkeleton && !SequenceSkeleton->IsCompatible(ForSkeleton))
+		{
+			MessageLog.Error(*LOCTEXT("MotionMatching_IncompatibleSkeleton", "@@ references sequence @@ that uses an incompatible skeleton @@").ToString(), this, Sequence, SequenceSkeleton);
+		}
+	}
+}
+
+UAnimationAsset* UAnimGraphNode_MotionMatching::GetAnimationAsset() const
+{
+	return Node.Database && Node.Database->Sequences.Num() > 0 ? Node.Database->Sequences[0] : nullptr;
+}
+
+#undef LOCTEXT_NAMESPACE
@@ -0,0 +1,32 @@
+// This source code is licensed under the MIT license found in the LICENSE file in the root directory of this source tree.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AnimNodes/AnimNode_DistanceMatching.h"
+#include "AnimGraphNode_AssetPlayerBase.h"
+
+#include "AnimGraphNode_DistanceMatching.generated.h"
+
+/**
+ * Editor node of FAnimNode_DistanceMatching.
+ */
+UCLASS()
+class TPCEUNCOOKED_API UAnimGraphNode_DistanceMatching : public UAnimGraphNode_AssetPlayerBase
+{
+	GENERATED_BODY()
+
+	UPROPERTY(EditAnywhere, Category = Settings)
+	FAnimNode_DistanceMatching Node;
+
+public:
+
+	virtual FText GetTooltipText() const override;
+	virtual FLinearColor GetNodeTitleColor() const override;
+	virtual FText GetNodeTitle(ENodeTitleType::Type TitleType) const override;
+	virtual FText GetMenuCategory() const override;
+
+	virtual void ValidateAnimNodeDuringCompilation(USkeleton* ForSkeleton, FCompilerResultsLog& MessageLog) override;
+	virtual UAnimationAsset* GetAnimationAsset() const override;
+	virtual void SetAnimationAsset(UAnimationAsset* Asset) override;
+};
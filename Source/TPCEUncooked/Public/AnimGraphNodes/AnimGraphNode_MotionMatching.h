@@ -0,0 +1,31 @@
+// This source code is licensed under the MIT license found in the LICENSE file in the root directory of this source tree.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AnimNodes/AnimNode_MotionMatching.h"
+#include "AnimGraphNode_AssetPlayerBase.h"
+
+#include "AnimGraphNode_MotionMatching.generated.h"
+
+/**
+ * Editor node of FAnimNode_MotionMatching.
+ */
+UCLASS()
+class TPCEUNCOOKED_API UAnimGraphNode_MotionMatching : public UAnimGraphNode_AssetPlayerBase
+{
+	GENERATED_BODY()
+
+	UPROPERTY(EditAnywhere, Category = Settings)
+	FAnimNode_MotionMatching Node;
+
+public:
+
+	virtual FText GetTooltipText() const override;
+	virtual FLinearColor GetNodeTitleColor() const override;
+	virtual FText GetNodeTitle(ENodeTitleType::Type TitleType) const override;
+	virtual FText GetMenuCategory() const override;
+
+	virtual void ValidateAnimNodeDuringCompilation(USkeleton* ForSkeleton, FCompilerResultsLog& MessageLog) override;
+	virtual UAnimationAsset* GetAnimationAsset() const override;
+};